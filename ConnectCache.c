@@ -0,0 +1,326 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Connect information cache for development runs.
+**
+** One line per interface, for the last vehicle connected with it:
+**
+**   <interface key> <protocol tag> <header size> <number of ECUs>
+**         <ECU header>:<SID $1 PID $0 support bits> ...
+**
+** The interface key is a hash of the J2534 firmware and DLL version strings,
+** which are known before connecting (the VIN is not).  The ECU headers and
+** support bits tell if the same vehicle is still connected.
+** All numbers except the ECU data are decimal, the ECU data is hex.
+*/
+#define CONNECT_CACHE_FILE      "j1699conn.cache"
+#define CONNECT_CACHE_TEMP_FILE "j1699conn.tmp"
+#define CONNECT_CACHE_LINE_SIZE 1024
+
+static unsigned long ulInterfaceKey   = 0;
+static BOOL          bInterfaceKeySet = FALSE;
+
+static STATUS ConnectCacheParse (char *szLine, CONNECT_CACHE_ENTRY *pEntry);
+
+
+/*
+*******************************************************************************
+** ConnectCacheSetInterface - Function to set the interface part of the key
+*******************************************************************************
+*/
+void ConnectCacheSetInterface (const char *szFirmwareVersion, const char *szDllVersion)
+{
+	const char *pChar;
+
+	/* FNV-1a over both strings */
+	ulInterfaceKey = 2166136261UL;
+	for ( pChar = szFirmwareVersion; *pChar != '\0'; pChar++ )
+	{
+		ulInterfaceKey = (ulInterfaceKey ^ (unsigned char)*pChar) * 16777619UL;
+	}
+	ulInterfaceKey = (ulInterfaceKey ^ '|') * 16777619UL;
+	for ( pChar = szDllVersion; *pChar != '\0'; pChar++ )
+	{
+		ulInterfaceKey = (ulInterfaceKey ^ (unsigned char)*pChar) * 16777619UL;
+	}
+
+	bInterfaceKeySet = TRUE;
+}
+
+/*
+*******************************************************************************
+** ConnectCacheParse - Function to read a cache line if it has the
+**                     current interface key.  Returns FAIL if not (or bad
+**                     line).
+*******************************************************************************
+*/
+static STATUS ConnectCacheParse (char *szLine, CONNECT_CACHE_ENTRY *pEntry)
+{
+	unsigned long LineKey;
+	unsigned long EcuIndex;
+	unsigned long ByteIndex;
+	unsigned int  Value;
+	int           Offset;
+	char         *pChar;
+
+	if ( sscanf (szLine, "%lu %lu %lu %lu%n",
+	             &LineKey,
+	             &pEntry->ProtocolTag, &pEntry->HeaderSize, &pEntry->NumEcus,
+	             &Offset) != 4 )
+	{
+		return FAIL;
+	}
+
+	if ( LineKey != ulInterfaceKey ||
+	     pEntry->HeaderSize > 4 ||
+	     pEntry->NumEcus == 0 ||
+	     pEntry->NumEcus > OBD_MAX_ECUS )
+	{
+		return FAIL;
+	}
+
+	pChar = szLine + Offset;
+	for ( EcuIndex = 0; EcuIndex < pEntry->NumEcus; EcuIndex++ )
+	{
+		while ( *pChar == ' ' )
+		{
+			pChar++;
+		}
+
+		for ( ByteIndex = 0; ByteIndex < pEntry->HeaderSize; ByteIndex++, pChar += 2 )
+		{
+			if ( sscanf (pChar, "%2x", &Value) != 1 )
+			{
+				return FAIL;
+			}
+			pEntry->Header[EcuIndex][ByteIndex] = (unsigned char)Value;
+		}
+
+		if ( *pChar++ != ':' )
+		{
+			return FAIL;
+		}
+
+		for ( ByteIndex = 0; ByteIndex < 4; ByteIndex++, pChar += 2 )
+		{
+			if ( sscanf (pChar, "%2x", &Value) != 1 )
+			{
+				return FAIL;
+			}
+			pEntry->Pid00Support[EcuIndex][ByteIndex] = (unsigned char)Value;
+		}
+	}
+
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** ConnectCacheLoad - Function to find the cache entry of the current
+**                    interface
+*******************************************************************************
+*/
+STATUS ConnectCacheLoad (CONNECT_CACHE_ENTRY *pEntry)
+{
+	FILE   *hCacheFile;
+	char    szLine[CONNECT_CACHE_LINE_SIZE];
+	STATUS  RetCode = FAIL;
+
+	if ( bInterfaceKeySet == FALSE )
+	{
+		return FAIL;
+	}
+
+	hCacheFile = fopen (CONNECT_CACHE_FILE, "r");
+	if ( hCacheFile == NULL )
+	{
+		return FAIL;
+	}
+
+	memset (pEntry, 0, sizeof (CONNECT_CACHE_ENTRY));
+	while ( RetCode != PASS && fgets (szLine, sizeof (szLine), hCacheFile) != NULL )
+	{
+		RetCode = ConnectCacheParse (szLine, pEntry);
+	}
+
+	fclose (hCacheFile);
+	return RetCode;
+}
+
+/*
+*******************************************************************************
+** ConnectCacheSave - Function to add or replace the cache entry of the
+**                    current interface
+*******************************************************************************
+*/
+STATUS ConnectCacheSave (CONNECT_CACHE_ENTRY *pEntry)
+{
+	FILE               *hCacheFile;
+	FILE               *hTempFile;
+	char                szLine[CONNECT_CACHE_LINE_SIZE];
+	CONNECT_CACHE_ENTRY LineEntry;
+	unsigned long       EcuIndex;
+	unsigned long       ByteIndex;
+
+	if ( bInterfaceKeySet == FALSE )
+	{
+		return FAIL;
+	}
+
+	hTempFile = fopen (CONNECT_CACHE_TEMP_FILE, "w");
+	if ( hTempFile == NULL )
+	{
+		Log( WARNING, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "Cannot write connect cache file %s\n", CONNECT_CACHE_TEMP_FILE );
+		return FAIL;
+	}
+
+	/* Keep the entries for other interfaces */
+	hCacheFile = fopen (CONNECT_CACHE_FILE, "r");
+	if ( hCacheFile != NULL )
+	{
+		while ( fgets (szLine, sizeof (szLine), hCacheFile) != NULL )
+		{
+			if ( ConnectCacheParse (szLine, &LineEntry) != PASS )
+			{
+				fputs (szLine, hTempFile);
+			}
+		}
+		fclose (hCacheFile);
+	}
+
+	fprintf (hTempFile, "%lu %lu %lu %lu",
+	         ulInterfaceKey,
+	         pEntry->ProtocolTag, pEntry->HeaderSize, pEntry->NumEcus);
+	for ( EcuIndex = 0; EcuIndex < pEntry->NumEcus; EcuIndex++ )
+	{
+		fputc (' ', hTempFile);
+		for ( ByteIndex = 0; ByteIndex < pEntry->HeaderSize; ByteIndex++ )
+		{
+			fprintf (hTempFile, "%02X", pEntry->Header[EcuIndex][ByteIndex]);
+		}
+		fputc (':', hTempFile);
+		for ( ByteIndex = 0; ByteIndex < 4; ByteIndex++ )
+		{
+			fprintf (hTempFile, "%02X", pEntry->Pid00Support[EcuIndex][ByteIndex]);
+		}
+	}
+	fputc ('\n', hTempFile);
+	fclose (hTempFile);
+
+	DeleteFile (CONNECT_CACHE_FILE);
+	if ( MoveFile (CONNECT_CACHE_TEMP_FILE, CONNECT_CACHE_FILE) == 0 )
+	{
+		Log( WARNING, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "Cannot write connect cache file %s\n", CONNECT_CACHE_FILE );
+		return FAIL;
+	}
+
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** ConnectCacheBuildEntry - Function to build a cache entry from the
+**                          SID $1 PID $0 responses of the current protocol
+*******************************************************************************
+*/
+void ConnectCacheBuildEntry (CONNECT_CACHE_ENTRY *pEntry)
+{
+	unsigned long EcuIndex;
+
+	memset (pEntry, 0, sizeof (CONNECT_CACHE_ENTRY));
+
+	pEntry->ProtocolTag = gOBDList[gOBDListIndex].ProtocolTag;
+	pEntry->HeaderSize  = gOBDList[gOBDListIndex].HeaderSize;
+	pEntry->NumEcus     = gOBDNumEcusResp;
+
+	for ( EcuIndex = 0; EcuIndex < gOBDNumEcusResp && EcuIndex < OBD_MAX_ECUS; EcuIndex++ )
+	{
+		memcpy (pEntry->Header[EcuIndex], gOBDResponse[EcuIndex].Header, pEntry->HeaderSize);
+		memcpy (pEntry->Pid00Support[EcuIndex], gOBDResponse[EcuIndex].Sid1PidSupport[0].IDBits, 4);
+	}
+}
+
+/*
+*******************************************************************************
+** ConnectCacheMatch - Function to check the SID $1 PID $0 responses of the
+**                     current protocol against a cache entry
+*******************************************************************************
+*/
+STATUS ConnectCacheMatch (CONNECT_CACHE_ENTRY *pEntry)
+{
+	CONNECT_CACHE_ENTRY Current;
+	unsigned long       EcuIndex;
+	unsigned long       CacheIndex;
+
+	ConnectCacheBuildEntry (&Current);
+
+	if ( Current.ProtocolTag != pEntry->ProtocolTag ||
+	     Current.HeaderSize  != pEntry->HeaderSize  ||
+	     Current.NumEcus     != pEntry->NumEcus )
+	{
+		return FAIL;
+	}
+
+	/* The ECUs may answer in a different order */
+	for ( EcuIndex = 0; EcuIndex < Current.NumEcus; EcuIndex++ )
+	{
+		for ( CacheIndex = 0; CacheIndex < pEntry->NumEcus; CacheIndex++ )
+		{
+			if ( memcmp (Current.Header[EcuIndex], pEntry->Header[CacheIndex], pEntry->HeaderSize) == 0 &&
+			     memcmp (Current.Pid00Support[EcuIndex], pEntry->Pid00Support[CacheIndex], 4) == 0 )
+			{
+				break;
+			}
+		}
+
+		if ( CacheIndex == pEntry->NumEcus )
+		{
+			return FAIL;
+		}
+	}
+
+	return PASS;
+}
@@ -40,6 +40,8 @@
 #include "j2534.h"
 #include "j1699.h"
 
+static STATUS SetISO15765FlowControl (void);
+
 
 /*
 *******************************************************************************
@@ -89,6 +91,9 @@ STATUS ConnectProtocol(void)
 		gOBDMinResponseTimeMsecs = 0;		/*06/07/04 - Added to support for min time verification. */
 	}
 
+	/* New connection, no bus activity seen yet */
+	PacingReset ();
+
 	/* Connect to protocol */
 	RetVal = PassThruConnect (gulDeviceID, gOBDList[gOBDListIndex].Protocol, InitFlags, gOBDList[gOBDListIndex].BaudRate, &gOBDList[gOBDListIndex].ChannelID);
 	if ((RetVal != STATUS_NOERROR) && (gOBDList[gOBDListIndex].Protocol == ISO9141))
@@ -496,6 +501,12 @@ STATUS ConnectProtocol(void)
 				}
 			}
 
+			/* Setup the flow control the interface sends for segmented responses */
+			if (SetISO15765FlowControl () != PASS)
+			{
+				return(FAIL);
+			}
+
 			/* Setup tester present keep alive message using Mode 1 PID 0 */
 			gTesterPresentMsg.ProtocolID = gOBDList[gOBDListIndex].Protocol;
 			gTesterPresentMsg.DataSize = 6;
@@ -524,6 +535,81 @@ STATUS ConnectProtocol(void)
 			return(FAIL);
 		}
 	}
+
+	/* Start the optional receive thread (paused until the first request) */
+	if ( gRxThreadEnabled == TRUE )
+	{
+		if ( RxThreadStart () != PASS )
+		{
+			return(FAIL);
+		}
+	}
+
+	return(PASS);
+}
+
+/*
+*******************************************************************************
+** SetISO15765FlowControl - Function to set the block size and separation
+**                          time the interface sends in its flow control
+**                          frames, per gISO15765FlowProfile.  Only fails if
+**                          the interface rejects ISO15765_FC_CUSTOM values.
+*******************************************************************************
+*/
+static STATUS SetISO15765FlowControl (void)
+{
+	SCONFIG_LIST ConfigList;
+	SCONFIG ConfigParameter[2];
+	unsigned long RetVal;
+
+	switch (gISO15765FlowProfile)
+	{
+		case ISO15765_FC_INTERFACE_DEFAULT:
+		{
+			/* leave the interface defaults in place */
+			return(PASS);
+		}
+		case ISO15765_FC_CUSTOM:
+		{
+			ConfigParameter[0].Value = gISO15765BlockSize;
+			ConfigParameter[1].Value = gISO15765STmin;
+		}
+		break;
+		case ISO15765_FC_MAX_THROUGHPUT:
+		default:
+		{
+			/* let the ECU send the whole message without waiting */
+			ConfigParameter[0].Value = 0;
+			ConfigParameter[1].Value = 0;
+		}
+		break;
+	}
+
+	ConfigList.NumOfParams = 2;
+	ConfigList.ConfigPtr = ConfigParameter;
+	ConfigParameter[0].Parameter = ISO15765_BS;
+	ConfigParameter[1].Parameter = ISO15765_STMIN;
+	RetVal = PassThruIoctl(gOBDList[gOBDListIndex].ChannelID, SET_CONFIG, &ConfigList, NULL);
+	if (RetVal != STATUS_NOERROR)
+	{
+		/* only the values the user asked for are required */
+		if (gISO15765FlowProfile == ISO15765_FC_CUSTOM)
+		{
+			Log( J2534_FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "%s returned %ld", "PassThruIoctl(SET_CONFIG/ISO15765_BS/ISO15765_STMIN)", RetVal);
+			return(FAIL);
+		}
+
+		Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "%s returned %ld, keeping the interface ISO15765 flow control defaults\n",
+		     "PassThruIoctl(SET_CONFIG/ISO15765_BS/ISO15765_STMIN)", RetVal);
+		return(PASS);
+	}
+
+	Log( INFORMATION, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+	     "ISO15765 flow control BS = %lu, STmin = %lu\n",
+	     ConfigParameter[0].Value, ConfigParameter[1].Value);
+
 	return(PASS);
 }
 
@@ -534,9 +620,19 @@ STATUS ConnectProtocol(void)
 */
 static BOOL bPeriocicActive = FALSE;
 
+/* Tester present scheduling data, used by the PeriodicMsg request manager */
+static unsigned long ulPeriodicStartMsecs  = 0;     /* time the periodic message was (re)started */
+static unsigned long ulPeriodicCostMsecs   = 0;     /* time taken by the last stop / start pair */
+static unsigned long ulSectionRequests     = 0;     /* requests handled in this test subsection */
+static unsigned long ulSectionRephases     = 0;     /* requests that had to move tester present */
+static unsigned long ulSectionSavedMsecs   = 0;     /* wall-clock time saved in this test subsection */
+
+static unsigned long PeriodicMsgNextDue (unsigned long NowMsecs);
+
 STATUS StartPeriodicMsg (void)
 {
 	unsigned long RetVal;
+	unsigned long StartTimeMsecs;
 
 	if ( gPeriodicMsgEnabled == FALSE && gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
@@ -558,6 +654,7 @@ STATUS StartPeriodicMsg (void)
 #endif
 
 
+	StartTimeMsecs = GetTickCount ();
 
 	RetVal = PassThruStartPeriodicMsg (gOBDList[gOBDListIndex].ChannelID,
 	                                   &gTesterPresentMsg,
@@ -573,6 +670,10 @@ STATUS StartPeriodicMsg (void)
 
 	bPeriocicActive = TRUE;
 
+	/* The tester present schedule is phased from this point */
+	ulPeriodicStartMsecs = GetTickCount ();
+	ulPeriodicCostMsecs += ulPeriodicStartMsecs - StartTimeMsecs;
+
 
 
 #ifdef _DEBUG
@@ -595,6 +696,7 @@ STATUS StartPeriodicMsg (void)
 STATUS StopPeriodicMsg (BOOL bLogError)
 {
 	unsigned long RetVal;
+	unsigned long StartTimeMsecs;
 
 	if ( gPeriodicMsgEnabled == FALSE && gOBDList[gOBDListIndex].Protocol == ISO15765 )
 	{
@@ -615,6 +717,13 @@ STATUS StopPeriodicMsg (BOOL bLogError)
 	}
 #endif
 
+	StartTimeMsecs = GetTickCount ();
+
+	/* The last scheduled tester present may still be on the bus */
+	if (bPeriocicActive == TRUE)
+	{
+		PacingNoteBusActivity (PeriodicMsgNextDue (StartTimeMsecs) - OBD_TESTER_PRESENT_RATE);
+	}
 
 	RetVal = PassThruIoctl (gOBDList[gOBDListIndex].ChannelID, CLEAR_PERIODIC_MSGS, NULL, NULL);
 	if (RetVal != STATUS_NOERROR)
@@ -640,6 +749,9 @@ STATUS StopPeriodicMsg (BOOL bLogError)
 
 	bPeriocicActive = FALSE;
 
+	/* Start a new stop / start cost measurement */
+	ulPeriodicCostMsecs = GetTickCount () - StartTimeMsecs;
+
 
 
 #ifdef _DEBUG
@@ -654,3 +766,124 @@ STATUS StopPeriodicMsg (BOOL bLogError)
 
 	return PASS;
 }
+
+
+/*
+*******************************************************************************
+** PeriodicMsgNextDue - Function to get the time the next tester present
+**                      message is scheduled to be sent
+*******************************************************************************
+*/
+static unsigned long PeriodicMsgNextDue (unsigned long NowMsecs)
+{
+	unsigned long Periods;
+
+	Periods = ( (NowMsecs - ulPeriodicStartMsecs) / OBD_TESTER_PRESENT_RATE ) + 1;
+
+	return ( ulPeriodicStartMsecs + (Periods * OBD_TESTER_PRESENT_RATE) );
+}
+
+/*
+*******************************************************************************
+** PeriodicMsgBeginRequest - Function to prepare the tester present message
+**                           for an OBD request
+**
+** The tester present message is left scheduled unless it would be sent
+** while the request is waiting for responses.  Only then is it stopped,
+** and it is restarted (re-phased) once the responses have been read.
+*******************************************************************************
+*/
+STATUS PeriodicMsgBeginRequest (void)
+{
+	unsigned long NowMsecs;
+
+	/* Nothing scheduled, use the normal stop / delay sequence */
+	if ( bPeriocicActive == FALSE ||
+	     gOBDList[gOBDListIndex].TesterPresentID == -1 )
+	{
+		if (StopPeriodicMsg (TRUE) == FAIL)
+		{
+			return(FAIL);
+		}
+
+		gOBDList[gOBDListIndex].TesterPresentID = -1;
+
+		PacingWaitForRequest ();
+		return(PASS);
+	}
+
+	ulSectionRequests++;
+
+	/* Check if tester present would be sent during the request / response window */
+	NowMsecs = GetTickCount ();
+	if ( PeriodicMsgCheckWindow ( NowMsecs + gOBDRequestDelay + (5 * gOBDMaxResponseTimeMsecs) ) != PASS )
+	{
+		return(FAIL);
+	}
+
+	if ( gOBDList[gOBDListIndex].TesterPresentID == -1 )
+	{
+		ulSectionRephases++;
+	}
+	else
+	{
+		/* Tester present stays scheduled, wait out the request delay from its last message */
+		PacingNoteBusActivity (PeriodicMsgNextDue (NowMsecs) - OBD_TESTER_PRESENT_RATE);
+		ulSectionSavedMsecs += ulPeriodicCostMsecs;
+	}
+
+	PacingWaitForRequest ();
+
+	return(PASS);
+}
+
+/*
+*******************************************************************************
+** PeriodicMsgCheckWindow - Function to stop the tester present message if
+**                          it is due before the end of a response window
+*******************************************************************************
+*/
+STATUS PeriodicMsgCheckWindow (unsigned long WindowEndMsecs)
+{
+	if ( bPeriocicActive == FALSE ||
+	     gOBDList[gOBDListIndex].TesterPresentID == -1 )
+	{
+		return(PASS);
+	}
+
+	if ( (long)(PeriodicMsgNextDue (GetTickCount ()) - WindowEndMsecs) > 0 )
+	{
+		return(PASS);
+	}
+
+	if (StopPeriodicMsg (TRUE) == FAIL)
+	{
+		return(FAIL);
+	}
+
+	gOBDList[gOBDListIndex].TesterPresentID = -1;
+
+	return(PASS);
+}
+
+/*
+*******************************************************************************
+** LogPeriodicMsgStats - Function to log the tester present scheduling
+**                       statistics for the current test subsection
+*******************************************************************************
+*/
+void LogPeriodicMsgStats (void)
+{
+	if ( ulSectionRequests != 0 )
+	{
+		Log( INFORMATION, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "Tester present kept scheduled for %lu of %lu requests, %lumsec of stop / start calls saved\n",
+		     ulSectionRequests - ulSectionRephases,
+		     ulSectionRequests,
+		     ulSectionSavedMsecs );
+	}
+
+	ulSectionRequests   = 0;
+	ulSectionRephases   = 0;
+	ulSectionSavedMsecs = 0;
+}
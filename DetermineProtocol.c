@@ -46,9 +46,13 @@ STATUS IDOBDProtocol (unsigned long *);
 STATUS LogJ2534InterfaceVersion (void);
 STATUS VerifyBatteryVoltage (void);
 STATUS SearchTAfor29bit (void);  /* By Honda */
+STATUS FastCanDetect (void);
+STATUS IDCachedProtocol (unsigned long *);
+STATUS ProbeCanProtocol (unsigned long ListIndex);
 
 STATUS SaveConnectInfo (void);
 STATUS VerifyConnectInfo (void);
+BOOL   MatchConnectInfo (void);
 
 
 /*-----------------------------------------------------------------------------
@@ -72,6 +76,20 @@ static INITIAL_CONNECT_INFO gInitialConnect = {0}; // initialize all fields to z
 
 static unsigned char gFirstConnectFlag = TRUE;
 
+/* Result of the fast CAN detect for each gOBDList entry */
+#define CAN_PROBE_UNKNOWN       0   /* not probed, or the probe could not run */
+#define CAN_PROBE_SILENT        1   /* probed, no OBD response */
+#define CAN_PROBE_ANSWERED      2   /* probed, OBD response seen */
+
+#define CAN_PROBE_WINDOW_MSECS  100 /* 2 x ISO15765 P2 max */
+
+static unsigned char CanProbeResult[OBD_MAX_PROTOCOLS];
+static BOOL          bCanProbeAnswered = FALSE;
+
+/* Connect information of the protocol found by the last full search */
+static CONNECT_CACHE_ENTRY FoundConnectInfo;
+static BOOL                bFoundConnectInfo = FALSE;
+
 
 /*
 *******************************************************************************
@@ -81,6 +99,7 @@ static unsigned char gFirstConnectFlag = TRUE;
 STATUS DetermineProtocol(void)
 {
 	unsigned long fOBDFound = FALSE;
+	STATUS        RetCode;
 
 	/* Get the version information and log it */
 	if (LogJ2534InterfaceVersion() != PASS)
@@ -133,8 +152,20 @@ STATUS DetermineProtocol(void)
 	InitProtocolList();
 
 	gDetermineProtocol = 1;
-	/* Connect to each protocol in the list and check if SID 1 PID 0 is supported */
-	if (IDOBDProtocol (&fOBDFound) != FAIL)
+	bFoundConnectInfo  = FALSE;
+
+	/* Development runs: try the protocol cached for this vehicle first */
+	if (IDCachedProtocol (&fOBDFound) == PASS)
+	{
+		RetCode = PASS;
+	}
+	else
+	{
+		/* Connect to each protocol in the list and check if SID 1 PID 0 is supported */
+		RetCode = IDOBDProtocol (&fOBDFound);
+	}
+
+	if (RetCode != FAIL)
 	{
 
 		/* Connect to the OBD protocol */
@@ -149,6 +180,15 @@ STATUS DetermineProtocol(void)
 				return (FAIL);
 			}
 
+			/* Size the ECU tables for the responders found and the ECUs the user expects */
+			if (EcuTableReserve ((gUserNumEcus > gOBDNumEcus) ? gUserNumEcus : gOBDNumEcus) != PASS)
+			{
+				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "Too many OBD ECUs (%lu responded, %lu expected, at most %u supported)\n",
+				     gOBDNumEcus, gUserNumEcus, OBD_MAX_ECUS);
+				return (FAIL);
+			}
+
 			if ( (gUserInput.eComplianceType == US_OBDII ||
 			      gUserInput.eComplianceType == HD_OBD) &&
 			     gModelYear >= 2008 &&
@@ -193,6 +233,12 @@ STATUS DetermineProtocol(void)
 				/* If routine logged an error, pass error up! */
 				return (FAIL);
 
+			/* Remember what the full search found for the next run on this vehicle */
+			if (gConnectCacheEnabled == TRUE && bFoundConnectInfo == TRUE)
+			{
+				ConnectCacheSave (&FoundConnectInfo);
+			}
+
 			gDetermineProtocol = 0;
 			return (PASS);
 		}
@@ -228,12 +274,24 @@ STATUS IDOBDProtocol (unsigned long *pfOBDFound)
 	/* Setup initial conditions */
 	*pfOBDFound = FALSE;
 
+	/* Find out quickly which CAN protocols (if any) answer */
+	FastCanDetect ();
 
 	/* Connect to each protocol in the list and check if SID 1 PID 0 is supported */
 	for (gOBDListIndex = 0; gOBDListIndex < gUserInput.MaxProtocols && RetCode == PASS; gOBDListIndex++)
 	{
 		RetVal = PASS;
 
+		/*
+		** Skip the CAN protocols the fast CAN detect ruled out.  The serial
+		** protocols are always checked, so a vehicle with OBD on more than
+		** one protocol still fails.
+		*/
+		if ( CanProbeResult[gOBDListIndex] == CAN_PROBE_SILENT )
+		{
+			continue;
+		}
+
 		/* Connect to the protocol */
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Checking for OBD on %s protocol\n", gOBDList[gOBDListIndex].Name);
@@ -304,6 +362,9 @@ STATUS IDOBDProtocol (unsigned long *pfOBDFound)
 						/* Set the found flag and globals */
 						*pfOBDFound = TRUE;
 						gOBDFoundIndex = gOBDListIndex;
+
+						ConnectCacheBuildEntry (&FoundConnectInfo);
+						bFoundConnectInfo = TRUE;
 					}
 				}
 
@@ -368,6 +429,9 @@ STATUS LogJ2534InterfaceVersion (void)
 		     "DLL Version: %s\n", DllVersion);
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "API Version: %s\n", ApiVersion);
+
+		/* The connect cache is kept per interface */
+		ConnectCacheSetInterface (FirmwareVersion, DllVersion);
 	}
 
 	return (result);
@@ -529,6 +593,9 @@ STATUS SearchTAfor29bit (void)
 	TxMsg.Data[11]   = 0x00;	/* Padding Data */
 	TxMsg.DataSize   = 12;
 
+	/* Reading directly, make sure the receive thread is not */
+	RxThreadPause ();
+
 	NumMsgs = 1;
 	LogMsg( &TxMsg, LOG_REQ_MSG );
 	RetVal  = PassThruWriteMsgs (gOBDList[gOBDListIndex].ChannelID, &TxMsg, &NumMsgs, 500);
@@ -609,6 +676,305 @@ STATUS SearchTAfor29bit (void)
 	return RetCode;
 }
 
+//*****************************************************************************
+//
+//	Function:	FastCanDetect
+//
+//	Purpose:	Purpose is to send a single frame SID $1 PID $0 request on
+//				each ISO15765 protocol in the list over a raw CAN channel
+//				and note which ones get an OBD response.  IDOBDProtocol
+//				then skips the full check on the CAN protocols that did
+//				not answer.  The serial protocols are always checked.
+//
+//*****************************************************************************
+STATUS FastCanDetect (void)
+{
+	unsigned long ListIndex;
+
+	memset (CanProbeResult, CAN_PROBE_UNKNOWN, sizeof (CanProbeResult));
+	bCanProbeAnswered = FALSE;
+
+	if ( gFastCanDetectEnabled == FALSE )
+	{
+		return (PASS);
+	}
+
+	for ( ListIndex = 0; ListIndex < gUserInput.MaxProtocols; ListIndex++ )
+	{
+		if ( gOBDList[ListIndex].Protocol != ISO15765 )
+		{
+			continue;
+		}
+
+		if ( ProbeCanProtocol (ListIndex) == PASS )
+		{
+			if ( CanProbeResult[ListIndex] == CAN_PROBE_ANSWERED )
+			{
+				bCanProbeAnswered = TRUE;
+			}
+		}
+	}
+
+	if ( bCanProbeAnswered == FALSE )
+	{
+		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "No OBD response on CAN (fast CAN detect), checking the other protocols\n" );
+	}
+
+	return (PASS);
+}
+
+//*****************************************************************************
+//
+//	Function:	ProbeCanProtocol
+//
+//	Purpose:	Purpose is to check one ISO15765 protocol from the list for
+//				an OBD response using a raw CAN channel.  Sets the entry in
+//				CanProbeResult.  Returns FAIL (result unknown) if the
+//				channel could not be used.
+//
+//*****************************************************************************
+STATUS ProbeCanProtocol (unsigned long ListIndex)
+{
+	unsigned long RetVal;
+	unsigned long ChannelID;
+	unsigned long FilterID;
+	unsigned long NumMsgs;
+	unsigned long StartTimeMsecs;
+	unsigned long ElapsedMsecs;
+	unsigned long TxFlags;
+	PASSTHRU_MSG  MaskMsg;
+	PASSTHRU_MSG  PatternMsg;
+	PASSTHRU_MSG  TxMsg;
+	PASSTHRU_MSG  RxMsg;
+	STATUS        RetCode = PASS;
+
+	TxFlags = gOBDList[ListIndex].InitFlags & CAN_29BIT_ID;
+
+	/* Connect to raw CAN with the protocol's baud rate and ID size */
+	RetVal = PassThruConnect (gulDeviceID, CAN, TxFlags, gOBDList[ListIndex].BaudRate, &ChannelID);
+	if (RetVal != STATUS_NOERROR)
+	{
+		Log( J2534_FAILURE, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "%s returned %ld", "PassThruConnect(CAN)", RetVal);
+		return (FAIL);
+	}
+
+	/* Setup pass filter to read only OBD responses */
+	MaskMsg.ProtocolID    = CAN;
+	MaskMsg.TxFlags       = TxFlags;
+	MaskMsg.DataSize      = 4;
+	PatternMsg.ProtocolID = CAN;
+	PatternMsg.TxFlags    = TxFlags;
+	PatternMsg.DataSize   = 4;
+	if (TxFlags & CAN_29BIT_ID)
+	{
+		/* $18DAF1xx */
+		MaskMsg.Data[0]    = 0xFF;
+		MaskMsg.Data[1]    = 0xFF;
+		MaskMsg.Data[2]    = 0xFF;
+		MaskMsg.Data[3]    = 0x00;
+		PatternMsg.Data[0] = 0x18;
+		PatternMsg.Data[1] = 0xDA;
+		PatternMsg.Data[2] = 0xF1;
+		PatternMsg.Data[3] = 0x00;
+	}
+	else
+	{
+		/* $7E8 - $7EF */
+		MaskMsg.Data[0]    = 0xFF;
+		MaskMsg.Data[1]    = 0xFF;
+		MaskMsg.Data[2]    = 0xFF;
+		MaskMsg.Data[3]    = 0xF8;
+		PatternMsg.Data[0] = 0x00;
+		PatternMsg.Data[1] = 0x00;
+		PatternMsg.Data[2] = 0x07;
+		PatternMsg.Data[3] = 0xE8;
+	}
+
+	RetVal = PassThruStartMsgFilter (ChannelID, PASS_FILTER, &MaskMsg, &PatternMsg, NULL, &FilterID);
+	if (RetVal != STATUS_NOERROR)
+	{
+		Log( J2534_FAILURE, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "%s returned %ld", "PassThruStartMsgFilter", RetVal);
+		PassThruDisconnect (ChannelID);
+		return (FAIL);
+	}
+
+	/* Send a single frame functional SID $1 PID $0 request */
+	memset (&TxMsg, 0x00, sizeof (TxMsg));
+	TxMsg.ProtocolID = CAN;
+	TxMsg.TxFlags    = TxFlags;
+	if (TxFlags & CAN_29BIT_ID)
+	{
+		TxMsg.Data[0] = 0x18;
+		TxMsg.Data[1] = 0xDB;
+		TxMsg.Data[2] = 0x33;
+		TxMsg.Data[3] = TESTER_NODE_ADDRESS;
+	}
+	else
+	{
+		TxMsg.Data[0] = 0x00;
+		TxMsg.Data[1] = 0x00;
+		TxMsg.Data[2] = 0x07;
+		TxMsg.Data[3] = 0xDF;
+	}
+	TxMsg.Data[4]  = 0x02;	/* PCI Byte */
+	TxMsg.Data[5]  = 0x01;	/* Service ID */
+	TxMsg.Data[6]  = 0x00;	/* PID */
+	TxMsg.DataSize = 12;
+
+	CanProbeResult[ListIndex] = CAN_PROBE_SILENT;
+
+	/* A write error (no ACK) is expected at the wrong baud rate */
+	NumMsgs = 1;
+	RetVal  = PassThruWriteMsgs (ChannelID, &TxMsg, &NumMsgs, 500);
+	if (RetVal == STATUS_NOERROR)
+	{
+		/* Any SID $41 or NAK single / first frame is an OBD response */
+		StartTimeMsecs = GetTickCount ();
+		ElapsedMsecs   = 0;
+		while ( ElapsedMsecs < CAN_PROBE_WINDOW_MSECS &&
+		        CanProbeResult[ListIndex] != CAN_PROBE_ANSWERED )
+		{
+			NumMsgs = 1;
+			RetVal  = PassThruReadMsgs (ChannelID, &RxMsg, &NumMsgs, CAN_PROBE_WINDOW_MSECS - ElapsedMsecs);
+			if ( NumMsgs == 1 &&
+			     ( RxMsg.RxStatus & TX_MSG_TYPE ) == 0 &&
+			     RxMsg.DataSize >= 7 )
+			{
+				if ( ( (RxMsg.Data[4] & 0xF0) == 0x00 &&
+				       (RxMsg.Data[5] == 0x41 || (RxMsg.Data[5] == NAK && RxMsg.Data[6] == 0x01)) ) ||
+				     ( (RxMsg.Data[4] & 0xF0) == 0x10 && RxMsg.Data[6] == 0x41 ) )
+				{
+					CanProbeResult[ListIndex] = CAN_PROBE_ANSWERED;
+				}
+			}
+			else if ( (RetVal != STATUS_NOERROR) &&
+			          (RetVal != ERR_BUFFER_EMPTY) &&
+			          (RetVal != ERR_TIMEOUT) )
+			{
+				Log( J2534_FAILURE, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+				     "%s returned %ld", "PassThruReadMsgs", RetVal);
+				CanProbeResult[ListIndex] = CAN_PROBE_UNKNOWN;
+				RetCode = FAIL;
+				break;
+			}
+			ElapsedMsecs = GetTickCount () - StartTimeMsecs;
+		}
+	}
+
+	if ( CanProbeResult[ListIndex] == CAN_PROBE_ANSWERED )
+	{
+		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "OBD response on %s protocol (fast CAN detect)\n", gOBDList[ListIndex].Name);
+	}
+
+	RetVal = PassThruDisconnect (ChannelID);
+	if (RetVal != STATUS_NOERROR)
+	{
+		Log( J2534_FAILURE, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "%s returned %ld", "PassThruDisconnect", RetVal);
+	}
+
+	return RetCode;
+}
+
+//*****************************************************************************
+//
+//	Function:	IDCachedProtocol
+//
+//	Purpose:	Purpose is to connect straight to the protocol cached for
+//				this interface by the last full search, and check that the
+//				same ECUs answer SID $1 PID $0 with the same support bits
+//				(and match the initial connect, if there was one).
+//				Development runs only (gConnectCacheEnabled).  Returns FAIL
+//				if the cache can not be used, so that the full search is done.
+//
+//*****************************************************************************
+STATUS IDCachedProtocol (unsigned long *pfOBDFound)
+{
+	CONNECT_CACHE_ENTRY CacheEntry;
+	SID_REQ             SidReq;
+	unsigned long       ListIndex;
+	unsigned long       EcuIndex;
+	STATUS              RetCode = FAIL;
+
+	*pfOBDFound = FALSE;
+
+	if ( gConnectCacheEnabled == FALSE ||
+	     ConnectCacheLoad (&CacheEntry) != PASS )
+	{
+		return (FAIL);
+	}
+
+	for ( ListIndex = 0; ListIndex < gUserInput.MaxProtocols; ListIndex++ )
+	{
+		if ( gOBDList[ListIndex].ProtocolTag == CacheEntry.ProtocolTag )
+		{
+			break;
+		}
+	}
+	if ( ListIndex == gUserInput.MaxProtocols )
+	{
+		return (FAIL);
+	}
+
+	gOBDListIndex = ListIndex;
+	Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+	     "Checking for OBD on %s protocol (cached for this interface)\n",
+	     gOBDList[gOBDListIndex].Name );
+
+	/* The 29 bit target addresses come from the cache instead of SearchTAfor29bit */
+	if ((gOBDList[gOBDListIndex].Protocol == ISO15765) &&
+	    (gOBDList[gOBDListIndex].InitFlags & CAN_29BIT_ID))
+	{
+		gOBDNumEcusCan = CacheEntry.NumEcus;
+		for ( EcuIndex = 0; EcuIndex < CacheEntry.NumEcus; EcuIndex++ )
+		{
+			gOBDResponseTA[EcuIndex] = CacheEntry.Header[EcuIndex][3];
+		}
+	}
+
+	if ( ConnectProtocol () == PASS )
+	{
+		SidReq.SID      = 1;
+		SidReq.NumIds   = 1;
+		SidReq.Ids[0]   = 0;
+
+		if ( SidRequest (&SidReq, SID_REQ_NORMAL) != FAIL &&
+		     ConnectCacheMatch (&CacheEntry) == PASS &&
+		     ( gFirstConnectFlag == TRUE || MatchConnectInfo () == TRUE ) )
+		{
+			RetCode = PASS;
+		}
+	}
+
+	DisconnectProtocol ();
+
+	if ( RetCode != PASS )
+	{
+		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "Cached connect information does not match, searching all protocols\n" );
+		return (FAIL);
+	}
+
+	Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+	     "OBD on %s protocol detected\n", gOBDList[gOBDListIndex].Name);
+
+	/* The connect info was matched above, only the initial connect is saved */
+	if (gFirstConnectFlag == TRUE)
+	{
+		SaveConnectInfo();
+		gFirstConnectFlag = FALSE;
+	}
+
+	*pfOBDFound = TRUE;
+	gOBDFoundIndex = gOBDListIndex;
+
+	return (PASS);
+}
+
 //*****************************************************************************
 //
 //	Function:	SaveConnectInfo
@@ -693,6 +1059,35 @@ STATUS VerifyConnectInfo (void)
 	return ( RetCode );
 }
 
+//*****************************************************************************
+//
+//	Function:	MatchConnectInfo
+//
+//	Purpose:	Same checks as VerifyConnectInfo without logging, for the
+//				cached connect, which does the full search on a mismatch.
+//
+//*****************************************************************************
+BOOL MatchConnectInfo (void)
+{
+	unsigned long EcuIndex;
+
+	if (gOBDList[gOBDListIndex].Protocol != gInitialConnect.Protocol ||
+	    gOBDNumEcusResp != gInitialConnect.NumECUs)
+	{
+		return (FALSE);
+	}
+
+	for (EcuIndex=0; EcuIndex<gOBDNumEcusResp; EcuIndex++)
+	{
+		if (VerifyEcuID (gOBDResponse[EcuIndex].Header) == FAIL)
+		{
+			return (FALSE);
+		}
+	}
+
+	return (TRUE);
+}
+
 //*****************************************************************************
 //
 //	Function:	VerifyEcuID
@@ -51,6 +51,9 @@ STATUS DisconnectProtocol(void)
 	unsigned long RetVal;
 	STATUS RetCode = PASS;
 
+	/* The receive thread must not be reading while the channel is closed */
+	RxThreadStop ();
+
 	/* Turn off all filters and periodic messages before disconnecting */
 	RetVal = PassThruIoctl (gOBDList[gOBDListIndex].ChannelID, CLEAR_MSG_FILTERS, NULL, NULL);
 	if (RetVal != STATUS_NOERROR)
@@ -0,0 +1,286 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Every response header seen is registered once, keyed by the header bytes
+** packed into an unsigned long (with the ISO14230 length bits masked out),
+** and mapped to its gOBDResponse and gEcuTimingData slots.  Entries are
+** found with an open addressed hash table twice the registry size, and the
+** last entry found is checked first since the timing and response data of a
+** message are looked up one after the other.
+**
+** gOBDResponse, gOBDCompareResponse, gDTCList and gEcuTimingData have
+** gOBDEcuCapacity entries.  The tables start with OBD_INITIAL_ECUS entries
+** and are doubled (up to OBD_MAX_ECUS) when more ECUs respond while the
+** protocol is being determined, then sized to the responders found.  Once
+** the protocol is determined the tables never move, since the tests keep
+** pointers into them across requests; a response from an ECU not in the
+** initial list gets no slot.
+*/
+#define ECU_REGISTRY_HASH_SIZE  (2 * ECU_REGISTRY_MAX_ENTRIES)
+
+static ECU_REGISTRY_ENTRY  EcuRegistry[ECU_REGISTRY_MAX_ENTRIES];
+static unsigned long       ulEcuRegistryEntries = 0;
+static ECU_REGISTRY_ENTRY *pEcuRegistryHash[ECU_REGISTRY_HASH_SIZE];
+static ECU_REGISTRY_ENTRY *pEcuRegistryLast = NULL;
+
+/*
+*******************************************************************************
+** EcuRegistryKey - Function to pack a response header into a registry key
+*******************************************************************************
+*/
+static unsigned long EcuRegistryKey (const unsigned char *pHeader, unsigned long HeaderSize)
+{
+	unsigned long Key = 0;
+	unsigned long ByteIndex;
+
+	for (ByteIndex = 0; ByteIndex < HeaderSize && ByteIndex < 4; ByteIndex++)
+	{
+		/* If ISO14230 protocol, ignore the length bits in the first byte of header */
+		if ( ByteIndex == 0 && gOBDList[gOBDListIndex].Protocol == ISO14230 )
+		{
+			Key = pHeader[ByteIndex] & 0xC0;
+		}
+		else
+		{
+			Key = (Key << 8) | pHeader[ByteIndex];
+		}
+	}
+
+	return Key;
+}
+
+/*
+*******************************************************************************
+** EcuRegistryReset - Function to empty the ECU registry
+*******************************************************************************
+*/
+void EcuRegistryReset (void)
+{
+	memset (EcuRegistry, 0, sizeof(EcuRegistry));
+	memset (pEcuRegistryHash, 0, sizeof(pEcuRegistryHash));
+	ulEcuRegistryEntries = 0;
+	pEcuRegistryLast = NULL;
+}
+
+/*
+*******************************************************************************
+** EcuRegistryLookup - Function to find the registry entry of a response
+**                     header, adding it if the header is new.  Returns NULL
+**                     if the registry is full.
+*******************************************************************************
+*/
+ECU_REGISTRY_ENTRY *EcuRegistryLookup (const unsigned char *pHeader, unsigned long HeaderSize)
+{
+	ECU_REGISTRY_ENTRY *pEntry;
+	unsigned long       Key;
+	unsigned long       Hash;
+
+	Key = EcuRegistryKey (pHeader, HeaderSize);
+
+	if ( pEcuRegistryLast != NULL && pEcuRegistryLast->Key == Key )
+	{
+		return pEcuRegistryLast;
+	}
+
+	/* multiplicative hash, linear probing */
+	Hash = ((Key * 2654435761UL) & 0xFFFFFFFFUL) >> 16;
+	for (;;)
+	{
+		Hash %= ECU_REGISTRY_HASH_SIZE;
+		pEntry = pEcuRegistryHash[Hash];
+		if ( pEntry == NULL )
+		{
+			break;
+		}
+		if ( pEntry->Key == Key )
+		{
+			pEcuRegistryLast = pEntry;
+			return pEntry;
+		}
+		Hash++;
+	}
+
+	if ( ulEcuRegistryEntries >= ECU_REGISTRY_MAX_ENTRIES )
+	{
+		return NULL;
+	}
+
+	/* new header */
+	pEntry = &EcuRegistry[ulEcuRegistryEntries++];
+	pEntry->Key            = Key;
+	pEntry->EcuIndex       = ECU_REGISTRY_NONE;
+	pEntry->EcuTimingIndex = ECU_REGISTRY_NONE;
+	pEcuRegistryHash[Hash] = pEntry;
+
+	pEcuRegistryLast = pEntry;
+	return pEntry;
+}
+
+/*
+*******************************************************************************
+** EcuTableGrow - Function to resize one ECU table, zeroing the new entries
+*******************************************************************************
+*/
+static STATUS EcuTableGrow (void **ppTable, size_t EntrySize, unsigned long NewCapacity)
+{
+	void *pTable;
+
+	pTable = realloc (*ppTable, EntrySize * NewCapacity);
+	if ( pTable == NULL )
+	{
+		return FAIL;
+	}
+
+	memset ((unsigned char *)pTable + EntrySize * gOBDEcuCapacity, 0,
+	        EntrySize * (NewCapacity - gOBDEcuCapacity));
+	*ppTable = pTable;
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** EcuTableReserve - Function to make sure the ECU tables have room for
+**                   NumEcus ECUs
+*******************************************************************************
+*/
+STATUS EcuTableReserve (unsigned long NumEcus)
+{
+	unsigned long NewCapacity;
+
+	if ( NumEcus <= gOBDEcuCapacity )
+	{
+		return PASS;
+	}
+
+	if ( NumEcus > OBD_MAX_ECUS )
+	{
+		return FAIL;
+	}
+
+	NewCapacity = ( gOBDEcuCapacity == 0 ) ? OBD_INITIAL_ECUS : gOBDEcuCapacity * 2;
+	if ( NewCapacity < NumEcus )
+	{
+		NewCapacity = NumEcus;
+	}
+	if ( NewCapacity > OBD_MAX_ECUS )
+	{
+		NewCapacity = OBD_MAX_ECUS;
+	}
+
+	/* a table that grew before a later one failed just keeps the extra room */
+	if ( EcuTableGrow ((void **)&gOBDResponse, sizeof(OBD_DATA), NewCapacity) != PASS ||
+	     EcuTableGrow ((void **)&gOBDCompareResponse, sizeof(OBD_DATA), NewCapacity) != PASS ||
+	     EcuTableGrow ((void **)&gDTCList, sizeof(DTC_LIST), NewCapacity) != PASS ||
+	     EcuTableGrow ((void **)&gEcuTimingData, sizeof(ECU_TIMING_DATA), NewCapacity) != PASS )
+	{
+		return FAIL;
+	}
+
+	gOBDEcuCapacity = NewCapacity;
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** EcuTableReserveEcu - Function to make sure the ECU tables have room for
+**                      NumEcus ECUs for the responder with header pHeader.
+**                      Once the protocol is determined the tables are not
+**                      grown, and only the ECUs in the initial list fit.
+*******************************************************************************
+*/
+STATUS EcuTableReserveEcu (const unsigned char *pHeader, unsigned long NumEcus)
+{
+	if ( gOBDDetermined == TRUE )
+	{
+		if ( VerifyEcuID ((unsigned char *)pHeader) == FAIL ||
+		     NumEcus > gOBDEcuCapacity )
+		{
+			return FAIL;
+		}
+		return PASS;
+	}
+
+	return EcuTableReserve (NumEcus);
+}
+
+/*
+*******************************************************************************
+** EcuRegistryTimingIndex - Function to get the gEcuTimingData index of a
+**                          response header, assigning the next free one to a
+**                          new header.  Returns ECU_REGISTRY_NONE if there
+**                          is no room for another ECU, or the header is not
+**                          in the initial list once the protocol is
+**                          determined.
+*******************************************************************************
+*/
+unsigned long EcuRegistryTimingIndex (const unsigned char *pHeader, unsigned long HeaderSize, unsigned long EcuId)
+{
+	ECU_REGISTRY_ENTRY *pEntry;
+	unsigned long       EcuTimingIndex;
+
+	pEntry = EcuRegistryLookup (pHeader, HeaderSize);
+	if ( pEntry == NULL )
+	{
+		return ECU_REGISTRY_NONE;
+	}
+
+	if ( pEntry->EcuTimingIndex == ECU_REGISTRY_NONE )
+	{
+		for ( EcuTimingIndex = 0; EcuTimingIndex < gOBDEcuCapacity; EcuTimingIndex++ )
+		{
+			if ( gEcuTimingData[EcuTimingIndex].EcuId == 0x00 )
+			{
+				break;
+			}
+		}
+		if ( EcuTableReserveEcu (pHeader, EcuTimingIndex + 1) != PASS )
+		{
+			return ECU_REGISTRY_NONE;
+		}
+		gEcuTimingData[EcuTimingIndex].EcuId = EcuId;
+		pEntry->EcuTimingIndex = EcuTimingIndex;
+	}
+
+	return pEntry->EcuTimingIndex;
+}
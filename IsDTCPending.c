@@ -67,12 +67,12 @@ STATUS IsDTCPending(unsigned long Flags)
     /* Check if SID 7 reports DTCs pending */
     for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
     {
-        if (gOBDResponse[EcuIndex].Sid7Size == 0)
+        if (gOBDResponse[EcuIndex].Sid7.Size == 0)
         {
             /* If no data, ignore */
         }
         /* Check if there is at least one DTC */
-        else if ((gOBDResponse[EcuIndex].Sid7[0] != 0) || (gOBDResponse[EcuIndex].Sid7[1] != 0))
+        else if ((SidDataByte (&gOBDResponse[EcuIndex].Sid7, 0) != 0) || (SidDataByte (&gOBDResponse[EcuIndex].Sid7, 1) != 0))
         {
             /* Break the loop if a DTC is pending */
             break;
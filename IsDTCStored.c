@@ -67,12 +67,12 @@ STATUS IsDTCStored(unsigned long Flags)
     /* Check if SID 3 reports DTCs stored */
     for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
     {
-        if (gOBDResponse[EcuIndex].Sid3Size == 0)
+        if (gOBDResponse[EcuIndex].Sid3.Size == 0)
         {
             /* If no data, ignore */
         }
         /* Check if there is at least one DTC */
-        else if ((gOBDResponse[EcuIndex].Sid3[0] != 0) || (gOBDResponse[EcuIndex].Sid3[1] != 0))
+        else if ((SidDataByte (&gOBDResponse[EcuIndex].Sid3, 0) != 0) || (SidDataByte (&gOBDResponse[EcuIndex].Sid3, 1) != 0))
         {
             /* Break the loop if a DTC is stored */
             break;
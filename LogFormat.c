@@ -0,0 +1,228 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <string.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Log entry formatting that uses no globals, shared with the j1tdump
+** trace file renderer.
+*/
+
+/*
+********************************************************************************
+** LogFormatDec - writes Value in decimal, padded on the left with Pad to
+**                at least Width characters, returns the number written
+********************************************************************************
+*/
+unsigned long LogFormatDec ( char *pBuffer, unsigned long Value, unsigned long Width, char Pad )
+{
+	char Digits[10];
+	unsigned long NumDigits = 0;
+	unsigned long Length = 0;
+
+	do
+	{
+		Digits[NumDigits++] = (char)('0' + Value % 10);
+		Value /= 10;
+	} while ( Value != 0 );
+
+	while ( Width > NumDigits )
+	{
+		pBuffer[Length++] = Pad;
+		Width--;
+	}
+
+	while ( NumDigits > 0 )
+	{
+		pBuffer[Length++] = Digits[--NumDigits];
+	}
+
+	return Length;
+}
+
+
+/*
+********************************************************************************
+** LogRecordPrefix - writes the "+000000ms " timestamp of a log entry built
+**                   without WriteToLog (see LogMsg), returns its length
+********************************************************************************
+*/
+unsigned long LogRecordPrefix ( char *pBuffer, unsigned long ElapsedMsecs )
+{
+	unsigned long Length;
+
+	pBuffer[0] = '+';
+	Length = 1 + LogFormatDec( &pBuffer[1], ElapsedMsecs, 6, '0' );
+	pBuffer[Length++] = 'm';
+	pBuffer[Length++] = 's';
+	pBuffer[Length++] = ' ';
+
+	return Length;
+}
+
+
+static const char HexDigit[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
+                                    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
+
+/*
+** Append the string constant s to LogBuffer (without the terminating NUL)
+*/
+#define LOG_APPEND(s)   { memcpy (&LogBuffer[BufferIndex], s, sizeof(s) - 1); BufferIndex += sizeof(s) - 1; }
+
+/*
+*******************************************************************************
+** LogFormatFrame - Function to format the log entry of a LogMsg frame
+**
+** Network frames are logged once per frame, so the log entry (timestamp,
+** "NETWORK:" and the frame text) is built here directly, with the data
+** bytes converted through HexDigit instead of a sprintf per byte.
+** Returns the length of the entry (not NUL terminated).
+*******************************************************************************
+*/
+unsigned long LogFormatFrame (char *LogBuffer, const LOG_FRAME *pFrame, const unsigned char *pData)
+{
+	unsigned long ByteIndex;
+	unsigned long BufferIndex;
+	unsigned char Byte;
+
+	BufferIndex = LogRecordPrefix (LogBuffer, pFrame->ElapsedMsecs);
+	LOG_APPEND ("NETWORK: ");
+
+	if (pFrame->Flags & LOG_REQ_MSG)
+	{
+		LOG_APPEND ("REQ MSG:  ");
+	}
+	else
+	{
+		if (pFrame->RxStatus & TX_MSG_TYPE)
+		{
+			LOG_APPEND ("TX MSG: ");
+		}
+		else
+		{
+			LOG_APPEND ("RX MSG: ");
+		}
+		BufferIndex += LogFormatDec (&LogBuffer[BufferIndex], pFrame->Timestamp, 10, ' ');
+		LOG_APPEND ("usec ");
+	}
+
+
+	switch (pFrame->ProtocolID)
+	{
+		case J1850VPW:
+		{
+			LOG_APPEND ("J1850VPW ");
+		}
+		break;
+		case J1850PWM:
+		{
+			LOG_APPEND ("J1850PWM ");
+		}
+		break;
+		case ISO9141:
+		{
+			LOG_APPEND ("ISO9141 ");
+		}
+		break;
+		case ISO14230:
+		{
+			LOG_APPEND ("ISO14230 ");
+		}
+		break;
+		case ISO15765:
+		{
+			LOG_APPEND ("ISO15765 ");
+		}
+		break;
+		case CAN:
+		{
+			LOG_APPEND ("CAN ");
+		}
+		break;
+		default:
+		{
+			/* Unsupported protocol */
+		}
+		break;
+	}
+
+	if (pFrame->ProtocolID == ISO15765)
+	{
+		if (pFrame->RxStatus & ISO15765_FIRST_FRAME)
+		{
+			LOG_APPEND ("FirstFrame Indication ");
+		}
+		else if (pFrame->RxStatus & TX_DONE)
+		{
+			LOG_APPEND ("Tx Done Indication ");
+		}
+	}
+	if ((pFrame->ProtocolID == ISO9141 || pFrame->ProtocolID == ISO14230) && (pFrame->RxStatus & START_OF_MESSAGE))
+	{
+		LOG_APPEND ("Start of Message ");
+	}
+
+	if (pFrame->RxStatus & RX_BREAK)
+	{
+		LOG_APPEND ("BREAK Indication ");
+	}
+
+	for (ByteIndex = 0; ByteIndex < pFrame->NumBytes; ByteIndex++)
+	{
+		Byte = pData[ByteIndex];
+		LogBuffer[BufferIndex++] = HexDigit[Byte >> 4];
+		LogBuffer[BufferIndex++] = HexDigit[Byte & 0x0F];
+		LogBuffer[BufferIndex++] = ' ';
+	}
+
+	if (pFrame->fChecksum == TRUE)
+	{
+		// log ISO9141/ISO14230 checksum
+		Byte = pFrame->Checksum;
+		LogBuffer[BufferIndex++] = '(';
+		LogBuffer[BufferIndex++] = HexDigit[Byte >> 4];
+		LogBuffer[BufferIndex++] = HexDigit[Byte & 0x0F];
+		LogBuffer[BufferIndex++] = ')';
+		LogBuffer[BufferIndex++] = ' ';
+	}
+
+	LogBuffer[BufferIndex++] = '\n';
+
+	return BufferIndex;
+}
@@ -43,15 +43,17 @@
 /*
 *******************************************************************************
 ** LogMsg - Function to log a message
+**
+** While log output is suspended (Manufacturer Specific Drive Cycle) the
+** frame is only copied to the transaction ring buffer, it is formatted
+** if the transaction is written to the log file.
 *******************************************************************************
 */
 void LogMsg (PASSTHRU_MSG *Msg, unsigned long Flags)
 {
 	char LogBuffer[MAX_LOG_STRING_SIZE];
-	unsigned long ByteIndex;
-	unsigned long BufferIndex;
-
-	BufferIndex = 0;
+	LOG_FRAME Frame;
+	unsigned long NumBytes;
 
 	if (Flags & LOG_REQ_MSG)
 	{
@@ -59,93 +61,37 @@ void LogMsg (PASSTHRU_MSG *Msg, unsigned long Flags)
 		** For local messages, set ExtraDataIndex to message size.
 		*/
 		Msg->ExtraDataIndex = Msg->DataSize;
-		BufferIndex += sprintf(&LogBuffer[BufferIndex], "REQ MSG:  ");
-	}
-	else if (Msg->RxStatus & TX_MSG_TYPE)
-	{
-		BufferIndex += sprintf(&LogBuffer[BufferIndex], "TX MSG: %10luusec ", Msg->Timestamp);
-	}
-	else
-	{
-		BufferIndex += sprintf(&LogBuffer[BufferIndex], "RX MSG: %10luusec ", Msg->Timestamp);
 	}
 
+	NumBytes = min (Msg->ExtraDataIndex, Msg->DataSize);
+	NumBytes = min (NumBytes, MAX_MESSAGE_LOG_SIZE);
 
-	switch (Msg->ProtocolID)
-	{
-		case J1850VPW:
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "J1850VPW ");
-		}
-		break;
-		case J1850PWM:
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "J1850PWM ");
-		}
-		break;
-		case ISO9141:
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "ISO9141 ");
-		}
-		break;
-		case ISO14230:
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "ISO14230 ");
-		}
-		break;
-		case ISO15765:
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "ISO15765 ");
-		}
-		break;
-		case CAN:
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "CAN ");
-		}
-		break;
-		default:
-		{
-			/* Unsupported protocol */
-		}
-		break;
-	}
+	Frame.ElapsedMsecs = LogElapsedMsecs ();
+	Frame.ProtocolID   = Msg->ProtocolID;
+	Frame.RxStatus     = Msg->RxStatus;
+	Frame.Timestamp    = Msg->Timestamp;
+	Frame.Flags        = (unsigned short)Flags;
+	Frame.NumBytes     = (unsigned short)NumBytes;
+	Frame.fChecksum    = FALSE;
+	Frame.Checksum     = 0;
 
-	if (Msg->ProtocolID == ISO15765)
+	if ((Msg->ProtocolID == ISO9141) || (Msg->ProtocolID == ISO14230))
 	{
-		if (Msg->RxStatus & ISO15765_FIRST_FRAME)
-		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "FirstFrame Indication ");
-		}
-		else if (Msg->RxStatus & TX_DONE)
+		if (Msg->ExtraDataIndex < Msg->DataSize)
 		{
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "Tx Done Indication ");
+			Frame.fChecksum = TRUE;
+			Frame.Checksum  = Msg->Data[Msg->ExtraDataIndex];
 		}
 	}
-	if ((Msg->ProtocolID == ISO9141 || Msg->ProtocolID == ISO14230) && (Msg->RxStatus & START_OF_MESSAGE))
-	{
-		BufferIndex += sprintf(&LogBuffer[BufferIndex], "Start of Message ");
-	}
 
-	if (Msg->RxStatus & RX_BREAK)
-	{
-		BufferIndex += sprintf(&LogBuffer[BufferIndex], "BREAK Indication ");
-	}
-	for (ByteIndex = 0; (ByteIndex < Msg->ExtraDataIndex) && (ByteIndex < Msg->DataSize) && (ByteIndex < MAX_MESSAGE_LOG_SIZE); ByteIndex++)
+	TraceFileFrame (&Frame, Msg->Data);
+
+	if (gSuspendLogOutput == TRUE)
 	{
-		BufferIndex += sprintf(&LogBuffer[BufferIndex], "%02X ", Msg->Data[ByteIndex]);
+		AddFrameToTransactionBuffer (&Frame, Msg->Data);
 	}
-
-	if ((Msg->ProtocolID == ISO9141) || (Msg->ProtocolID == ISO14230))
+	else
 	{
-		if (Msg->ExtraDataIndex < Msg->DataSize)
-		{
-			// log ISO9141/ISO14230 checksum
-			BufferIndex += sprintf(&LogBuffer[BufferIndex], "(%02X) ", Msg->Data[Msg->ExtraDataIndex]);
-		}
+		LogWriterWrite (LogBuffer, LogFormatFrame (LogBuffer, &Frame, Msg->Data));
 	}
-
-	BufferIndex += sprintf(&LogBuffer[BufferIndex], "\n");
-
-	Log( NETWORK, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT, "%s", LogBuffer);
 }
-
@@ -36,6 +36,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include <time.h>
 #include <windows.h>
 #include "j2534.h"
@@ -50,8 +51,19 @@ typedef struct
 {
 	unsigned long ulStartIndex;
 	unsigned long ulLength;
+	unsigned long ulStartTime;  /* GetTickCount at SaveTransactionStart */
 } TRANSACTIONENTRY;
 
+/* transaction ring buffer record types */
+#define TRANSACTION_TEXT   1    /* log text, already formatted */
+#define TRANSACTION_FRAME  2    /* LOG_FRAME and the frame data bytes, formatted when logged */
+
+typedef struct
+{
+	unsigned short usType;
+	unsigned short usLength;    /* number of record data bytes following this header */
+} TRANSACTIONRECORD;
+
 
 
 /*
@@ -62,10 +74,14 @@ unsigned long gUserErrorCount = 0;         /* the total count of "USER WARNING:"
 unsigned long gFailureCount = 0;           /* the total count of "FAILURE:" */
 unsigned long gWarningCount = 0;           /* the total count of "WARNING:" */
 unsigned long gJ2534FailureCount = 0;      /* the total count of "J2534 FAILURE:" */
+unsigned long gulTransactionBufferStart = 0; /* array index of the oldest record in transaction ring buffer */
 unsigned long gulTransactionBufferEnd = 0; /* array index for end of transaction ring buffer */
+unsigned long gulTransactionBufferUsed = 0; /* number of bytes in use in transaction ring buffer */
 unsigned long gulTransactionCount = 0;     /* count of transactions in ring buffer */
-char gszTransactionBuffer[MAX_RING_BUFFER_SIZE]; /* transaction ring buffer */
-TRANSACTIONENTRY grgsTransactionList[MAX_TRANSACTION_COUNT]; /* list of start indexes for transactions in ring buffer */
+unsigned char *gTransactionBuffer = NULL;  /* transaction ring buffer */
+unsigned long gulTransactionBufferSize = 0; /* size of transaction ring buffer */
+TRANSACTIONENTRY *grgsTransactionList = NULL; /* list of start indexes for transactions in ring buffer */
+unsigned long gulTransactionListSize = 0;  /* number of entries in grgsTransactionList */
 
 
 /*
@@ -86,11 +102,21 @@ char Log( LOGTYPE LogType, SCREENOUTPUT ScreenOutput, LOGOUTPUT LogOutput, PROMP
 	// Get the full input string
 	va_list Args;
 
-	va_start ( Args, LogString );
+	// Only format the string if it will be printed, logged or prompted
+	if ( (PromptType != NO_PROMPT) ||
+	     (LogOutput == LOGOUTPUTON) ||
+	     ((ScreenOutput == SCREENOUTPUTON) && (gSuspendScreenOutput == FALSE)) )
+	{
+		va_start ( Args, LogString );
 
-	vsprintf ( PrintString, LogString, Args );
+		vsprintf ( PrintString, LogString, Args );
 
-	va_end ( Args );
+		va_end ( Args );
+	}
+	else
+	{
+		PrintString[0] = '\0';
+	}
 
 
 
@@ -189,6 +215,18 @@ char Log( LOGTYPE LogType, SCREENOUTPUT ScreenOutput, LOGOUTPUT LogOutput, PROMP
 		break;
 	}
 
+	// Mark the start and end of the test sections in the trace file
+	if ( LogType == SUBSECTION_BEGIN ||
+	     LogType == SUBSECTION_PASSED_RESULT ||
+	     LogType == SUBSECTION_FAILED_RESULT ||
+	     LogType == SUBSECTION_INCOMPLETE_RESULT ||
+	     LogType == SECTION_PASSED_RESULT ||
+	     LogType == SECTION_FAILED_RESULT ||
+	     LogType == SECTION_INCOMPLETE_RESULT )
+	{
+		TraceFileMarker ( PrintBuffer );
+	}
+
 	if ( (LogType != PROMPT) && (LogType != COMMENT) )
 	{
 		// If Enabled, Print to the Screen
@@ -495,32 +533,248 @@ void WriteToLog ( char *LogString, LOGTYPE LogType )
 
 	gLastLogTime = GetTickCount();
 
+	LogRecordWrite( LogBuffer, strlen(LogBuffer) );
+}
+
+
+/*
+********************************************************************************
+** LogElapsedMsecs - returns the msecs since the previous log entry and
+**                   starts a new log entry
+********************************************************************************
+*/
+unsigned long LogElapsedMsecs ( void )
+{
+	unsigned long TimeMsecs;
+	unsigned long ElapsedMsecs;
+
+	TimeMsecs = GetTickCount();
+	ElapsedMsecs = TimeMsecs - gLastLogTime;
+	gLastLogTime = TimeMsecs;
+
+	return ElapsedMsecs;
+}
+
+
+/*
+********************************************************************************
+** LogRecordWrite - writes a complete log entry to the log file, or to the
+**                  transaction ring buffer while log output is suspended
+**                  (pRecord must have room for the terminating NUL)
+********************************************************************************
+*/
+void LogRecordWrite ( char *pRecord, unsigned long Length )
+{
 	if ( gSuspendLogOutput == FALSE )
 	{
-		fputs( LogBuffer, ghLogFile );
-		fflush( ghLogFile );
+		LogWriterWrite( pRecord, Length );
 	}
 	else
 	{
-		AddToTransactionBuffer( LogBuffer );
+		pRecord[Length] = '\0';
+		AddToTransactionBuffer( pRecord );
 	}
 }
 
 
-
-
 /*
  * During the Manufacturer Specific Drive Cycle in the Dynamic Test, writing to 
  * the log file is suspended to avoid making the log files too large. Only state
  * changes and FAILUREs are logged. To help improve OEM debugging a ring buffer
  * was added so that network transactions prior to the failure could also be logged.
- * gszTransactionBuffer is used as temporary storage for strings that would
+ * gTransactionBuffer is used as temporary storage for records that would
  * normally be written to the log file. The start of each transaction is marked by a
- * call to SaveTransactionStart, which records the offset in gszTransactionBuffer
- * where the strings will be written. The size of a transaction will vary and will
- * include multiple strings - size the buffers accordingly!
+ * call to SaveTransactionStart, which records the offset in gTransactionBuffer
+ * where the records will be written. The size of a transaction will vary and will
+ * include multiple records - size the buffers accordingly!
+ *
+ * Each record is a TRANSACTIONRECORD header followed by its data. Log text is
+ * kept as it would have been written (TRANSACTION_TEXT). Network frames are
+ * kept as a LOG_FRAME and the frame data bytes (TRANSACTION_FRAME) and are only
+ * formatted by LogMsg's LogFormatFrame if the transaction is written to the
+ * log file, most of them never are. When the buffer is full the oldest
+ * records are dropped, gulTransactionBufferStart is the oldest record kept.
+ *
+ * The buffer is gTransactionBufferMB MBytes, allocated at start up, with one
+ * grgsTransactionList entry per TRANSACTION_LIST_BYTES of it. On a failure
+ * DumpTransactionBuffer writes the last gTransactionDumpCount transactions,
+ * or the last gTransactionDumpSecs seconds of them.
  */
 
+/*
+********************************************************************************
+** TransactionBufferWrite - copies data to the end of the transaction ring buffer
+********************************************************************************
+*/
+static void TransactionBufferWrite (const void *pData, unsigned long ulSize)
+{
+	unsigned long ulCount;
+
+	ulCount = min (ulSize, gulTransactionBufferSize - gulTransactionBufferEnd);
+	memcpy (&gTransactionBuffer[gulTransactionBufferEnd], pData, ulCount);
+	memcpy (&gTransactionBuffer[0], (const unsigned char *)pData + ulCount, ulSize - ulCount);
+
+	gulTransactionBufferEnd = (gulTransactionBufferEnd + ulSize) % gulTransactionBufferSize;
+	gulTransactionBufferUsed += ulSize;
+}
+
+
+/*
+********************************************************************************
+** TransactionBufferRead - copies data from the transaction ring buffer,
+**                         returns the index following it
+********************************************************************************
+*/
+static unsigned long TransactionBufferRead (unsigned long ulIndex, void *pData, unsigned long ulSize)
+{
+	unsigned long ulCount;
+
+	ulCount = min (ulSize, gulTransactionBufferSize - ulIndex);
+	memcpy (pData, &gTransactionBuffer[ulIndex], ulCount);
+	memcpy ((unsigned char *)pData + ulCount, &gTransactionBuffer[0], ulSize - ulCount);
+
+	return (ulIndex + ulSize) % gulTransactionBufferSize;
+}
+
+
+/*
+********************************************************************************
+** AddTransactionRecord - Adds a record to the transaction ring buffer,
+**                        dropping the oldest records to make room for it
+********************************************************************************
+*/
+static void AddTransactionRecord (unsigned short usType,
+                                  const void *pData1, unsigned long ulSize1,
+                                  const void *pData2, unsigned long ulSize2)
+{
+	TRANSACTIONRECORD sRecord;
+	unsigned long ulRecordSize;
+
+	ulRecordSize = sizeof(sRecord) + ulSize1 + ulSize2;
+	if ( ulRecordSize > gulTransactionBufferSize )
+	{
+		return;
+	}
+
+	while ( (gulTransactionBufferUsed + ulRecordSize) > gulTransactionBufferSize )
+	{
+		TransactionBufferRead (gulTransactionBufferStart, &sRecord, sizeof(sRecord));
+		gulTransactionBufferStart = (gulTransactionBufferStart + sizeof(sRecord) + sRecord.usLength) % gulTransactionBufferSize;
+		gulTransactionBufferUsed -= sizeof(sRecord) + sRecord.usLength;
+	}
+
+	/* update the transaction size */
+	grgsTransactionList[(gulTransactionCount - 1) % gulTransactionListSize].ulLength += ulRecordSize;
+
+	sRecord.usType   = usType;
+	sRecord.usLength = (unsigned short)(ulSize1 + ulSize2);
+	TransactionBufferWrite (&sRecord, sizeof(sRecord));
+	TransactionBufferWrite (pData1, ulSize1);
+	TransactionBufferWrite (pData2, ulSize2);
+}
+
+
+/*
+********************************************************************************
+** LogTransactionRecords - Writes ulSize bytes of transaction ring buffer
+**                         records, starting at ulIndex, to the log file
+********************************************************************************
+*/
+static void LogTransactionRecords (unsigned long ulIndex, unsigned long ulSize)
+{
+	TRANSACTIONRECORD sRecord;
+	LOG_FRAME sFrame;
+	unsigned char Data[MAX_MESSAGE_LOG_SIZE];
+	char szRecordBuffer[MAX_LOG_STRING_SIZE];
+	unsigned long ulLength;
+#ifdef _DEBUG
+	static const char szRollover[]  = "\n*** ROLLOVER ***\n";
+	unsigned long ulRecordIndex;
+#endif
+
+	while ( ulSize >= sizeof(sRecord) )
+	{
+#ifdef _DEBUG
+		ulRecordIndex = ulIndex;
+#endif
+		ulIndex = TransactionBufferRead (ulIndex, &sRecord, sizeof(sRecord));
+		if ( ulSize < (sizeof(sRecord) + sRecord.usLength) )
+		{
+			break;
+		}
+		ulSize -= sizeof(sRecord) + sRecord.usLength;
+
+		if ( (sRecord.usType == TRANSACTION_FRAME) &&
+		     (sRecord.usLength >= sizeof(sFrame)) &&
+		     (sRecord.usLength - sizeof(sFrame) <= sizeof(Data)) )
+		{
+			ulIndex = TransactionBufferRead (ulIndex, &sFrame, sizeof(sFrame));
+			ulIndex = TransactionBufferRead (ulIndex, Data, sRecord.usLength - sizeof(sFrame));
+			ulLength = LogFormatFrame (szRecordBuffer, &sFrame, Data);
+			LogWriterWrite (szRecordBuffer, ulLength);
+		}
+		else if ( (sRecord.usType == TRANSACTION_TEXT) &&
+		          (sRecord.usLength <= sizeof(szRecordBuffer)) )
+		{
+			ulIndex = TransactionBufferRead (ulIndex, szRecordBuffer, sRecord.usLength);
+			LogWriterWrite (szRecordBuffer, sRecord.usLength);
+		}
+		else
+		{
+			ulIndex = (ulIndex + sRecord.usLength) % gulTransactionBufferSize;
+		}
+
+#ifdef _DEBUG
+		if ( ulIndex <= ulRecordIndex )
+		{
+			LogWriterWrite(szRollover, sizeof(szRollover) - 1);
+		}
+#endif
+	}
+}
+
+
+/*
+********************************************************************************
+** TransactionBufferReserve - allocates the gTransactionBufferMB MByte
+**                            transaction ring buffer and its transaction list
+********************************************************************************
+*/
+STATUS TransactionBufferReserve (void)
+{
+	unsigned long ulBufferSize;
+	unsigned long ulListSize;
+
+	if ( grgsTransactionList != NULL )
+	{
+		return PASS;
+	}
+
+	ulBufferSize = (gTransactionBufferMB != 0) ? (gTransactionBufferMB * 1024 * 1024) : MAX_RING_BUFFER_SIZE;
+
+	ulListSize = ulBufferSize / TRANSACTION_LIST_BYTES;
+	if ( ulListSize < MAX_TRANSACTION_COUNT )
+	{
+		ulListSize = MAX_TRANSACTION_COUNT;
+	}
+
+	gTransactionBuffer = (unsigned char *)malloc (ulBufferSize);
+	grgsTransactionList = (TRANSACTIONENTRY *)calloc (ulListSize, sizeof(TRANSACTIONENTRY));
+	if ( gTransactionBuffer == NULL || grgsTransactionList == NULL )
+	{
+		free (gTransactionBuffer);
+		free (grgsTransactionList);
+		gTransactionBuffer = NULL;
+		grgsTransactionList = NULL;
+		return FAIL;
+	}
+
+	gulTransactionBufferSize = ulBufferSize;
+	gulTransactionListSize = ulListSize;
+	return PASS;
+}
+
+
 /*
 ********************************************************************************
 ** SaveTransactionStart - saves the start index a of a new transaction
@@ -529,18 +783,19 @@ void WriteToLog ( char *LogString, LOGTYPE LogType )
 void SaveTransactionStart (void)
 {
 	/* add this transaction to the list */
-	grgsTransactionList[gulTransactionCount % MAX_TRANSACTION_COUNT].ulStartIndex = gulTransactionBufferEnd;
+	grgsTransactionList[gulTransactionCount % gulTransactionListSize].ulStartIndex = gulTransactionBufferEnd;
+	grgsTransactionList[gulTransactionCount % gulTransactionListSize].ulStartTime = GetTickCount();
 
 	gulTransactionCount++;
 
 	/* account for roll over */
-	if ( gulTransactionCount == (MAX_TRANSACTION_COUNT * 2) )
+	if ( gulTransactionCount == (gulTransactionListSize * 2) )
 	{
-		gulTransactionCount = MAX_TRANSACTION_COUNT;
+		gulTransactionCount = gulTransactionListSize;
 	}
 
 	/* zero out the next length */
-	grgsTransactionList[gulTransactionCount % MAX_TRANSACTION_COUNT].ulLength = 0;
+	grgsTransactionList[gulTransactionCount % gulTransactionListSize].ulLength = 0;
 }
 
 
@@ -551,27 +806,19 @@ void SaveTransactionStart (void)
 */
 void AddToTransactionBuffer (char *pszStringToAdd)
 {
-	unsigned long ulStringLength;
-	unsigned long ulCount;
-
-	ulStringLength = strlen(pszStringToAdd);
+	AddTransactionRecord (TRANSACTION_TEXT, pszStringToAdd, strlen(pszStringToAdd), NULL, 0);
+}
 
-	/* update the transaction size */
-	grgsTransactionList[(gulTransactionCount - 1) % MAX_TRANSACTION_COUNT].ulLength += ulStringLength;
 
-	if ( (gulTransactionBufferEnd + ulStringLength) < sizeof(gszTransactionBuffer) )
-	{
-		strcpy (&gszTransactionBuffer[gulTransactionBufferEnd], pszStringToAdd);
-		gulTransactionBufferEnd += ulStringLength;
-	}
-	else
-	{
-		/* account for buffer roll over */
-		ulCount = (sizeof(gszTransactionBuffer) - gulTransactionBufferEnd);
-		strncpy(&gszTransactionBuffer[gulTransactionBufferEnd], pszStringToAdd, ulCount);
-		strcpy(&gszTransactionBuffer[0], &pszStringToAdd[ulCount]);
-		gulTransactionBufferEnd = ulStringLength - ulCount;
-	}
+/*
+********************************************************************************
+** AddFrameToTransactionBuffer - Adds a LogMsg frame to the transaction ring
+**                               buffer, it is formatted when it is logged
+********************************************************************************
+*/
+void AddFrameToTransactionBuffer (const LOG_FRAME *pFrame, const unsigned char *pData)
+{
+	AddTransactionRecord (TRANSACTION_FRAME, pFrame, sizeof(*pFrame), pData, pFrame->NumBytes);
 }
 
 
@@ -582,40 +829,30 @@ void AddToTransactionBuffer (char *pszStringToAdd)
 */
 void LogLastTransaction (void)
 {
-	unsigned long ulTempBufferStart = 0;
+	TRANSACTIONENTRY *pTransaction;
 
-	ulTempBufferStart = grgsTransactionList[(gulTransactionCount - 1) % MAX_TRANSACTION_COUNT].ulStartIndex;
+	pTransaction = &grgsTransactionList[(gulTransactionCount - 1) % gulTransactionListSize];
 
-	if (ulTempBufferStart < gulTransactionBufferEnd)
+	if (pTransaction->ulLength <= gulTransactionBufferUsed)
 	{
-		fwrite(
-		        &gszTransactionBuffer[ulTempBufferStart],
-		        1,
-		        (gulTransactionBufferEnd - ulTempBufferStart),
-		        ghLogFile
-		      );
+		LogTransactionRecords (pTransaction->ulStartIndex, pTransaction->ulLength);
 	}
 	else
 	{
-		/* account for buffer roll over */
-		fwrite(
-		        &gszTransactionBuffer[ulTempBufferStart],
-		        1,
-		        (sizeof(gszTransactionBuffer) - ulTempBufferStart),
-		        ghLogFile
-		      );
-
-		fwrite(&gszTransactionBuffer[0], 1, gulTransactionBufferEnd, ghLogFile);
+		/* the start of the transaction was dropped, log what is left of it */
+		LogTransactionRecords (gulTransactionBufferStart, gulTransactionBufferUsed);
 	}
-
-	fflush(ghLogFile);
-
 }
 
 
 /*
 ********************************************************************************
 ** DumpTransactionBuffer - Write transaction ring buffer to log file
+**
+** Writes the last gTransactionDumpCount transactions, or if
+** gTransactionDumpSecs is not 0, the transactions started in that many
+** last seconds (at least the last transaction), as far as they are still
+** in the ring buffer.
 ********************************************************************************
 */
 void DumpTransactionBuffer (void)
@@ -623,15 +860,21 @@ void DumpTransactionBuffer (void)
 	unsigned long ulTempTransCount = 0;
 	unsigned long ulTempEntryCount = 0;
 	unsigned long ulTempSize = 0;
+	unsigned long ulTransLength = 0;
 	unsigned long ulTempBufferStart = 0;
+	unsigned long ulTimeNow;
+	TRANSACTIONENTRY *pTransaction;
 	BOOL bDone = FALSE;
 	char szTempBuffer[MAX_LOG_STRING_SIZE];
+	static const char szDumpStart[] = "\n******** Buffer dump start (Failure detected) ********\n";
+	static const char szDumpEnd[]   = "******** Buffer dump end (Failure detected) ********\n\n";
 
 
 	szTempBuffer[0] = 0;
 	ulTempTransCount = gulTransactionCount;
+	ulTimeNow = GetTickCount();
 
-	fputs("\n******** Buffer dump start (Failure detected) ********\n", ghLogFile);
+	LogWriterWrite(szDumpStart, sizeof(szDumpStart) - 1);
 
 	if (gulTransactionCount > 0)
 	{
@@ -639,71 +882,65 @@ void DumpTransactionBuffer (void)
 		do
 		{
 			ulTempTransCount--;
-			ulTempSize += grgsTransactionList[ulTempTransCount % MAX_TRANSACTION_COUNT].ulLength;
+			pTransaction = &grgsTransactionList[ulTempTransCount % gulTransactionListSize];
+			ulTransLength = pTransaction->ulLength;
 
-			if (ulTempSize > sizeof(gszTransactionBuffer))
+			if ((ulTempSize + ulTransLength) > gulTransactionBufferUsed)
 			{
 				/* went too far back, this transaction was over-written */
 				bDone = TRUE;
 				ulTempTransCount++;
 			}
+			else if ( (gTransactionDumpSecs != 0) &&
+			          (ulTempEntryCount > 0) &&
+			          ((ulTimeNow - pTransaction->ulStartTime) > (gTransactionDumpSecs * 1000)) )
+			{
+				/* went too far back, this transaction is older than wanted */
+				bDone = TRUE;
+				ulTempTransCount++;
+			}
 			else
 			{
+				ulTempSize += ulTransLength;
 				ulTempEntryCount++;
 			}
 
 		} while (
 		          (bDone == FALSE) &&
 		          (ulTempTransCount > 0) &&
-		          (ulTempEntryCount < DESIRED_DUMP_SIZE)
+		          (ulTempEntryCount < (gulTransactionListSize - 1)) &&
+		          ((gTransactionDumpSecs != 0) || (ulTempEntryCount < gTransactionDumpCount))
 		        );
 
-		ulTempBufferStart = grgsTransactionList[ulTempTransCount % MAX_TRANSACTION_COUNT].ulStartIndex;
-
-
 		/* output the transaction buffer */
-		if (ulTempBufferStart < gulTransactionBufferEnd)
+		if (ulTempEntryCount > 0)
 		{
-			fwrite(
-			        &gszTransactionBuffer[ulTempBufferStart],
-			        1,
-			        (gulTransactionBufferEnd - ulTempBufferStart),
-			        ghLogFile
-			      );
+			ulTempBufferStart = grgsTransactionList[ulTempTransCount % gulTransactionListSize].ulStartIndex;
+			LogTransactionRecords (ulTempBufferStart, ulTempSize);
 		}
 		else
 		{
-			/* account for buffer roll over */
-			fwrite(
-			        &gszTransactionBuffer[ulTempBufferStart],
-			        1,
-			        (sizeof(gszTransactionBuffer) - ulTempBufferStart),
-			        ghLogFile
-			      );
-#ifdef _DEBUG
-			fputs("\n*** ROLLOVER ***\n", ghLogFile);
-#endif
-			fwrite(&gszTransactionBuffer[0], 1, gulTransactionBufferEnd, ghLogFile);
+			/* the last transaction alone over-ran the buffer, log what is left of it */
+			ulTempBufferStart = gulTransactionBufferStart;
+			LogTransactionRecords (gulTransactionBufferStart, gulTransactionBufferUsed);
 		}
 	}
 
 #ifdef _DEBUG
-	sprintf( szTempBuffer, "TransCnt: %d, Start: %d, End: %d\n", gulTransactionCount, ulTempBufferStart, gulTransactionBufferEnd);
-	fputs ( szTempBuffer, ghLogFile );
-	for (ulTempTransCount = 0; ulTempTransCount < MAX_TRANSACTION_COUNT; ulTempTransCount++)
+	sprintf( szTempBuffer, "TransCnt: %d, Start: %d, End: %d, Used: %d\n", gulTransactionCount, ulTempBufferStart, gulTransactionBufferEnd, gulTransactionBufferUsed);
+	LogWriterWrite ( szTempBuffer, strlen(szTempBuffer) );
+	for (; ulTempEntryCount > 0; ulTempTransCount++, ulTempEntryCount--)
 	{
 		sprintf( szTempBuffer,
 		         "Idx: %d, Start: %d, Size: %d\n",
-		         ulTempTransCount,
-		         grgsTransactionList[ulTempTransCount % MAX_TRANSACTION_COUNT].ulStartIndex,
-		         grgsTransactionList[ulTempTransCount % MAX_TRANSACTION_COUNT].ulLength);
-		fputs ( szTempBuffer, ghLogFile );
+		         ulTempTransCount % gulTransactionListSize,
+		         grgsTransactionList[ulTempTransCount % gulTransactionListSize].ulStartIndex,
+		         grgsTransactionList[ulTempTransCount % gulTransactionListSize].ulLength);
+		LogWriterWrite ( szTempBuffer, strlen(szTempBuffer) );
 	}
 #endif
 
-	fputs("******** Buffer dump end (Failure detected) ********\n\n", ghLogFile);
-
-	fflush(ghLogFile);
+	LogWriterWrite(szDumpEnd, sizeof(szDumpEnd) - 1);
 
 	ClearTransactionBuffer();
 }
@@ -716,10 +953,11 @@ void DumpTransactionBuffer (void)
 */
 void ClearTransactionBuffer (void)
 {
+	gulTransactionBufferStart = 0;
 	gulTransactionBufferEnd = 0;
+	gulTransactionBufferUsed = 0;
 	gulTransactionCount = 0;
-	gszTransactionBuffer[0] = 0;
-	memset(&grgsTransactionList[0], 0x00, sizeof(grgsTransactionList));
+	memset(&grgsTransactionList[0], 0x00, gulTransactionListSize * sizeof(TRANSACTIONENTRY));
 }
 
 
@@ -734,6 +972,35 @@ unsigned long GetFailureCount (void)
 }
 
 
+/* ECU count prompts logged by revisions before 16.01.00 (up to 8 ECUs) */
+static const char szPrevPromptObdEcu[]  = "How many OBD-II ECUs are on this vehicle (1 to 8)?  ";
+static const char szPrevPromptRpgmEcu[] = "How many reprogrammable OBD-II ECUs are on this vehicle (1 to 8)?  ";
+
+/*
+*******************************************************************************
+** FindPromptValue
+**
+** Returns the user input following szPrompt or szPrevPrompt (the same prompt
+** as logged by an earlier revision) in szLine, or 0 if neither is found.
+*******************************************************************************
+*/
+static char *FindPromptValue ( char *szLine, const char *szPrompt, const char *szPrevPrompt )
+{
+	char *pcBuf;
+
+	if ( (pcBuf = substring(szLine, szPrompt)) != 0 )
+	{
+		return &pcBuf[strlen(szPrompt)];
+	}
+
+	if ( (pcBuf = substring(szLine, szPrevPrompt)) != 0 )
+	{
+		return &pcBuf[strlen(szPrevPrompt)];
+	}
+
+	return 0;
+}
+
 /*
 *******************************************************************************
 ** VerifyLogFile
@@ -818,9 +1085,9 @@ STATUS VerifyLogFile ( FILE *hFileHandle )
 				}
 			}
 
-			if ( (pcBuf = substring(cBuffer, g_rgpcDisplayStrings[DSPSTR_PRMPT_OBD_ECU])) != 0 )
+			if ( (pcBuf = FindPromptValue(cBuffer, g_rgpcDisplayStrings[DSPSTR_PRMPT_OBD_ECU], szPrevPromptObdEcu)) != 0 )
 			{
-				ulTempValue = atol(&pcBuf[strlen(g_rgpcDisplayStrings[DSPSTR_PRMPT_OBD_ECU])]);
+				ulTempValue = atol(pcBuf);
 				if ( gUserNumEcus != ulTempValue )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT,
@@ -829,9 +1096,9 @@ STATUS VerifyLogFile ( FILE *hFileHandle )
 				}
 			}
 
-			if ( (pcBuf = substring(cBuffer, g_rgpcDisplayStrings[DSPSTR_PRMPT_RPGM_ECU])) != 0 )
+			if ( (pcBuf = FindPromptValue(cBuffer, g_rgpcDisplayStrings[DSPSTR_PRMPT_RPGM_ECU], szPrevPromptRpgmEcu)) != 0 )
 			{
-				ulTempValue = atol(&pcBuf[strlen(g_rgpcDisplayStrings[DSPSTR_PRMPT_RPGM_ECU])]);
+				ulTempValue = atol(pcBuf);
 				if ( gUserNumEcusReprgm != ulTempValue )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT,
@@ -975,7 +1242,7 @@ void LogStats (void)
 	     "The statistics for the test so far are about to be written to the log file.");
 
 	/* Print out the request / response statistics */
-	for ( EcuIndex = 0; EcuIndex < OBD_MAX_ECUS; EcuIndex++ )
+	for ( EcuIndex = 0; EcuIndex < gOBDEcuCapacity; EcuIndex++ )
 	{
 		if ( gEcuTimingData[EcuIndex].EcuId == 0x00 )
 		{
@@ -996,6 +1263,9 @@ void LogStats (void)
 		     gEcuTimingData[EcuIndex].RespTimeTooSoon,
 		     gEcuTimingData[EcuIndex].RespTimeTooLate );
 
+		/* Response time percentiles by SID (resets the histograms) */
+		LogRespTimeHist (EcuIndex);
+
 		/* Reset the per-ECU stats */
 		gEcuTimingData[EcuIndex].AggregateResponseTimeMsecs = 0;
 		gEcuTimingData[EcuIndex].AggregateResponses = 0;
@@ -1005,6 +1275,19 @@ void LogStats (void)
 		gEcuTimingData[EcuIndex].RespTimeTooLate = 0;
 	}
 
+	/* Print out the receive batching statistics */
+	if ( gSidReadCalls != 0 )
+	{
+		Log( RESULTS, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "Average Messages Per PassThruReadMsgs = %.2f (%lu messages, %lu reads)\n",
+		     (float)gSidReadMsgs / (float)gSidReadCalls,
+		     gSidReadMsgs,
+		     gSidReadCalls );
+
+		gSidReadCalls = 0;
+		gSidReadMsgs = 0;
+	}
+
 	Log( RESULTS, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 	     "%s%d.\n", g_rgpcDisplayStrings[DSPSTR_RSLT_TOT_USR_ERROR], gUserErrorCount);
 	Log( RESULTS, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -0,0 +1,349 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Log file writer thread.
+**
+** WriteToLog and the transaction buffer dumps append their text to a byte
+** ring and a writer thread copies it to ghLogFile in large fwrite calls
+** followed by one fflush, instead of an fputs / fflush per log line on the
+** thread that times the ECU responses.
+**
+** The ring is single-producer / single-consumer, the producers only write
+** lLogHead and the writer thread only writes lLogTail.  The console control
+** handler logs from its own thread, so producers take LogProducerLock
+** (uncontended, no kernel call) before appending.
+**
+** The writer wakes every LOG_FLUSH_INTERVAL_MSECS (or when the ring fills
+** past LOG_WAKE_LEVEL), so a line reaches the file within that time.  The
+** ring is never overwritten: a producer waits for room when it is full.
+**
+** Anything that uses ghLogFile directly (fseek, fgets, fclose, ...) must
+** call LogWriterFlush first.  StopTest stops the thread (LogWriterStop),
+** which writes everything still queued before the log files are closed.
+*/
+#define LOG_RING_SIZE               0x40000     /* bytes, must be a power of 2 */
+#define LOG_WAKE_LEVEL              (LOG_RING_SIZE / 4)
+#define LOG_FLUSH_INTERVAL_MSECS    200
+#define LOG_THREAD_STOP_TIMEOUT     5000        /* msec, give up waiting for a stuck write */
+
+static char           LogRing[LOG_RING_SIZE];
+static LONG volatile  lLogHead         = 0;     /* bytes queued (producers) */
+static LONG volatile  lLogTail         = 0;     /* bytes written (writer thread) */
+static LONG volatile  lLogFlushReq     = 0;     /* flush requests made (producers) */
+static LONG volatile  lLogFlushDone    = 0;     /* flush requests completed (writer thread) */
+static LONG volatile  lLogExit         = FALSE;
+static HANDLE         hLogThread       = NULL;
+static HANDLE         hLogWakeEvent    = NULL;  /* auto-reset, wakes the writer early */
+static HANDLE         hLogFlushedEvent = NULL;  /* auto-reset, set when a flush request is done */
+static CRITICAL_SECTION LogProducerLock;
+static BOOL           fLogLockInit     = FALSE;
+
+static DWORD WINAPI LogWriterProc (LPVOID pParam);
+static void LogWriterWaitFlushed (void);
+
+
+/*
+*******************************************************************************
+** LogWriterStart - Function to start the log file writer thread.  If it
+**                  cannot start, the log is written on the calling thread.
+*******************************************************************************
+*/
+STATUS LogWriterStart (void)
+{
+	DWORD ThreadId;
+
+	if ( fLogLockInit == FALSE )
+	{
+		InitializeCriticalSection (&LogProducerLock);
+		fLogLockInit = TRUE;
+	}
+
+	EnterCriticalSection (&LogProducerLock);
+
+	if ( hLogThread != NULL )
+	{
+		LeaveCriticalSection (&LogProducerLock);
+		return(PASS);
+	}
+
+	lLogHead      = 0;
+	lLogTail      = 0;
+	lLogFlushReq  = 0;
+	lLogFlushDone = 0;
+	lLogExit      = FALSE;
+
+	hLogWakeEvent    = CreateEvent (NULL, FALSE, FALSE, NULL);
+	hLogFlushedEvent = CreateEvent (NULL, FALSE, FALSE, NULL);
+	if ( hLogWakeEvent != NULL && hLogFlushedEvent != NULL )
+	{
+		hLogThread = CreateThread (NULL, 0, LogWriterProc, NULL, 0, &ThreadId);
+	}
+
+	if ( hLogThread == NULL )
+	{
+		if ( hLogWakeEvent != NULL )
+		{
+			CloseHandle (hLogWakeEvent);
+			hLogWakeEvent = NULL;
+		}
+		if ( hLogFlushedEvent != NULL )
+		{
+			CloseHandle (hLogFlushedEvent);
+			hLogFlushedEvent = NULL;
+		}
+		LeaveCriticalSection (&LogProducerLock);
+		return(FAIL);
+	}
+
+	/* the file writes must not delay the response timing */
+	SetThreadPriority (hLogThread, THREAD_PRIORITY_BELOW_NORMAL);
+
+	LeaveCriticalSection (&LogProducerLock);
+	return(PASS);
+}
+
+/*
+*******************************************************************************
+** LogWriterStop - Function to write everything queued for the log file and
+**                 stop the writer thread.  Later writes go straight to the file.
+*******************************************************************************
+*/
+void LogWriterStop (void)
+{
+	if ( fLogLockInit == FALSE )
+	{
+		return;
+	}
+
+	EnterCriticalSection (&LogProducerLock);
+
+	if ( hLogThread != NULL )
+	{
+		LogWriterWaitFlushed ();
+
+		InterlockedExchange (&lLogExit, TRUE);
+		SetEvent (hLogWakeEvent);
+		WaitForSingleObject (hLogThread, LOG_THREAD_STOP_TIMEOUT);
+		CloseHandle (hLogThread);
+		hLogThread = NULL;
+
+		CloseHandle (hLogWakeEvent);
+		hLogWakeEvent = NULL;
+		CloseHandle (hLogFlushedEvent);
+		hLogFlushedEvent = NULL;
+	}
+
+	LeaveCriticalSection (&LogProducerLock);
+}
+
+/*
+*******************************************************************************
+** LogWriterWrite - Function to queue text for the log file
+*******************************************************************************
+*/
+void LogWriterWrite (const char *pData, unsigned long Size)
+{
+	LONG          Head;
+	unsigned long Free;
+	unsigned long Chunk;
+
+	if ( fLogLockInit == FALSE )
+	{
+		fwrite (pData, 1, Size, ghLogFile);
+		fflush (ghLogFile);
+		return;
+	}
+
+	EnterCriticalSection (&LogProducerLock);
+
+	if ( hLogThread == NULL )
+	{
+		fwrite (pData, 1, Size, ghLogFile);
+		fflush (ghLogFile);
+		LeaveCriticalSection (&LogProducerLock);
+		return;
+	}
+
+	while ( Size > 0 )
+	{
+		/* Ring full, let the writer catch up */
+		Head = lLogHead;
+		Free = LOG_RING_SIZE - (unsigned long)(Head - lLogTail);
+		if ( Free == 0 )
+		{
+			SetEvent (hLogWakeEvent);
+			Sleep (1);
+			continue;
+		}
+
+		/* copy up to the end of the ring, the rest goes to the start */
+		Chunk = LOG_RING_SIZE - (Head & (LOG_RING_SIZE - 1));
+		Chunk = min (Chunk, Free);
+		Chunk = min (Chunk, Size);
+		memcpy (&LogRing[Head & (LOG_RING_SIZE - 1)], pData, Chunk);
+
+		/* publish the text */
+		InterlockedExchange (&lLogHead, Head + (LONG)Chunk);
+
+		pData += Chunk;
+		Size  -= Chunk;
+	}
+
+	if ( (unsigned long)(lLogHead - lLogTail) >= LOG_WAKE_LEVEL )
+	{
+		SetEvent (hLogWakeEvent);
+	}
+
+	LeaveCriticalSection (&LogProducerLock);
+}
+
+/*
+*******************************************************************************
+** LogWriterFlush - Function to wait until everything queued is in the file
+**                  (call before using ghLogFile directly)
+*******************************************************************************
+*/
+void LogWriterFlush (void)
+{
+	if ( fLogLockInit == FALSE )
+	{
+		fflush (ghLogFile);
+		return;
+	}
+
+	EnterCriticalSection (&LogProducerLock);
+
+	if ( hLogThread == NULL )
+	{
+		fflush (ghLogFile);
+	}
+	else
+	{
+		LogWriterWaitFlushed ();
+	}
+
+	LeaveCriticalSection (&LogProducerLock);
+}
+
+/*
+*******************************************************************************
+** LogWriterWaitFlushed - Function to have the writer thread write and fflush
+**                        everything queued so far (LogProducerLock held)
+*******************************************************************************
+*/
+static void LogWriterWaitFlushed (void)
+{
+	LONG Req;
+
+	Req = InterlockedIncrement (&lLogFlushReq);
+	SetEvent (hLogWakeEvent);
+
+	while ( (lLogFlushDone - Req) < 0 )
+	{
+		/* don't wait forever if the thread is gone */
+		if ( WaitForSingleObject (hLogThread, 0) == WAIT_OBJECT_0 )
+		{
+			break;
+		}
+		WaitForSingleObject (hLogFlushedEvent, LOG_FLUSH_INTERVAL_MSECS);
+	}
+}
+
+/*
+*******************************************************************************
+** LogWriterProc - Log file writer thread
+*******************************************************************************
+*/
+static DWORD WINAPI LogWriterProc (LPVOID pParam)
+{
+	LONG          FlushReq;
+	LONG          Head;
+	LONG          Tail;
+	unsigned long Chunk;
+	BOOL          fWritten;
+
+	for (;;)
+	{
+		WaitForSingleObject (hLogWakeEvent, LOG_FLUSH_INTERVAL_MSECS);
+
+		/* read the request first, everything queued before it is in the ring */
+		FlushReq = lLogFlushReq;
+		Head     = lLogHead;
+		Tail     = lLogTail;
+		fWritten = FALSE;
+
+		while ( Tail != Head )
+		{
+			Chunk = LOG_RING_SIZE - (Tail & (LOG_RING_SIZE - 1));
+			Chunk = min (Chunk, (unsigned long)(Head - Tail));
+			if ( ghLogFile != NULL )
+			{
+				fwrite (&LogRing[Tail & (LOG_RING_SIZE - 1)], 1, Chunk, ghLogFile);
+				fWritten = TRUE;
+			}
+			Tail += (LONG)Chunk;
+
+			/* hand the space back to the producers */
+			InterlockedExchange (&lLogTail, Tail);
+		}
+
+		if ( fWritten == TRUE )
+		{
+			fflush (ghLogFile);
+		}
+
+		if ( FlushReq != lLogFlushDone )
+		{
+			InterlockedExchange (&lLogFlushDone, FlushReq);
+			SetEvent (hLogFlushedEvent);
+		}
+
+		if ( lLogExit == TRUE && lLogTail == lLogHead )
+		{
+			break;
+		}
+	}
+
+	return 0;
+}
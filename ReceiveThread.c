@@ -0,0 +1,399 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Optional receive thread.
+**
+** The thread drains PassThruReadMsgs into a single-producer / single-consumer
+** ring of PASSTHRU_MSG slots, so frame pickup is not delayed by the logging
+** and parsing done in SidRequest.  The thread only writes lRxHead and the
+** slot it is filling, SidRequest only writes lRxTail.
+**
+** The thread runs only while SidRequest is waiting for responses, and it is
+** paused (not inside PassThruReadMsgs) before a request is sent.  The J2534
+** DLL must still allow PassThruIoctl calls (tester present) from the main
+** thread during a read.
+**
+** If the thread does not pause in time it is stuck in a J2534 call and may
+** still fill a slot, so the ring is left alone and the thread is abandoned:
+** it exits once the call returns, and SidRequest reads directly from then on.
+*/
+#define RX_RING_SIZE              32      /* must be a power of 2 */
+#define RX_THREAD_READ_TIMEOUT    5       /* msec, also the usual wait for the thread to pause */
+#define RX_THREAD_PAUSE_TIMEOUT   1000    /* msec, give up waiting for a stuck J2534 call */
+
+static RX_RING_SLOT   RxRing[RX_RING_SIZE];
+static LONG volatile  lRxHead          = 0;     /* next slot to fill (receive thread) */
+static LONG volatile  lRxTail          = 0;     /* next slot to consume (SidRequest) */
+static LONG           lRxConsumed      = 0;     /* slots handed out by the last RxThreadRead */
+static LONG volatile  lRxRun           = FALSE;
+static LONG volatile  lRxExit          = FALSE;
+static LONG volatile  lRxError         = STATUS_NOERROR;
+static HANDLE         hRxThread        = NULL;
+static HANDLE         hRxRunEvent      = NULL;  /* auto-reset, wakes the paused thread */
+static HANDLE         hRxIdleEvent     = NULL;  /* manual-reset, set while the thread is paused */
+static HANDLE         hRxDataEvent     = NULL;  /* auto-reset, set when a slot is filled */
+static BOOL           bRxAbandoned     = FALSE; /* a stuck thread was left to exit on its own */
+
+static DWORD WINAPI RxThreadProc (LPVOID pParam);
+static void RxThreadAbandon (void);
+
+
+/*
+*******************************************************************************
+** RxThreadStart - Function to start the receive thread (paused)
+*******************************************************************************
+*/
+STATUS RxThreadStart (void)
+{
+	DWORD ThreadId;
+
+	/* A stuck thread may still use the ring and the events, keep reading directly */
+	if ( hRxThread != NULL || bRxAbandoned == TRUE )
+	{
+		return(PASS);
+	}
+
+	lRxHead  = 0;
+	lRxTail  = 0;
+	lRxConsumed = 0;
+	lRxRun   = FALSE;
+	lRxExit  = FALSE;
+	lRxError = STATUS_NOERROR;
+
+	hRxRunEvent  = CreateEvent (NULL, FALSE, FALSE, NULL);
+	hRxIdleEvent = CreateEvent (NULL, TRUE,  FALSE, NULL);
+	hRxDataEvent = CreateEvent (NULL, FALSE, FALSE, NULL);
+	if ( hRxRunEvent == NULL || hRxIdleEvent == NULL || hRxDataEvent == NULL )
+	{
+		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "Cannot create receive thread events\n" );
+		RxThreadStop ();
+		return(FAIL);
+	}
+
+	hRxThread = CreateThread (NULL, 0, RxThreadProc, NULL, 0, &ThreadId);
+	if ( hRxThread == NULL )
+	{
+		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+		     "Cannot create receive thread\n" );
+		RxThreadStop ();
+		return(FAIL);
+	}
+
+	/* wait for the thread to reach its paused state */
+	WaitForSingleObject (hRxIdleEvent, RX_THREAD_PAUSE_TIMEOUT);
+
+	return(PASS);
+}
+
+/*
+*******************************************************************************
+** RxThreadStop - Function to stop the receive thread
+*******************************************************************************
+*/
+void RxThreadStop (void)
+{
+	if ( hRxThread != NULL )
+	{
+		InterlockedExchange (&lRxExit, TRUE);
+		InterlockedExchange (&lRxRun, FALSE);
+		SetEvent (hRxRunEvent);
+		if ( WaitForSingleObject (hRxThread, RX_THREAD_PAUSE_TIMEOUT) != WAIT_OBJECT_0 )
+		{
+			RxThreadAbandon ();
+			return;
+		}
+		CloseHandle (hRxThread);
+		hRxThread = NULL;
+	}
+
+	if ( bRxAbandoned == TRUE )
+	{
+		return;
+	}
+
+	if ( hRxRunEvent != NULL )
+	{
+		CloseHandle (hRxRunEvent);
+		hRxRunEvent = NULL;
+	}
+	if ( hRxIdleEvent != NULL )
+	{
+		CloseHandle (hRxIdleEvent);
+		hRxIdleEvent = NULL;
+	}
+	if ( hRxDataEvent != NULL )
+	{
+		CloseHandle (hRxDataEvent);
+		hRxDataEvent = NULL;
+	}
+}
+
+/*
+*******************************************************************************
+** RxThreadIsRunning - Function to check if the receive thread is available
+*******************************************************************************
+*/
+BOOL RxThreadIsRunning (void)
+{
+	return ( hRxThread != NULL ) ? TRUE : FALSE;
+}
+
+/*
+*******************************************************************************
+** RxThreadAbandon - Function to give up on a receive thread stuck in a
+**                   J2534 call.  It exits when the call returns; its events
+**                   are never closed since it may still set them.
+*******************************************************************************
+*/
+static void RxThreadAbandon (void)
+{
+	InterlockedExchange (&lRxExit, TRUE);
+	InterlockedExchange (&lRxRun, FALSE);
+	SetEvent (hRxRunEvent);
+
+	CloseHandle (hRxThread);
+	hRxThread    = NULL;
+	bRxAbandoned = TRUE;
+
+	Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+	     "Receive thread did not stop within %d msec, reading responses directly\n",
+	     RX_THREAD_PAUSE_TIMEOUT );
+}
+
+/*
+*******************************************************************************
+** RxThreadPause - Function to stop the receive thread reading and discard
+**                 anything it has read but SidRequest has not consumed.
+**                 Abandons the thread if it does not pause in time, so check
+**                 RxThreadIsRunning afterwards.
+*******************************************************************************
+*/
+void RxThreadPause (void)
+{
+	if ( hRxThread == NULL )
+	{
+		return;
+	}
+
+	InterlockedExchange (&lRxRun, FALSE);
+	if ( WaitForSingleObject (hRxIdleEvent, RX_THREAD_PAUSE_TIMEOUT) != WAIT_OBJECT_0 )
+	{
+		/* still inside PassThruReadMsgs, it may yet fill a slot */
+		RxThreadAbandon ();
+		return;
+	}
+
+	/* The thread is parked, the consumer owns both ends of the ring */
+	lRxConsumed = 0;
+	InterlockedExchange (&lRxTail, lRxHead);
+	InterlockedExchange (&lRxError, STATUS_NOERROR);
+}
+
+/*
+*******************************************************************************
+** RxThreadRequestPause - Function to ask the receive thread to stop reading
+**                        without waiting for it.  RxThreadPause waits for it
+**                        before the next request touches the ring.
+*******************************************************************************
+*/
+void RxThreadRequestPause (void)
+{
+	if ( hRxThread != NULL )
+	{
+		InterlockedExchange (&lRxRun, FALSE);
+	}
+}
+
+/*
+*******************************************************************************
+** RxThreadResume - Function to let the receive thread read again
+*******************************************************************************
+*/
+void RxThreadResume (void)
+{
+	if ( hRxThread != NULL )
+	{
+		InterlockedExchange (&lRxRun, TRUE);
+		SetEvent (hRxRunEvent);
+	}
+}
+
+/*
+*******************************************************************************
+** RxThreadRead - Function to get the received messages from the ring
+**
+** Works like PassThruReadMsgs, but returns pointers to the ring slots
+** instead of copying the messages.  The slots stay valid until
+** RxThreadRelease is called.
+*******************************************************************************
+*/
+long RxThreadRead (RX_RING_SLOT *pSlotList[], unsigned long *pNumMsgs, unsigned long TimeoutMsecs)
+{
+	unsigned long MaxMsgs;
+	unsigned long StartTimeMsecs;
+	unsigned long ElapsedMsecs;
+	LONG          Available;
+	LONG          Index;
+	long          RetVal;
+
+	MaxMsgs   = *pNumMsgs;
+	*pNumMsgs = 0;
+
+	RxThreadRelease ();
+
+	Available = lRxHead - lRxTail;
+	if ( Available == 0 && TimeoutMsecs != 0 )
+	{
+		StartTimeMsecs = GetTickCount ();
+		ElapsedMsecs   = 0;
+		do
+		{
+			WaitForSingleObject (hRxDataEvent, TimeoutMsecs - ElapsedMsecs);
+			Available    = lRxHead - lRxTail;
+			ElapsedMsecs = GetTickCount () - StartTimeMsecs;
+		}
+		while ( Available == 0 &&
+		        lRxError == STATUS_NOERROR &&
+		        ElapsedMsecs < TimeoutMsecs );
+	}
+
+	if ( Available == 0 )
+	{
+		RetVal = InterlockedExchange (&lRxError, STATUS_NOERROR);
+		return ( RetVal != STATUS_NOERROR ) ? RetVal : ERR_BUFFER_EMPTY;
+	}
+
+	for ( Index = 0; Index < Available && (unsigned long)Index < MaxMsgs; Index++ )
+	{
+		pSlotList[Index] = &RxRing[(lRxTail + Index) & (RX_RING_SIZE - 1)];
+	}
+
+	lRxConsumed = Index;
+	*pNumMsgs   = Index;
+
+	return STATUS_NOERROR;
+}
+
+/*
+*******************************************************************************
+** RxThreadRelease - Function to hand the slots from RxThreadRead back
+**                   to the receive thread
+*******************************************************************************
+*/
+void RxThreadRelease (void)
+{
+	if ( lRxConsumed != 0 )
+	{
+		InterlockedExchange (&lRxTail, lRxTail + lRxConsumed);
+		lRxConsumed = 0;
+	}
+}
+
+/*
+*******************************************************************************
+** RxThreadProc - Receive thread
+*******************************************************************************
+*/
+static DWORD WINAPI RxThreadProc (LPVOID pParam)
+{
+	RX_RING_SLOT *pSlot;
+	unsigned long NumMsgs;
+	long          RetVal;
+	LONG          Head;
+
+	while ( lRxExit == FALSE )
+	{
+		/* Park until SidRequest is waiting for responses */
+		if ( lRxRun == FALSE )
+		{
+			SetEvent (hRxIdleEvent);
+			WaitForSingleObject (hRxRunEvent, INFINITE);
+			ResetEvent (hRxIdleEvent);
+			continue;
+		}
+
+		/* Ring full, let SidRequest catch up */
+		Head = lRxHead;
+		if ( (Head - lRxTail) >= RX_RING_SIZE )
+		{
+			Sleep (1);
+			continue;
+		}
+
+		/* Read straight into the next free slot */
+		pSlot   = &RxRing[Head & (RX_RING_SIZE - 1)];
+		NumMsgs = 1;
+		RetVal  = PassThruReadMsgs (gOBDList[gOBDListIndex].ChannelID,
+		                            &pSlot->Msg,
+		                            &NumMsgs,
+		                            RX_THREAD_READ_TIMEOUT);
+
+		if ( NumMsgs == 1 )
+		{
+			/* no host read time if the counter is not available */
+			if ( QueryPerformanceCounter (&pSlot->HostTime) == 0 )
+			{
+				pSlot->HostTime.QuadPart = 0;
+			}
+			pSlot->ReadTimeMsecs = GetTickCount ();
+
+			/* publish the slot */
+			InterlockedExchange (&lRxHead, Head + 1);
+			SetEvent (hRxDataEvent);
+		}
+		else if ( (RetVal != STATUS_NOERROR) &&
+		          (RetVal != ERR_BUFFER_EMPTY) &&
+		          (RetVal != ERR_TIMEOUT) &&
+		          (RetVal != ERR_NO_FLOW_CONTROL) )
+		{
+			/* report the error to SidRequest */
+			InterlockedExchange (&lRxError, RetVal);
+			SetEvent (hRxDataEvent);
+			Sleep (1);
+		}
+	}
+
+	SetEvent (hRxIdleEvent);
+	return 0;
+}
@@ -0,0 +1,198 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** The last bus activity is kept in host time, in microseconds modulo 2^32
+** (GetTickCount() * 1000).  Interface timestamps are mapped into host time
+** with an offset estimated from the messages read during the current request.
+*/
+static BOOL          bBusActivityValid     = FALSE;
+static unsigned long ulLastBusActivityUsecs = 0;    /* host time of the last frame on the bus */
+static BOOL          bClockOffsetValid     = FALSE;
+static unsigned long ulClockOffsetUsecs    = 0;     /* host time - interface time */
+
+static unsigned long ulSectionPacedRequests = 0;    /* requests paced in this test subsection */
+static unsigned long ulSectionAvoidedMsecs  = 0;    /* sleep avoided in this test subsection */
+
+
+/*
+*******************************************************************************
+** PacingStartRequest - Function to start a new interface clock estimate
+*******************************************************************************
+*/
+void PacingStartRequest (void)
+{
+	/* The interface and host clocks drift, only trust samples from this request */
+	bClockOffsetValid = FALSE;
+}
+
+/*
+*******************************************************************************
+** PacingNoteBusActivity - Function to note bus activity at a host time
+*******************************************************************************
+*/
+void PacingNoteBusActivity (unsigned long HostMsecs)
+{
+	unsigned long ActivityUsecs;
+
+	ActivityUsecs = HostMsecs * 1000;
+
+	if ( bBusActivityValid == FALSE ||
+	     (long)(ActivityUsecs - ulLastBusActivityUsecs) > 0 )
+	{
+		ulLastBusActivityUsecs = ActivityUsecs;
+		bBusActivityValid = TRUE;
+	}
+}
+
+/*
+*******************************************************************************
+** PacingNoteRxMsg - Function to note a message read from the interface
+**
+** ReadTimeMsecs is the host time the message was returned by PassThruReadMsgs.
+** The smallest (host - interface) difference seen in a request is the best
+** estimate of the clock offset, since that message was read with the least delay.
+*******************************************************************************
+*/
+void PacingNoteRxMsg (PASSTHRU_MSG *pMsg, unsigned long ReadTimeMsecs)
+{
+	unsigned long SampleUsecs;
+	unsigned long ActivityUsecs;
+
+	/* Interface did not timestamp the message, the read time is all we have */
+	if ( pMsg->Timestamp == 0 )
+	{
+		PacingNoteBusActivity (ReadTimeMsecs);
+		return;
+	}
+
+	SampleUsecs = (ReadTimeMsecs * 1000) - pMsg->Timestamp;
+	if ( bClockOffsetValid == FALSE ||
+	     (long)(SampleUsecs - ulClockOffsetUsecs) < 0 )
+	{
+		ulClockOffsetUsecs = SampleUsecs;
+		bClockOffsetValid = TRUE;
+	}
+
+	ActivityUsecs = pMsg->Timestamp + ulClockOffsetUsecs;
+	if ( bBusActivityValid == FALSE ||
+	     (long)(ActivityUsecs - ulLastBusActivityUsecs) > 0 )
+	{
+		ulLastBusActivityUsecs = ActivityUsecs;
+		bBusActivityValid = TRUE;
+	}
+}
+
+/*
+*******************************************************************************
+** PacingWaitForRequest - Function to wait until a request may be sent
+**
+** Sleeps only for the part of gOBDRequestDelay (the minimum request spacing
+** for the current protocol) that the bus has not already been idle.
+*******************************************************************************
+*/
+void PacingWaitForRequest (void)
+{
+	long IdleUsecs;
+	unsigned long SleepMsecs;
+
+	SleepMsecs = gOBDRequestDelay;
+
+	if ( bBusActivityValid == TRUE )
+	{
+		IdleUsecs = (long)((GetTickCount () * 1000) - ulLastBusActivityUsecs);
+		if ( IdleUsecs < 0 )
+		{
+			IdleUsecs = 0;
+		}
+
+		if ( (unsigned long)IdleUsecs >= gOBDRequestDelay * 1000 )
+		{
+			SleepMsecs = 0;
+		}
+		else
+		{
+			/* round up to whole milliseconds */
+			SleepMsecs = ((gOBDRequestDelay * 1000) - IdleUsecs + 999) / 1000;
+		}
+	}
+
+	if ( SleepMsecs != 0 )
+	{
+		Sleep (SleepMsecs);
+	}
+
+	ulSectionPacedRequests++;
+	ulSectionAvoidedMsecs += gOBDRequestDelay - SleepMsecs;
+}
+
+/*
+*******************************************************************************
+** PacingReset - Function to forget the bus activity (new connection)
+*******************************************************************************
+*/
+void PacingReset (void)
+{
+	bBusActivityValid = FALSE;
+	bClockOffsetValid = FALSE;
+}
+
+/*
+*******************************************************************************
+** LogPacingStats - Function to log the request pacing statistics
+**                  for the current test subsection
+*******************************************************************************
+*/
+void LogPacingStats (void)
+{
+	if ( ulSectionPacedRequests != 0 )
+	{
+		Log( INFORMATION, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "Request pacing avoided %lumsec of %lumsec request delay (%lu requests)\n",
+		     ulSectionAvoidedMsecs,
+		     ulSectionPacedRequests * gOBDRequestDelay,
+		     ulSectionPacedRequests );
+	}
+
+	ulSectionPacedRequests = 0;
+	ulSectionAvoidedMsecs  = 0;
+}
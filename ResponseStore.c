@@ -0,0 +1,299 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** The SID response data of each ECU is kept in blocks carved from a few
+** large chunks instead of fixed OBD_MAX_SID_DATA_SIZE arrays.  A block is
+** the next power of 2 that holds the data and is replaced by a larger one
+** when the data outgrows it.  Outgrown blocks go on a free list for their
+** size and are reused, nothing is given back until the program exits.
+** The bytes of a block past the data size are kept zero, so callers that
+** still index the data through SidDataPtr read zero past the end of a
+** response, as they did with the old arrays.
+*/
+#define SID_DATA_MIN_BLOCK      64                      /* smallest block */
+#define SID_DATA_NUM_CLASSES    6                       /* 64 to 2048 byte blocks */
+#define SID_DATA_CHUNK_SIZE     (8 * OBD_MAX_SID_DATA_SIZE)
+
+typedef struct SID_DATA_FREE
+{
+	struct SID_DATA_FREE *pNext;
+} SID_DATA_FREE;
+
+static unsigned char *pStoreChunk     = NULL;           /* chunk blocks are carved from */
+static unsigned long  ulStoreChunkUsed = SID_DATA_CHUNK_SIZE;
+static SID_DATA_FREE *pStoreFree[SID_DATA_NUM_CLASSES]; /* outgrown blocks by size */
+
+/* returned for SIDs without response data, reads as all zero like the old arrays */
+static unsigned char  StoreZeroData[OBD_MAX_SID_DATA_SIZE];
+
+/* SID_DATA members of OBD_DATA, for CopyOBDResponse */
+static const size_t SidDataOffset[] =
+{
+	offsetof (OBD_DATA, Sid2Pid),
+	offsetof (OBD_DATA, Sid3),
+	offsetof (OBD_DATA, Sid5Tid),
+	offsetof (OBD_DATA, Sid6Mid),
+	offsetof (OBD_DATA, Sid7),
+	offsetof (OBD_DATA, Sid8Tid),
+	offsetof (OBD_DATA, Sid9Inf),
+	offsetof (OBD_DATA, SidA)
+};
+#define SID_DATA_NUM_MEMBERS    (sizeof(SidDataOffset) / sizeof(SidDataOffset[0]))
+#define SID_DATA_MEMBER(pObd, Member) ((SID_DATA *)((unsigned char *)(pObd) + SidDataOffset[Member]))
+
+
+/*
+*******************************************************************************
+** SidDataReserve - Function to make room for NumBytes of SID response data
+*******************************************************************************
+*/
+static STATUS SidDataReserve (SID_DATA *pSidData, unsigned long NumBytes)
+{
+	unsigned long  BlockSize;
+	unsigned long  Class;
+	unsigned char *pBlock;
+
+	if ( NumBytes <= pSidData->Capacity )
+	{
+		return PASS;
+	}
+
+	if ( NumBytes > OBD_MAX_SID_DATA_SIZE )
+	{
+		return FAIL;
+	}
+
+	/* Find the size class of the block */
+	for ( BlockSize = SID_DATA_MIN_BLOCK, Class = 0; BlockSize < NumBytes; BlockSize <<= 1, Class++ )
+	{
+	}
+
+	if ( pStoreFree[Class] != NULL )
+	{
+		pBlock = (unsigned char *)pStoreFree[Class];
+		pStoreFree[Class] = pStoreFree[Class]->pNext;
+	}
+	else
+	{
+		if ( ulStoreChunkUsed + BlockSize > SID_DATA_CHUNK_SIZE )
+		{
+			/* the end of the last chunk is left unused */
+			pStoreChunk = (unsigned char *)malloc (SID_DATA_CHUNK_SIZE);
+			if ( pStoreChunk == NULL )
+			{
+				ulStoreChunkUsed = SID_DATA_CHUNK_SIZE;
+				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "Cannot allocate memory for SID response data\n" );
+				return FAIL;
+			}
+			ulStoreChunkUsed = 0;
+		}
+		pBlock = &pStoreChunk[ulStoreChunkUsed];
+		ulStoreChunkUsed += BlockSize;
+	}
+
+	/* Move the data to the new block and free the old one */
+	memset (pBlock, 0, BlockSize);
+	if ( pSidData->pData != NULL )
+	{
+		memcpy (pBlock, pSidData->pData, pSidData->Size);
+
+		for ( Class = 0; (unsigned long)(SID_DATA_MIN_BLOCK << Class) < pSidData->Capacity; Class++ )
+		{
+		}
+		((SID_DATA_FREE *)pSidData->pData)->pNext = pStoreFree[Class];
+		pStoreFree[Class] = (SID_DATA_FREE *)pSidData->pData;
+	}
+
+	pSidData->pData    = pBlock;
+	pSidData->Capacity = (unsigned short)BlockSize;
+
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** SidDataReset - Function to clear SID response data
+*******************************************************************************
+*/
+void SidDataReset (SID_DATA *pSidData)
+{
+	if ( pSidData->pData != NULL )
+	{
+		memset (pSidData->pData, 0, pSidData->Size);
+	}
+	pSidData->Size = 0;
+}
+
+/*
+*******************************************************************************
+** SidDataSet - Function to replace SID response data
+**
+** If pSrc is NULL the data is set to NumBytes of zero.
+*******************************************************************************
+*/
+STATUS SidDataSet (SID_DATA *pSidData, const unsigned char *pSrc, unsigned long NumBytes)
+{
+	unsigned long OldSize;
+
+	OldSize = pSidData->Size;
+	pSidData->Size = 0;
+	if ( SidDataAppend (pSidData, pSrc, NumBytes) != PASS )
+	{
+		/* the block is unchanged, clear the earlier data left in it */
+		pSidData->Size = (unsigned short)OldSize;
+		SidDataReset (pSidData);
+		return FAIL;
+	}
+
+	/* clear the rest of the earlier, longer data */
+	if ( OldSize > NumBytes )
+	{
+		memset (&pSidData->pData[NumBytes], 0, OldSize - NumBytes);
+	}
+
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** SidDataAppend - Function to add to SID response data
+**
+** If pSrc is NULL, NumBytes of zero are added.
+*******************************************************************************
+*/
+STATUS SidDataAppend (SID_DATA *pSidData, const unsigned char *pSrc, unsigned long NumBytes)
+{
+	if ( SidDataReserve (pSidData, pSidData->Size + NumBytes) != PASS )
+	{
+		return FAIL;
+	}
+
+	if ( NumBytes != 0 )
+	{
+		if ( pSrc != NULL )
+		{
+			memcpy (&pSidData->pData[pSidData->Size], pSrc, NumBytes);
+		}
+		else
+		{
+			memset (&pSidData->pData[pSidData->Size], 0, NumBytes);
+		}
+	}
+	pSidData->Size += (unsigned short)NumBytes;
+
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** SidDataPtr - Function to get a pointer to SID response data
+**
+** The data is valid up to the next SidDataSet/SidDataAppend.
+*******************************************************************************
+*/
+unsigned char *SidDataPtr (SID_DATA *pSidData)
+{
+	if ( pSidData->pData == NULL )
+	{
+		return StoreZeroData;
+	}
+	return pSidData->pData;
+}
+
+/*
+*******************************************************************************
+** SidDataByte - Function to get a byte of SID response data, zero past the
+**               end of the data
+*******************************************************************************
+*/
+unsigned char SidDataByte (SID_DATA *pSidData, unsigned long Index)
+{
+	if ( Index >= pSidData->Size )
+	{
+		return 0;
+	}
+	return pSidData->pData[Index];
+}
+
+/*
+*******************************************************************************
+** CopyOBDResponse - Function to copy the response data of all ECUs
+**                   (e.g. gOBDResponse to gOBDCompareResponse)
+**
+** The destination keeps its own response data blocks.
+*******************************************************************************
+*/
+void CopyOBDResponse (OBD_DATA *pDest, OBD_DATA *pSrc)
+{
+	SID_DATA      DestData[SID_DATA_NUM_MEMBERS];
+	unsigned long EcuIndex;
+	unsigned long Member;
+
+	for ( EcuIndex = 0; EcuIndex < gOBDEcuCapacity; EcuIndex++ )
+	{
+		for ( Member = 0; Member < SID_DATA_NUM_MEMBERS; Member++ )
+		{
+			DestData[Member] = *SID_DATA_MEMBER (&pDest[EcuIndex], Member);
+		}
+
+		memcpy (&pDest[EcuIndex], &pSrc[EcuIndex], sizeof(OBD_DATA));
+
+		for ( Member = 0; Member < SID_DATA_NUM_MEMBERS; Member++ )
+		{
+			*SID_DATA_MEMBER (&pDest[EcuIndex], Member) = DestData[Member];
+			SidDataSet (SID_DATA_MEMBER (&pDest[EcuIndex], Member),
+			            SID_DATA_MEMBER (&pSrc[EcuIndex], Member)->pData,
+			            SID_DATA_MEMBER (&pSrc[EcuIndex], Member)->Size);
+		}
+	}
+
+	/* the support and decoded data of gOBDResponse may have been restored */
+	if ( pDest == gOBDResponse )
+	{
+		SupportMapInvalidateAll ();
+		SampleCacheRebuild ();
+	}
+}
@@ -0,0 +1,500 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Response times are measured between the interface timestamp of the echoed
+** request (or, for the legacy protocols, of the previous response) and the
+** interface timestamp of the response.  Until such a reference is seen in a
+** request, or if the interface does not timestamp its messages, the host
+** clock is used instead: the time PassThruWriteMsgs returned to the time the
+** response was read.  Host times are in microseconds modulo 2^32.  A message
+** without a host read time (no QueryPerformanceCounter value for it) is not
+** host timed, its response time is left out of the statistics.
+*/
+static BOOL          bHostClockInit       = FALSE;
+static BOOL          bHostClockQPC        = FALSE;    /* QueryPerformanceCounter available */
+static LONGLONG      llHostClockFreq      = 0;
+
+static BOOL          bTxReferenceValid    = FALSE;    /* interface reference timestamp seen */
+static unsigned long ulTxHostUsecs        = 0;        /* host time the request was sent */
+static unsigned long ulRxHostUsecs        = 0;        /* host time the current message was read */
+static BOOL          bRxHostValid         = FALSE;    /* ulRxHostUsecs is known */
+static BOOL          bResponseTimed       = FALSE;    /* last response time is a valid sample */
+
+static unsigned long ulSectionEchoTimed   = 0;        /* responses timed with interface timestamps */
+static unsigned long ulSectionHostTimed   = 0;        /* responses timed with the host clock */
+static unsigned long ulSectionUntimed     = 0;        /* responses without a reference or host time */
+
+static unsigned long ulSectionMultiFrames = 0;        /* segmented responses timed */
+static unsigned long ulSectionMultiBytes  = 0;        /* bytes in the segmented responses */
+static unsigned long ulSectionMultiUsecs  = 0;        /* total FirstFrame to final frame time */
+static unsigned long ulSectionMultiMax    = 0;        /* longest FirstFrame to final frame time */
+
+
+/*
+*******************************************************************************
+** HostCountToUsecs - Function to convert a performance counter value
+**                    to microseconds
+*******************************************************************************
+*/
+static unsigned long HostCountToUsecs (LONGLONG Count)
+{
+	LONGLONG Secs;
+	LONGLONG Rem;
+
+	/* split to avoid overflowing Count * 1000000 */
+	Secs = Count / llHostClockFreq;
+	Rem  = Count % llHostClockFreq;
+
+	return (unsigned long)( (Secs * 1000000) + ((Rem * 1000000) / llHostClockFreq) );
+}
+
+/*
+*******************************************************************************
+** HostClockInit - Function to select the host clock
+*******************************************************************************
+*/
+static void HostClockInit (void)
+{
+	LARGE_INTEGER Freq;
+
+	if ( bHostClockInit == TRUE )
+	{
+		return;
+	}
+
+	bHostClockInit = TRUE;
+	if ( QueryPerformanceFrequency (&Freq) != 0 && Freq.QuadPart != 0 )
+	{
+		llHostClockFreq = Freq.QuadPart;
+		bHostClockQPC   = TRUE;
+	}
+}
+
+/*
+*******************************************************************************
+** GetHostUsecs - Function to get the high resolution host time
+*******************************************************************************
+*/
+unsigned long GetHostUsecs (void)
+{
+	LARGE_INTEGER Count;
+
+	HostClockInit ();
+
+	if ( bHostClockQPC == TRUE && QueryPerformanceCounter (&Count) != 0 )
+	{
+		return HostCountToUsecs (Count.QuadPart);
+	}
+
+	return GetTickCount () * 1000;
+}
+
+/*
+*******************************************************************************
+** HostTimeToUsecs - Function to convert a QueryPerformanceCounter value
+**                   saved earlier to host time
+**
+** Returns FALSE if there is no QueryPerformanceCounter value to convert
+** (no high resolution host clock, or the counter was not read), the host
+** time the value was saved at is then unknown.
+*******************************************************************************
+*/
+BOOL HostTimeToUsecs (LARGE_INTEGER *pHostTime, unsigned long *pHostUsecs)
+{
+	HostClockInit ();
+
+	if ( bHostClockQPC == FALSE || pHostTime->QuadPart == 0 )
+	{
+		return FALSE;
+	}
+
+	*pHostUsecs = HostCountToUsecs (pHostTime->QuadPart);
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+** TimingStartRequest - Function to note that a request was just sent
+*******************************************************************************
+*/
+void TimingStartRequest (void)
+{
+	bTxReferenceValid = FALSE;
+	ulTxHostUsecs     = GetHostUsecs ();
+	ulRxHostUsecs     = ulTxHostUsecs;
+	bRxHostValid      = TRUE;
+}
+
+/*
+*******************************************************************************
+** TimingSetReference - Function to note that the interface timestamp
+**                      response times are measured from is now valid
+**
+** The host time of the message being processed becomes the host clock
+** reference too (if it is known), so both clocks measure from the same
+** message.
+*******************************************************************************
+*/
+void TimingSetReference (void)
+{
+	bTxReferenceValid = TRUE;
+	if ( bRxHostValid == TRUE )
+	{
+		ulTxHostUsecs = ulRxHostUsecs;
+	}
+}
+
+/*
+*******************************************************************************
+** TimingNoteRxHostUsecs - Function to set the host time the message
+**                         being processed was read
+*******************************************************************************
+*/
+void TimingNoteRxHostUsecs (unsigned long HostUsecs)
+{
+	ulRxHostUsecs = HostUsecs;
+	bRxHostValid  = TRUE;
+}
+
+/*
+*******************************************************************************
+** TimingNoteRxHostUnknown - Function to note that the host time the
+**                           message being processed was read is unknown
+*******************************************************************************
+*/
+void TimingNoteRxHostUnknown (void)
+{
+	bRxHostValid = FALSE;
+}
+
+/*
+*******************************************************************************
+** TimingRxHostUsecs - Function to get the host time the message
+**                     being processed was read
+**
+** Returns FALSE if the host time is unknown.
+*******************************************************************************
+*/
+BOOL TimingRxHostUsecs (unsigned long *pHostUsecs)
+{
+	if ( bRxHostValid == FALSE )
+	{
+		return FALSE;
+	}
+
+	*pHostUsecs = ulRxHostUsecs;
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+** TimingResponseUsecs - Function to get a response time in microseconds
+**
+** RxTimestamp and TxTimestamp are interface timestamps.  They are only used
+** if the reference was seen and the interface timestamps its messages.  If
+** the host time of the response is unknown too, the response time is the
+** interface timestamp difference and is not recorded by RespTimeHistRecord.
+*******************************************************************************
+*/
+unsigned long TimingResponseUsecs (unsigned long RxTimestamp, unsigned long TxTimestamp)
+{
+	if ( bTxReferenceValid == TRUE && RxTimestamp != 0 )
+	{
+		ulSectionEchoTimed++;
+		bResponseTimed = TRUE;
+		return RxTimestamp - TxTimestamp;
+	}
+
+	if ( bRxHostValid == TRUE )
+	{
+		ulSectionHostTimed++;
+		bResponseTimed = TRUE;
+		return ulRxHostUsecs - ulTxHostUsecs;
+	}
+
+	ulSectionUntimed++;
+	bResponseTimed = FALSE;
+	return RxTimestamp - TxTimestamp;
+}
+
+/*
+*******************************************************************************
+** LogTimingStats - Function to log the clock used for the response times
+**                  in the current test subsection
+*******************************************************************************
+*/
+void LogTimingStats (void)
+{
+	if ( ulSectionEchoTimed != 0 || ulSectionHostTimed != 0 || ulSectionUntimed != 0 )
+	{
+		HostClockInit ();
+
+		Log( INFORMATION, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "Response times: %lu from interface timestamps, %lu from host clock (%s), %lu without a host read time\n",
+		     ulSectionEchoTimed,
+		     ulSectionHostTimed,
+		     bHostClockQPC == TRUE ? "QueryPerformanceCounter" : "GetTickCount",
+		     ulSectionUntimed );
+	}
+
+	ulSectionEchoTimed = 0;
+	ulSectionHostTimed = 0;
+	ulSectionUntimed   = 0;
+}
+
+/*
+*******************************************************************************
+** MultiFrameRecord - Function to record the time an ISO15765 segmented
+**                    response took from FirstFrame indication to final frame
+*******************************************************************************
+*/
+void MultiFrameRecord (unsigned long EcuId, unsigned long NumBytes, unsigned long TransferUsecs)
+{
+	double dBytesPerSec = 0.0;
+
+	if ( TransferUsecs != 0 )
+	{
+		dBytesPerSec = ((double)NumBytes * 1000000.0) / TransferUsecs;
+	}
+
+	Log( INFORMATION, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+	     "ECU %X  Segmented response (%lu bytes) transferred in %lu.%03lu msec (%.0f bytes/sec)\n",
+	     EcuId, NumBytes, TransferUsecs / 1000, TransferUsecs % 1000, dBytesPerSec );
+
+	ulSectionMultiFrames++;
+	ulSectionMultiBytes += NumBytes;
+	ulSectionMultiUsecs += TransferUsecs;
+	if ( TransferUsecs > ulSectionMultiMax )
+	{
+		ulSectionMultiMax = TransferUsecs;
+	}
+}
+
+/*
+*******************************************************************************
+** LogMultiFrameStats - Function to log the segmented response transfer
+**                      times for the current test subsection
+*******************************************************************************
+*/
+void LogMultiFrameStats (void)
+{
+	unsigned long ulAverageUsecs;
+
+	if ( ulSectionMultiFrames != 0 )
+	{
+		ulAverageUsecs = ulSectionMultiUsecs / ulSectionMultiFrames;
+
+		Log( INFORMATION, SCREENOUTPUTOFF, LOGOUTPUTON, NO_PROMPT,
+		     "Segmented responses: %lu (%lu bytes), average %lu.%03lu msec, longest %lu.%03lu msec\n",
+		     ulSectionMultiFrames,
+		     ulSectionMultiBytes,
+		     ulAverageUsecs / 1000, ulAverageUsecs % 1000,
+		     ulSectionMultiMax / 1000, ulSectionMultiMax % 1000 );
+	}
+
+	ulSectionMultiFrames  = 0;
+	ulSectionMultiBytes   = 0;
+	ulSectionMultiUsecs   = 0;
+	ulSectionMultiMax     = 0;
+}
+
+/*
+*******************************************************************************
+** RespTimeHistIndex - Function to get the histogram bucket for a response time
+*******************************************************************************
+*/
+static unsigned long RespTimeHistIndex (unsigned long Usecs)
+{
+	unsigned long Msb;
+
+	if ( Usecs < RESP_HIST_LINEAR )
+	{
+		return Usecs;
+	}
+
+	/* RESP_HIST_LINEAR is 2^4, so the top bit is at least bit 4 */
+	Msb = 4;
+	while ( (Usecs >> (Msb + 1)) != 0 )
+	{
+		Msb++;
+	}
+
+	if ( Msb - 4 >= RESP_HIST_POWERS )
+	{
+		return RESP_HIST_BUCKETS - 1;
+	}
+
+	/* the 3 bits below the top bit select the sub-bucket */
+	return RESP_HIST_LINEAR +
+	       ((Msb - 4) * RESP_HIST_SUB_BUCKETS) +
+	       ((Usecs >> (Msb - 3)) & (RESP_HIST_SUB_BUCKETS - 1));
+}
+
+/*
+*******************************************************************************
+** RespTimeHistValue - Function to get the response time a bucket stands for
+**                     (the middle of its range)
+*******************************************************************************
+*/
+static unsigned long RespTimeHistValue (unsigned long Index)
+{
+	unsigned long Power;
+	unsigned long Sub;
+
+	if ( Index < RESP_HIST_LINEAR )
+	{
+		return Index;
+	}
+
+	Power = ((Index - RESP_HIST_LINEAR) / RESP_HIST_SUB_BUCKETS) + 4;
+	Sub   = (Index - RESP_HIST_LINEAR) % RESP_HIST_SUB_BUCKETS;
+
+	return ((RESP_HIST_SUB_BUCKETS + Sub) << (Power - 3)) + ((1UL << (Power - 3)) / 2);
+}
+
+/*
+*******************************************************************************
+** RespTimeHistPercentile - Function to get a percentile (in hundredths
+**                          of a percent) of a response time histogram
+*******************************************************************************
+*/
+static unsigned long RespTimeHistPercentile (RESP_TIME_HIST *pHist, unsigned long Hundredths)
+{
+	unsigned long Target;
+	unsigned long Total;
+	unsigned long Index;
+
+	/* rank of the sample, rounded up */
+	Target = (unsigned long)( ( ((double)pHist->Count * Hundredths) + 9999 ) / 10000 );
+	if ( Target == 0 )
+	{
+		Target = 1;
+	}
+
+	Total = 0;
+	for ( Index = 0; Index < RESP_HIST_BUCKETS; Index++ )
+	{
+		Total += pHist->Bucket[Index];
+		if ( Total >= Target )
+		{
+			break;
+		}
+	}
+
+	if ( Index == RESP_HIST_BUCKETS )
+	{
+		Index = RESP_HIST_BUCKETS - 1;
+	}
+
+	return RespTimeHistValue (Index);
+}
+
+/*
+*******************************************************************************
+** RespTimeHistRecord - Function to add a response time to an ECU's histogram
+*******************************************************************************
+*/
+void RespTimeHistRecord (unsigned long EcuTimingIndex, unsigned char Sid, unsigned long ResponseUsecs)
+{
+	RESP_TIME_HIST *pHist;
+
+	/* no reference to time the response from */
+	if ( EcuTimingIndex >= gOBDEcuCapacity || bResponseTimed == FALSE )
+	{
+		return;
+	}
+
+	pHist = &gEcuTimingData[EcuTimingIndex].RespTimeHist[ (Sid < RESP_HIST_NUM_SIDS) ? Sid : 0 ];
+	pHist->Bucket[RespTimeHistIndex (ResponseUsecs)]++;
+	pHist->Count++;
+}
+
+/*
+*******************************************************************************
+** LogRespTimeHist - Function to log the response time percentiles of an ECU
+**                   by SID, and reset the histograms
+*******************************************************************************
+*/
+void LogRespTimeHist (unsigned long EcuTimingIndex)
+{
+	RESP_TIME_HIST *pHist;
+	unsigned long   Sid;
+	unsigned long   P50;
+	unsigned long   P90;
+	unsigned long   P99;
+	unsigned long   P999;
+
+	for ( Sid = 0; Sid < RESP_HIST_NUM_SIDS; Sid++ )
+	{
+		pHist = &gEcuTimingData[EcuTimingIndex].RespTimeHist[Sid];
+		if ( pHist->Count == 0 )
+		{
+			continue;
+		}
+
+		P50  = RespTimeHistPercentile (pHist, 5000);
+		P90  = RespTimeHistPercentile (pHist, 9000);
+		P99  = RespTimeHistPercentile (pHist, 9900);
+		P999 = RespTimeHistPercentile (pHist, 9990);
+
+		if ( Sid == 0 )
+		{
+			Log( RESULTS, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "     Other SIDs Response Time p50/p90/p99/p99.9 = %.1f/%.1f/%.1f/%.1fmsec (%lu responses)\n",
+			     P50 / 1000.0, P90 / 1000.0, P99 / 1000.0, P999 / 1000.0,
+			     pHist->Count );
+		}
+		else
+		{
+			Log( RESULTS, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "     SID $%02X Response Time p50/p90/p99/p99.9 = %.1f/%.1f/%.1f/%.1fmsec (%lu responses)\n",
+			     Sid,
+			     P50 / 1000.0, P90 / 1000.0, P99 / 1000.0, P999 / 1000.0,
+			     pHist->Count );
+		}
+	}
+
+	memset (gEcuTimingData[EcuTimingIndex].RespTimeHist, 0x00,
+	        sizeof (gEcuTimingData[EcuTimingIndex].RespTimeHist));
+}
@@ -0,0 +1,373 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Values decoded from the SID $1 and SID $9 IPT responses of each ECU.
+** SidSaveResponseData decodes a response once as it is saved and the
+** validators and drive cycle displays read the decoded values from here.
+** A value is valid from the time its response is saved until the PID (or
+** a SID $9 INF) is requested again, the same lifetime as the response data.
+**
+** Every saved SID $1 PID and IPT response also gets a 64 bit fingerprint, so
+** a polling loop can tell whether an ECU's data changed with one compare.
+** A fingerprint is kept when its PID is requested again and only replaced
+** by the next response, 0 means no response was saved.
+*/
+typedef struct
+{
+	BOOL           fValid;
+	unsigned long  TimeMsecs;
+	ULONGLONG      Fingerprint;
+	SID9IPT        Ipt;
+} IPT_SAMPLE;
+
+static DECODED_SAMPLE Sid1Sample[OBD_MAX_ECUS][SAMPLE_NUM_VALUES];
+static ULONGLONG      Sid1Fingerprint[OBD_MAX_ECUS][MAX_PIDS];
+static IPT_SAMPLE     Sid9IptSample[OBD_MAX_ECUS];
+static DECODED_SAMPLE InvalidSample;    /* returned for ECUs out of range */
+
+/*
+*******************************************************************************
+** Fingerprint64 - Function to get the 64 bit FNV-1a hash of a response,
+**                 never 0
+*******************************************************************************
+*/
+static ULONGLONG Fingerprint64 (const unsigned char *pData, unsigned long Size)
+{
+	ULONGLONG     Hash;
+	unsigned long Index;
+
+	/* FNV offset basis $CBF29CE484222325, prime $100000001B3 (2^40 + $1B3) */
+	Hash = ((ULONGLONG)0xCBF29CE4 << 32) | 0x84222325;
+	for (Index = 0; Index < Size; Index++)
+	{
+		Hash ^= pData[Index];
+		Hash  = (Hash << 40) + Hash * 0x1B3;
+	}
+
+	return (Hash != 0) ? Hash : 1;
+}
+
+/*
+*******************************************************************************
+** Sid1SampleId - Function to get the sample of a SID $1 PID, -1 if the
+**                PID is not decoded
+*******************************************************************************
+*/
+static int Sid1SampleId (unsigned char Pid)
+{
+	switch (Pid)
+	{
+		case 0x04: return SAMPLE_LOAD_PCT;
+		case 0x05: return SAMPLE_ECT;
+		case 0x0C: return SAMPLE_RPM;
+		case 0x0D: return SAMPLE_VSS;
+		case 0x1C: return SAMPLE_OBDSUP;
+		case 0x1F: return SAMPLE_RUNTM;
+		case 0x21: return SAMPLE_MIL_DIST;
+		case 0x30: return SAMPLE_WARM_UPS;
+		case 0x31: return SAMPLE_CLR_DIST;
+		case 0x4D: return SAMPLE_MIL_TIME;
+		case 0x4E: return SAMPLE_CLR_TIME;
+	}
+	return -1;
+}
+
+/*
+*******************************************************************************
+** SampleCacheSaveSid1 - Function to decode a saved SID $1 PID
+*******************************************************************************
+*/
+void SampleCacheSaveSid1 (unsigned long EcuIndex, const SID1 *pSid1)
+{
+	DECODED_SAMPLE *pSample;
+	int             SampleId;
+	unsigned long   Word;
+	signed char     DataSize;
+
+	if (EcuIndex >= OBD_MAX_ECUS)
+	{
+		return;
+	}
+
+	/* fingerprint the PID's own data bytes only (any PID) */
+	DataSize = GetSid1PidDesc (pSid1->PID)->DataSize;
+	if (DataSize <= 0)
+	{
+		DataSize = sizeof(pSid1->Data);
+	}
+	Sid1Fingerprint[EcuIndex][pSid1->PID] = Fingerprint64 ((const unsigned char *)pSid1, 1 + DataSize);
+
+	SampleId = Sid1SampleId (pSid1->PID);
+	if (SampleId < 0)
+	{
+		return;
+	}
+
+	pSample = &Sid1Sample[EcuIndex][SampleId];
+	Word    = (pSid1->Data[0] * 256) + pSid1->Data[1];
+
+	switch (SampleId)
+	{
+		case SAMPLE_LOAD_PCT:
+			pSample->fValue = (float)pSid1->Data[0] * (float)(100.0 / 255.0);
+			pSample->lValue = (long)pSample->fValue;
+		break;
+		case SAMPLE_ECT:
+			pSample->lValue = (long)pSid1->Data[0] - 40;
+			pSample->fValue = (float)pSample->lValue;
+		break;
+		case SAMPLE_RPM:
+			pSample->fValue = (float)Word / (float)4.0;
+			pSample->lValue = Word >> 2;
+		break;
+		case SAMPLE_VSS:
+		case SAMPLE_OBDSUP:
+		case SAMPLE_WARM_UPS:
+			pSample->lValue = pSid1->Data[0];
+			pSample->fValue = (float)pSample->lValue;
+		break;
+		default:    /* 16 bit counts: RUNTM, MIL_DIST, CLR_DIST, MIL_TIME, CLR_TIME */
+			pSample->lValue = Word;
+			pSample->fValue = (float)pSample->lValue;
+		break;
+	}
+
+	pSample->TimeMsecs = GetTickCount ();
+	pSample->fValid    = TRUE;
+}
+
+/*
+*******************************************************************************
+** SampleCacheSaveSid9Ipt - Function to decode the saved SID $9 INF $8 / $B
+**                          in-use performance tracking counters of an ECU
+*******************************************************************************
+*/
+void SampleCacheSaveSid9Ipt (unsigned long EcuIndex)
+{
+	IPT_SAMPLE    *pSample;
+	SID9          *pSid9;
+	unsigned long  NumIpt;
+	unsigned long  IptIndex;
+
+	if (EcuIndex >= OBD_MAX_ECUS)
+	{
+		return;
+	}
+
+	pSample = &Sid9IptSample[EcuIndex];
+	memset (pSample, 0, sizeof(IPT_SAMPLE));
+
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
+	if ( gOBDResponse[EcuIndex].Sid9Inf.Size == 0 ||
+	     ( pSid9->INF != 0x08 && pSid9->INF != 0x0B ) )
+	{
+		return;
+	}
+
+	if ( gOBDList[gOBDListIndex].Protocol == ISO15765 )
+	{
+		/* INF, NODI, then NODI two byte counters */
+		pSample->Ipt.INF  = SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 0);
+		pSample->Ipt.NODI = SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1);
+
+		NumIpt = (pSample->Ipt.NODI <= INF_TYPE_IPT_NODI) ? pSample->Ipt.NODI : INF_TYPE_IPT_NODI;
+		for ( IptIndex = 0; IptIndex < NumIpt; IptIndex++ )
+		{
+			pSample->Ipt.IPT[IptIndex] = SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 2 + IptIndex * 2) * 256
+			                           + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 3 + IptIndex * 2);
+		}
+	}
+	else
+	{
+		/* one SID9 message per two counters */
+		pSample->Ipt.INF  = pSid9->INF;
+		pSample->Ipt.NODI = (unsigned char)((gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9)) * 2);
+
+		NumIpt = gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9);
+		for ( IptIndex = 0; IptIndex < NumIpt && IptIndex * 2 + 1 < INF_TYPE_IPT_NODI; IptIndex++ )
+		{
+			pSample->Ipt.IPT[IptIndex * 2]     = pSid9[IptIndex].Data[0] * 256 + pSid9[IptIndex].Data[1];
+			pSample->Ipt.IPT[IptIndex * 2 + 1] = pSid9[IptIndex].Data[2] * 256 + pSid9[IptIndex].Data[3];
+		}
+	}
+
+	pSample->Ipt.Flags   = 1;
+	pSample->Fingerprint = Fingerprint64 ((const unsigned char *)&pSample->Ipt, sizeof(SID9IPT));
+	pSample->TimeMsecs   = GetTickCount ();
+	pSample->fValid      = TRUE;
+}
+
+/*
+*******************************************************************************
+** SampleCacheInvalidate - Function to drop the decoded values of an ECU
+**                         before SID $1 PID Id or SID $9 INF Id is requested
+*******************************************************************************
+*/
+void SampleCacheInvalidate (unsigned char Sid, unsigned char Id, unsigned long EcuIndex)
+{
+	int SampleId;
+
+	if (EcuIndex >= OBD_MAX_ECUS)
+	{
+		return;
+	}
+
+	if (Sid == 0x01)
+	{
+		SampleId = Sid1SampleId (Id);
+		if (SampleId >= 0)
+		{
+			Sid1Sample[EcuIndex][SampleId].fValid = FALSE;
+		}
+	}
+	else if (Sid == 0x09)
+	{
+		/* any SID $9 request replaces the saved INF data */
+		Sid9IptSample[EcuIndex].fValid = FALSE;
+	}
+}
+
+/*
+*******************************************************************************
+** SampleCacheRebuild - Function to decode the response data of all ECUs
+**                      again (e.g. after gOBDResponse is restored)
+*******************************************************************************
+*/
+void SampleCacheRebuild (void)
+{
+	unsigned long EcuIndex;
+	unsigned long SidIndex;
+	unsigned long NumPids;
+	SID1         *pSid1;
+
+	memset (Sid1Sample, 0, sizeof(Sid1Sample));
+	memset (Sid1Fingerprint, 0, sizeof(Sid1Fingerprint));
+
+	for (EcuIndex = 0; EcuIndex < gOBDEcuCapacity && EcuIndex < OBD_MAX_ECUS; EcuIndex++)
+	{
+		/* a packed response holds one SID1 entry per PID, any other a single PID */
+		pSid1   = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
+		NumPids = (gOBDResponse[EcuIndex].Sid1PidSize > 0) ? 1 : 0;
+		if ( gOBDResponse[EcuIndex].Sid1PidSize >= 2 * sizeof(SID1) &&
+		     gOBDResponse[EcuIndex].Sid1PidSize % sizeof(SID1) == 0 )
+		{
+			NumPids = gOBDResponse[EcuIndex].Sid1PidSize / sizeof(SID1);
+		}
+
+		for (SidIndex = 0; SidIndex < NumPids; SidIndex++)
+		{
+			SampleCacheSaveSid1 (EcuIndex, &pSid1[SidIndex]);
+		}
+
+		SampleCacheSaveSid9Ipt (EcuIndex);
+	}
+}
+
+/*
+*******************************************************************************
+** GetSid1Sample - Function to get a decoded SID $1 value of an ECU.
+**                 Check fValid before using the value.
+*******************************************************************************
+*/
+const DECODED_SAMPLE *GetSid1Sample (unsigned long EcuIndex, SAMPLE_ID SampleId)
+{
+	if (EcuIndex >= OBD_MAX_ECUS || SampleId >= SAMPLE_NUM_VALUES)
+	{
+		return &InvalidSample;
+	}
+
+	return &Sid1Sample[EcuIndex][SampleId];
+}
+
+/*
+*******************************************************************************
+** GetSid9IptSample - Function to get the decoded SID $9 IPT counters of an
+**                    ECU, NULL if the last SID $9 response was not IPT data
+*******************************************************************************
+*/
+const SID9IPT *GetSid9IptSample (unsigned long EcuIndex, unsigned long *pTimeMsecs)
+{
+	if (EcuIndex >= OBD_MAX_ECUS || Sid9IptSample[EcuIndex].fValid == FALSE)
+	{
+		return NULL;
+	}
+
+	if (pTimeMsecs != NULL)
+	{
+		*pTimeMsecs = Sid9IptSample[EcuIndex].TimeMsecs;
+	}
+	return &Sid9IptSample[EcuIndex].Ipt;
+}
+
+/*
+*******************************************************************************
+** GetSid1Fingerprint - Function to get the fingerprint of the last saved
+**                      SID $1 PID response of an ECU, 0 if none
+*******************************************************************************
+*/
+ULONGLONG GetSid1Fingerprint (unsigned long EcuIndex, unsigned char Pid)
+{
+	if (EcuIndex >= OBD_MAX_ECUS)
+	{
+		return 0;
+	}
+
+	return Sid1Fingerprint[EcuIndex][Pid];
+}
+
+/*
+*******************************************************************************
+** GetSid9IptFingerprint - Function to get the fingerprint of the decoded
+**                         SID $9 IPT counters of an ECU, 0 if none
+*******************************************************************************
+*/
+ULONGLONG GetSid9IptFingerprint (unsigned long EcuIndex)
+{
+	if (EcuIndex >= OBD_MAX_ECUS)
+	{
+		return 0;
+	}
+
+	return Sid9IptSample[EcuIndex].Fingerprint;
+}
@@ -44,13 +44,25 @@
 /*  Funtion prototypes  */
 STATUS SetupRequestMSG    (SID_REQ *, PASSTHRU_MSG *);
 STATUS ProcessLegacyMsg   (SID_REQ *, PASSTHRU_MSG *, unsigned long *, unsigned long *, unsigned long *, unsigned long *, unsigned long	*, unsigned long);
-STATUS ProcessISO15765Msg (SID_REQ *, PASSTHRU_MSG *, unsigned long *, unsigned long *, unsigned long *, unsigned long *, unsigned long *);
+STATUS ProcessISO15765Msg (SID_REQ *, PASSTHRU_MSG *, unsigned long *, unsigned long *, unsigned long *, unsigned long *);
+unsigned long GetExpectedEcuFlags (SID_REQ *);
+static BOOL IsSupportIdExpected (unsigned long EcuIndex, unsigned char Sid, unsigned char Id, unsigned char SupportSize);
+static unsigned long TransferWindowEnd (unsigned long WindowEndMsecs, unsigned long *pNumTransfers);
 
 /* Wait / Pending data */
 static unsigned long ulEcuWaitFlags = 0;            /* up to 32 ECUs */
+static unsigned long ulEcuDoneFlags = 0;            /* ECUs with a final response, up to 32 ECUs */
 static unsigned long ulResponsePendingDelay = 0;
 static unsigned char bPadErrorPermanent = FALSE;
 
+/* Receive buffer, reused by every request (too large for the stack) */
+static PASSTHRU_MSG RxMsgList[OBD_MAX_READ_MSGS];
+static RX_RING_SLOT *pRxSlotList[OBD_MAX_READ_MSGS];   /* receive thread ring slots */
+static PASSTHRU_MSG *pRxMsgList[OBD_MAX_READ_MSGS];    /* messages to process, either buffer */
+static unsigned long RxReadTimeList[OBD_MAX_READ_MSGS];
+static unsigned long RxHostUsecsList[OBD_MAX_READ_MSGS];  /* high resolution read times */
+static BOOL          RxHostValidList[OBD_MAX_READ_MSGS];  /* RxHostUsecsList entry is known */
+
 /*
 *******************************************************************************
 **	SidRequest - Function to request a service ID
@@ -63,13 +75,14 @@ static unsigned char bPadErrorPermanent = FALSE;
 */
 STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 {
-	PASSTHRU_MSG  RxMsg;
 	PASSTHRU_MSG  TxMsg;
 	unsigned long NumMsgs;
+	unsigned long MsgIndex;
+	BOOL          bAllResponses;
 	unsigned long RetVal;
 	unsigned long StartTimeMsecs;
 	unsigned long NumResponses;
-	unsigned long NumFirstFrames;
+	unsigned long NumTransfers;
 	unsigned long TxTimestamp;
 	unsigned long ExtendResponseTimeMsecs;
 	unsigned long SOMTimestamp;
@@ -77,6 +90,14 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 	unsigned long ulResponseTimeoutMsecs;
 	char bString[MAX_LOG_STRING_SIZE];
 	unsigned long EcuTimingIndex;
+	unsigned long ulExpectedEcuFlags;
+	unsigned long ulTrailingEndMsecs;
+	unsigned long ulWindowEndMsecs;
+	unsigned long ulCheckedWindowEndMsecs;
+	unsigned long ReadTimeMsecs;
+	unsigned long ReadHostUsecs;
+	BOOL          bTrailing;
+	BOOL          bRxThread;
 
 	STATUS eReturnCode = PASS;    // saves the return code from function calls
 
@@ -88,14 +109,16 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 
 	/* Reset wait variables */
 	ulEcuWaitFlags          = 0;
+	ulEcuDoneFlags          = 0;
 	ulResponsePendingDelay  = 0;
 
 	/* Initialize ECU variables */
-	for ( EcuTimingIndex = 0; EcuTimingIndex < OBD_MAX_ECUS; EcuTimingIndex++ )
+	for ( EcuTimingIndex = 0; EcuTimingIndex < gOBDEcuCapacity; EcuTimingIndex++ )
 	{
 		gEcuTimingData[EcuTimingIndex].ExtendResponseTimeMsecs = 0;
 		gEcuTimingData[EcuTimingIndex].ResponsePendingDelay    = 0;
 		gEcuTimingData[EcuTimingIndex].NAKReceived             = FALSE;
+		gEcuTimingData[EcuTimingIndex].Transfer.Active         = FALSE;
 	}
 
 	/* if gSuspendLogOutput is true, then clear buffer */
@@ -104,19 +127,19 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 		SaveTransactionStart();
 	}
 
+	/* Stop the receive thread and drop anything left from the last request */
+	RxThreadPause ();
+	bRxThread = RxThreadIsRunning ();
+
 	/* If not burst test, stop tester present message and delay
 	** before each request to avoid exceeding minimum OBD request timing */
 	if ( ( Flags & SID_REQ_NO_PERIODIC_DISABLE ) == 0)
 	{
-		/* Stop the tester present message before each request */
-		if (StopPeriodicMsg (TRUE) == FAIL)
+		/* Move the tester present message out of the way if it would collide */
+		if (PeriodicMsgBeginRequest () == FAIL)
 		{
 			return(FAIL);
 		}
-
-		gOBDList[gOBDListIndex].TesterPresentID = -1;
-
-		Sleep (gOBDRequestDelay);
 	}
 
 	/* Setup request message based on the protocol */
@@ -160,6 +183,12 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 		}
 	}
 
+	/* Host clock reference for interfaces that do not echo the request */
+	TimingStartRequest ();
+
+	/* Let the receive thread pick up the responses */
+	RxThreadResume ();
+
 	/* Log the request message to compare to what is sent */
 	LogMsg( &TxMsg, LOG_REQ_MSG );
 
@@ -176,31 +205,95 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 	** we can see late responses.
 	*/
 	NumResponses    = 0;
-	NumFirstFrames  = 0;
+	NumTransfers    = 0;
 	fFirstResponse  = TRUE;
+	bTrailing       = FALSE;
+	ulTrailingEndMsecs = 0;
+	ulExpectedEcuFlags = GetExpectedEcuFlags (SidReq);
+	PacingStartRequest ();
 	StartTimeMsecs  = GetTickCount();
+	ulWindowEndMsecs = StartTimeMsecs + ( 5 * gOBDMaxResponseTimeMsecs );
+	ulCheckedWindowEndMsecs = ulWindowEndMsecs;
 
 	do
 	{
 		if ( fFirstResponse == TRUE )
 		{
 			fFirstResponse = FALSE;
-			ulResponseTimeoutMsecs =  5 * gOBDMaxResponseTimeMsecs;
 			sprintf ( bString, "In SidRequest - Initial PassThruReadMsgs" );
 		}
 		else
 		{
-			ulResponseTimeoutMsecs =  (5 * gOBDMaxResponseTimeMsecs) + ExtendResponseTimeMsecs;
 			sprintf ( bString, "In SidRequest - Loop PassThruReadMsgs" );
 
 		}
 
-		/* Read the next response */
-		NumMsgs = 1;
-		RetVal = PassThruReadMsgs( gOBDList[gOBDListIndex].ChannelID,
-		                           &RxMsg,
-		                           &NumMsgs,
-		                           ulResponseTimeoutMsecs );
+		/* Wait no longer than the end of the response window */
+		ulResponseTimeoutMsecs = 0;
+		if ( (long)(ulWindowEndMsecs - GetTickCount()) > 0 )
+		{
+			ulResponseTimeoutMsecs = ulWindowEndMsecs - GetTickCount();
+		}
+
+		/* Once all expected ECUs are done, only wait out the trailing window */
+		if ( bTrailing == TRUE )
+		{
+			if ( (long)(ulTrailingEndMsecs - GetTickCount()) <= 0 )
+			{
+				break;
+			}
+			ulResponseTimeoutMsecs = ulTrailingEndMsecs - GetTickCount();
+		}
+
+		if ( bRxThread == TRUE )
+		{
+			/* Take everything the receive thread has queued, or wait for the next one */
+			NumMsgs = OBD_MAX_READ_MSGS;
+			RetVal = RxThreadRead( pRxSlotList, &NumMsgs, ulResponseTimeoutMsecs );
+			gSidReadCalls++;
+
+			for ( MsgIndex = 0; MsgIndex < NumMsgs; MsgIndex++ )
+			{
+				pRxMsgList[MsgIndex]     = &pRxSlotList[MsgIndex]->Msg;
+				RxReadTimeList[MsgIndex] = pRxSlotList[MsgIndex]->ReadTimeMsecs;
+				RxHostValidList[MsgIndex] = HostTimeToUsecs( &pRxSlotList[MsgIndex]->HostTime, &RxHostUsecsList[MsgIndex] );
+			}
+		}
+		else
+		{
+			/*
+			** Read everything already queued in the interface with one call.
+			** If nothing is waiting, block for the next response.
+			*/
+			NumMsgs = OBD_MAX_READ_MSGS;
+			RetVal = PassThruReadMsgs( gOBDList[gOBDListIndex].ChannelID,
+			                           &RxMsgList[0],
+			                           &NumMsgs,
+			                           0 );
+			gSidReadCalls++;
+
+			if ( NumMsgs == 0 &&
+			     ( (RetVal == STATUS_NOERROR) || (RetVal == ERR_BUFFER_EMPTY) ) )
+			{
+				NumMsgs = 1;
+				RetVal = PassThruReadMsgs( gOBDList[gOBDListIndex].ChannelID,
+				                           &RxMsgList[0],
+				                           &NumMsgs,
+				                           ulResponseTimeoutMsecs );
+				gSidReadCalls++;
+			}
+
+			ReadTimeMsecs = GetTickCount();
+			ReadHostUsecs = GetHostUsecs();
+			for ( MsgIndex = 0; MsgIndex < NumMsgs; MsgIndex++ )
+			{
+				pRxMsgList[MsgIndex]     = &RxMsgList[MsgIndex];
+				RxReadTimeList[MsgIndex] = ReadTimeMsecs;
+				RxHostUsecsList[MsgIndex] = ReadHostUsecs;
+				RxHostValidList[MsgIndex] = TRUE;
+			}
+		}
+		gSidReadMsgs += NumMsgs;
 
 		if ( (RetVal != STATUS_NOERROR) &&
 		     (RetVal != ERR_BUFFER_EMPTY) &&
@@ -212,11 +305,29 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 			eReturnCode |= FAIL;
 		}
 
-		/* If a message was received, process it */
-		if ( NumMsgs == 1 )
+		/*
+		** Process the messages in the order they were received.  The whole
+		** batch is processed even after all responses are in, so the frames
+		** read with them are logged and late or duplicate responses are seen.
+		*/
+		bAllResponses = FALSE;
+		for ( MsgIndex = 0; MsgIndex < NumMsgs; MsgIndex++ )
 		{
 			/* Save all read messages in the log file */
-			LogMsg(&RxMsg, LOG_NORMAL_MSG);
+			LogMsg(pRxMsgList[MsgIndex], LOG_NORMAL_MSG);
+
+			/* Track the bus activity for request pacing */
+			PacingNoteRxMsg(pRxMsgList[MsgIndex], RxReadTimeList[MsgIndex]);
+
+			/* Host read time, used if there is no interface reference timestamp */
+			if ( RxHostValidList[MsgIndex] == TRUE )
+			{
+				TimingNoteRxHostUsecs(RxHostUsecsList[MsgIndex]);
+			}
+			else
+			{
+				TimingNoteRxHostUnknown();
+			}
 
 			/* Process response based on protocol */
 			switch (gOBDList[gOBDListIndex].Protocol)
@@ -227,7 +338,7 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 				case ISO14230:
 				{
 					eReturnCode |= ProcessLegacyMsg ( SidReq,
-					                                  &RxMsg,
+					                                  pRxMsgList[MsgIndex],
 					                                  &StartTimeMsecs,
 					                                  &NumResponses,
 					                                  &TxTimestamp,
@@ -240,10 +351,9 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 				{
 					eReturnCode |= ( ProcessISO15765Msg(
 					                                     SidReq,
-					                                     &RxMsg,
+					                                     pRxMsgList[MsgIndex],
 					                                     &StartTimeMsecs,
 					                                     &NumResponses,
-					                                     &NumFirstFrames,
 					                                     &TxTimestamp,
 					                                     &ExtendResponseTimeMsecs) );
 				}
@@ -252,21 +362,70 @@ STATUS SidRequest(SID_REQ *SidReq, unsigned long Flags)
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "Invalid protocol specified for response.\n");
+					RxThreadRequestPause ();
 					return (FAIL);
 				}
 			}
+
+			/* If all expected ECUs responded and flag is set, don't wait for timeout */
+			/* NOTE: This mechanism is only good for single message response per ECU */
+			if ( ( NumResponses >= gOBDNumEcus )	&&
+			     ( Flags & SID_REQ_RETURN_AFTER_ALL_RESPONSES ) )
+			{
+				bAllResponses = TRUE;
+			}
 		}
 
-		/* If all expected ECUs responded and flag is set, don't wait for timeout */
-		/* NOTE: This mechanism is only good for single message response per ECU */
-		if ( ( NumResponses >= gOBDNumEcus )	&&
-		     ( Flags & SID_REQ_RETURN_AFTER_ALL_RESPONSES ) )
+		if ( bAllResponses == TRUE )
 		{
 			break;
 		}
+
+		/*
+		** The response window is the longer of the response time (extended
+		** for response pending) and the deadline of each segmented transfer
+		** still in progress.
+		*/
+		ulWindowEndMsecs = TransferWindowEnd ( StartTimeMsecs + ( 5 * gOBDMaxResponseTimeMsecs ) + ExtendResponseTimeMsecs,
+		                                       &NumTransfers );
+
+		/*
+		** If every expected ECU has sent its final response (no segmented
+		** transfer or response pending outstanding), stop waiting for the full
+		** response window.  Keep reading for a short trailing window to catch
+		** late duplicate responses.
+		*/
+		if ( bTrailing == FALSE &&
+		     ulExpectedEcuFlags != 0 &&
+		     ( ulEcuDoneFlags & ulExpectedEcuFlags ) == ulExpectedEcuFlags &&
+		     ulEcuWaitFlags == 0 &&
+		     NumTransfers == 0 )
+		{
+			bTrailing = TRUE;
+			ulTrailingEndMsecs = GetTickCount() + gOBDMaxResponseTimeMsecs;
+		}
+
+		/*
+		** A longer response window (response pending, segmented transfer or
+		** a restarted start time) may now run into the next tester present
+		** message.  The window at the request was checked before it was sent.
+		*/
+		if ( (long)(ulWindowEndMsecs - ulCheckedWindowEndMsecs) > 0 &&
+		     ( Flags & SID_REQ_NO_PERIODIC_DISABLE ) == 0 )
+		{
+			ulCheckedWindowEndMsecs = ulWindowEndMsecs;
+			if ( PeriodicMsgCheckWindow ( ulWindowEndMsecs ) != PASS )
+			{
+				eReturnCode |= FAIL;
+			}
+		}
 	}
-	while (( NumMsgs == 1 ) &&
-	        ( GetTickCount() - StartTimeMsecs ) < ( ( 5 * gOBDMaxResponseTimeMsecs ) + ExtendResponseTimeMsecs ) );  /*extend response time: the multiplier is changed to 5 from 3*/
+	while (( NumMsgs > 0 ) &&
+	        ( (long)(ulWindowEndMsecs - GetTickCount()) > 0 ) );  /*extend response time: the multiplier is changed to 5 from 3*/
+
+	/* Done with the ring, the thread is parked at the start of the next request */
+	RxThreadRelease ();
+	RxThreadRequestPause ();
 
 	/* Restart the periodic message if protocol determined and not in burst test */
 	if ( ( gOBDDetermined == TRUE )	&&
@@ -402,16 +561,20 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 	}
 	else
 	{	/* Find this ECU's Timing Structure */
-		for ( EcuTimingIndex = 0; EcuTimingIndex < OBD_MAX_ECUS; EcuTimingIndex++ )
+		EcuTimingIndex = EcuRegistryTimingIndex (&pRxMsg->Data[0], HeaderSize, EcuId);
+		if ( EcuTimingIndex == ECU_REGISTRY_NONE )
 		{
-			if ( gEcuTimingData[EcuTimingIndex].EcuId == EcuId || gEcuTimingData[EcuTimingIndex].EcuId == 0x00)
+			if ( gOBDDetermined == TRUE && VerifyEcuID (&pRxMsg->Data[0]) == FAIL )
 			{
-				if ( gEcuTimingData[EcuTimingIndex].EcuId == 0x00 )
-				{
-					gEcuTimingData[EcuTimingIndex].EcuId = EcuId;
-				}
-				break;
+				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "Response from ECU %X not in initial list\n", EcuId );
+			}
+			else
+			{
+				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "Too many OBD ECU responses\n" );
 			}
+			return (FAIL);
 		}
 	}
 
@@ -422,6 +585,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 		{
 			/* Save the timestamp */
 			*ulTxTimestamp = pRxMsg->Timestamp;
+			TimingSetReference ();
 		}
 	}
 
@@ -455,7 +619,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 			*ulSOMTimestamp = pRxMsg->Timestamp;    /* for J1850xxx */
 		}
 
-		ulResponseDelta = *ulSOMTimestamp - *ulTxTimestamp;
+		ulResponseDelta = TimingResponseUsecs (*ulSOMTimestamp, *ulTxTimestamp);
 		ulResponseTimeMsecs = ulResponseDelta / 1000;
 
 		/* same timestamp logic used to get EOM, SOM and DELTA */
@@ -467,6 +631,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 		{
 			gEcuTimingData[EcuTimingIndex].LongestResponsesTime = ulResponseTimeMsecs;
 		}
+		RespTimeHistRecord (EcuTimingIndex, pSidReq->SID, ulResponseDelta);
 
 		/* Display for non-class 2 */
 		if (gOBDList[gOBDListIndex].Protocol == ISO9141 ||
@@ -529,6 +694,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 		/* If response was not late, reset the start time */
 		*ulStartTimeMsecs = GetTickCount();
 		*ulTxTimestamp = pRxMsg->Timestamp;
+		TimingSetReference ();
 
 		/* Save the response information */
 		if (SidSaveResponseData (pRxMsg, pSidReq, pulNumResponses) != PASS)
@@ -600,7 +766,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 			*ulSOMTimestamp = pRxMsg->Timestamp;    /* for J1850xxx */
 		}
 
-		ulResponseDelta = *ulSOMTimestamp - *ulTxTimestamp;
+		ulResponseDelta = TimingResponseUsecs (*ulSOMTimestamp, *ulTxTimestamp);
 		ulResponseTimeMsecs = ulResponseDelta / 1000;
 
 		/* Tally up the response statistics */
@@ -610,6 +776,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 		{
 			gEcuTimingData[EcuTimingIndex].LongestResponsesTime = ulResponseTimeMsecs;
 		}
+		RespTimeHistRecord (EcuTimingIndex, pSidReq->SID, ulResponseDelta);
 
 		/* Display for non-class 2 */
 		if (gOBDList[gOBDListIndex].Protocol == ISO9141 ||
@@ -688,6 +855,7 @@ STATUS ProcessLegacyMsg( SID_REQ       *pSidReq,
 		/* If response was not late, reset the start time */
 		*ulStartTimeMsecs = GetTickCount();
 		*ulTxTimestamp = pRxMsg->Timestamp;
+		TimingSetReference ();
 
 		// Check for proper SID response
 		if ( pRxMsg->Data[HeaderSize] != ( pSidReq->SID + OBD_RESPONSE_BIT ) )
@@ -778,11 +946,13 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
                            PASSTHRU_MSG  *pRxMsg,
                            unsigned long *ulStartTimeMsecs,
                            unsigned long *pulNumResponses,
-                           unsigned long *ulNumFirstFrames,
                            unsigned long *ulTxTimestamp,
                            unsigned long *ulExtendResponseTimeMsecs )
 {
 	unsigned long ulResponseTimeMsecs;
+	unsigned long ulResponseDelta = 0;
+	unsigned long ulTransferUsecs;
+	BOOL          bTransferTimed;
 	unsigned long EcuTimingIndex;
 	unsigned long EcuIndex;
 	unsigned long EcuId = 0;
@@ -804,16 +974,20 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 	else
 	{
 		/* Find this ECU's Timing Structure */
-		for ( EcuTimingIndex = 0; EcuTimingIndex < OBD_MAX_ECUS; EcuTimingIndex++ )
+		EcuTimingIndex = EcuRegistryTimingIndex (&pRxMsg->Data[0], 4, EcuId);
+		if ( EcuTimingIndex == ECU_REGISTRY_NONE )
 		{
-			if ( gEcuTimingData[EcuTimingIndex].EcuId == EcuId || gEcuTimingData[EcuTimingIndex].EcuId == 0x00)
+			if ( gOBDDetermined == TRUE && VerifyEcuID (&pRxMsg->Data[0]) == FAIL )
 			{
-				if ( gEcuTimingData[EcuTimingIndex].EcuId == 0x00 )
-				{
-					gEcuTimingData[EcuTimingIndex].EcuId = EcuId;
-				}
-				break;
+				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "Response from ECU %X not in initial list\n", EcuId );
+			}
+			else
+			{
+				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "Too many OBD ECU responses\n" );
 			}
+			return (FAIL);
 		}
 	}
 
@@ -830,13 +1004,17 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 		}
 	}
 
-	ulResponseTimeMsecs = (pRxMsg->Timestamp - *ulTxTimestamp) / 1000;
+	if ( RequestMsgLpbk == FALSE )
+	{
+		ulResponseDelta = TimingResponseUsecs (pRxMsg->Timestamp, *ulTxTimestamp);
+	}
+	ulResponseTimeMsecs = ulResponseDelta / 1000;
 
 	/* Check for FirstFrame indication */
 	if ( pRxMsg->RxStatus & ISO15765_FIRST_FRAME )
 	{
 		/* Check if response was late (all first frame indications due in P2_MAX) */
-		if ( (pRxMsg->Timestamp - *ulTxTimestamp) > (gOBDMaxResponseTimeMsecs * 1000) )
+		if ( ulResponseDelta > (gOBDMaxResponseTimeMsecs * 1000) )
 		{
 			/* Exceeded maximum response time */
 			Log( ERROR_FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -850,17 +1028,24 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 				gEcuTimingData[EcuTimingIndex].RespTimeTooLate++;
 			}
 			Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-			     "Calculated OBD Response time: %d msec\n",
-			     ( (pRxMsg->Timestamp - *ulTxTimestamp) / 1000) );
+			     "Calculated OBD Response time: %lu.%03lu msec\n",
+			     ulResponseDelta / 1000, ulResponseDelta % 1000 );
 		}
 
-		/* Extend the response time to the worst case for segmented responses */
-		gEcuTimingData[EcuTimingIndex].ExtendResponseTimeMsecs = 30000;
-		if ( gEcuTimingData[EcuTimingIndex].ExtendResponseTimeMsecs > *ulExtendResponseTimeMsecs )
-		{
-			*ulExtendResponseTimeMsecs = gEcuTimingData[EcuTimingIndex].ExtendResponseTimeMsecs;
-		}
-		(*ulNumFirstFrames)++;
+		/*
+		** Extend this ECU's response time to the worst case for segmented
+		** responses and start tracking the transfer.  Only this ECU's
+		** transfer deadline extends the response window.
+		*/
+		gEcuTimingData[EcuTimingIndex].ExtendResponseTimeMsecs = ISO15765_TRANSFER_TIMEOUT_MSECS;
+
+		gEcuTimingData[EcuTimingIndex].Transfer.Active              = TRUE;
+		gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameTimestamp = pRxMsg->Timestamp;
+		gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameHostValid = TimingRxHostUsecs (&gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameHostUsecs);
+		gEcuTimingData[EcuTimingIndex].Transfer.DeadlineMsecs       = GetTickCount() + ISO15765_TRANSFER_TIMEOUT_MSECS;
+		gEcuTimingData[EcuTimingIndex].Transfer.NumBytes            = 0;
+		gEcuTimingData[EcuTimingIndex].Transfer.TransferUsecs       = 0;
+
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Receiving segmented responses, please wait...\n");
 	}
@@ -873,6 +1058,7 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 		{
 			/* Save the timestamp */
 			*ulTxTimestamp = pRxMsg->Timestamp;
+			TimingSetReference ();
 		}
 	}
 
@@ -890,12 +1076,13 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 			{
 				gEcuTimingData[EcuTimingIndex].LongestResponsesTime = ulResponseTimeMsecs;
 			}
+			RespTimeHistRecord (EcuTimingIndex, pSidReq->SID, ulResponseDelta);
 
 			gEcuTimingData[EcuTimingIndex].NAKReceived = TRUE;
 		}
 
 		/* Check if response was late (all negative respones due in P2_MAX) */
-		if ( (pRxMsg->Timestamp - *ulTxTimestamp) > ((gOBDMaxResponseTimeMsecs +  gEcuTimingData[EcuTimingIndex].ResponsePendingDelay) * 1000) )
+		if ( ulResponseDelta > ((gOBDMaxResponseTimeMsecs +  gEcuTimingData[EcuTimingIndex].ResponsePendingDelay) * 1000) )
 		{
 			/* Exceeded maximum response time */
 			Log( ERROR_FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -906,8 +1093,8 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 			gEcuTimingData[EcuTimingIndex].RespTimeOutofRange++;
 			gEcuTimingData[EcuTimingIndex].RespTimeTooLate++;
 			Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-			     "Calculated OBD Response time: %d msec\n",
-			     ( (pRxMsg->Timestamp - *ulTxTimestamp) / 1000) );
+			     "Calculated OBD Response time: %lu.%03lu msec\n",
+			     ulResponseDelta / 1000, ulResponseDelta % 1000 );
 		}
 
 		/* Save the response information */
@@ -918,6 +1105,13 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 			return (FAIL);
 		}
 
+		/* Any negative response other than response pending is final */
+		if ( pRxMsg->Data[6] != NAK_RESPONSE_PENDING &&
+		     LookupEcuIndex (pRxMsg, &EcuIndex) == PASS )
+		{
+			ulEcuDoneFlags |= (1UL<<EcuIndex);
+		}
+
 		/*check the kind of response received for the vehicle*/
 		switch( pRxMsg->Data[6] )
 		{
@@ -1006,7 +1200,7 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 					/* set wait flag */
 					if (LookupEcuIndex (pRxMsg, &EcuIndex) == PASS)
 					{
-						ulEcuWaitFlags |= (1<<EcuIndex);
+						ulEcuWaitFlags |= (1UL<<EcuIndex);
 						gOBDResponse[EcuIndex].bResponseReceived = FALSE; // allow ECU to respond again
 					}
 					else
@@ -1053,6 +1247,7 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 			{
 				gEcuTimingData[EcuTimingIndex].LongestResponsesTime = ulResponseTimeMsecs;
 			}
+			RespTimeHistRecord (EcuTimingIndex, pSidReq->SID, ulResponseDelta);
 		}
 		else
 		{
@@ -1060,7 +1255,7 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 		}
 
 		/* Check if response was late (compensate for segmented responses) */
-		if ( (pRxMsg->Timestamp - *ulTxTimestamp) >
+		if ( ulResponseDelta >
 		     ((gOBDMaxResponseTimeMsecs + gEcuTimingData[EcuTimingIndex].ExtendResponseTimeMsecs) * 1000) )
 		{
 			/* Exceeded maximum response time */
@@ -1073,14 +1268,14 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 			gEcuTimingData[EcuTimingIndex].RespTimeOutofRange++;
 			gEcuTimingData[EcuTimingIndex].RespTimeTooLate++;
 			Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-			     "Calculated OBD Response time: %d msec\n",
-			     ( (pRxMsg->Timestamp - *ulTxTimestamp) / 1000) );
+			     "Calculated OBD Response time: %lu.%03lu msec\n",
+			     ulResponseDelta / 1000, ulResponseDelta % 1000 );
 		}
 
 		/* clear wait flag */
 		if (LookupEcuIndex (pRxMsg, &EcuIndex) == PASS)
 		{
-			ulEcuWaitFlags &= ~(1<<EcuIndex);
+			ulEcuWaitFlags &= ~(1UL<<EcuIndex);
 			gEcuTimingData[EcuTimingIndex].ResponsePendingDelay = 0;        /* ECU response no longer pending */
 		}
 		else
@@ -1092,26 +1287,37 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 		if (ulEcuWaitFlags == 0)
 		{
 			ulResponsePendingDelay = 0;         /* no ECU response is pending */
+			*ulExtendResponseTimeMsecs = 0;     /* clear extended response time */
+		}
 
-			if (*ulNumFirstFrames == 0)
+		/* Close this ECU's segmented transfer */
+		if ( pRxMsg->DataSize > ( 4 + ISO15765_MAX_BYTES_PER_FRAME ) &&
+		     gEcuTimingData[EcuTimingIndex].Transfer.Active == TRUE )
+		{
+			/* Time the transfer from the FirstFrame indication to the final frame */
+			bTransferTimed = TRUE;
+			if ( pRxMsg->Timestamp != 0 && gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameTimestamp != 0 )
 			{
-				*ulExtendResponseTimeMsecs = 0;  /* no First Frames, clear extended response time */
+				ulTransferUsecs = pRxMsg->Timestamp - gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameTimestamp;
 			}
-		}
+			else if ( gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameHostValid == TRUE &&
+			          TimingRxHostUsecs (&ulTransferUsecs) == TRUE )
+			{
+				ulTransferUsecs -= gEcuTimingData[EcuTimingIndex].Transfer.FirstFrameHostUsecs;
+			}
+			else
+			{
+				/* no reference to time the transfer from, skip it */
+				ulTransferUsecs = 0;
+				bTransferTimed  = FALSE;
+			}
+			gEcuTimingData[EcuTimingIndex].Transfer.Active        = FALSE;
+			gEcuTimingData[EcuTimingIndex].Transfer.NumBytes      = pRxMsg->DataSize - 4;
+			gEcuTimingData[EcuTimingIndex].Transfer.TransferUsecs = ulTransferUsecs;
 
-		/* Check if we can turn off the time extension for segmented frames */
-		if ( pRxMsg->DataSize > ( 4 + ISO15765_MAX_BYTES_PER_FRAME ) )
-		{
-			if ( *ulNumFirstFrames > 0 )
+			if ( bTransferTimed == TRUE )
 			{
-				if ( --(*ulNumFirstFrames) == 0 )
-				{
-					/*
-					** If we have received as many segmented frames as
-					** FirstFrame indications, restore 'response pending' time extension
-					*/
-					*ulExtendResponseTimeMsecs = ulResponsePendingDelay;
-				}
+				MultiFrameRecord (EcuId, pRxMsg->DataSize - 4, ulTransferUsecs);
 			}
 		}
 
@@ -1149,6 +1355,9 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 			     "Cannot save SID response data\n");
 			return (FAIL);
 		}
+
+		/* This ECU has sent its final response */
+		ulEcuDoneFlags |= (1UL<<EcuIndex);
 	}
 
 	// Ignore, invalid message
@@ -1157,6 +1366,187 @@ STATUS ProcessISO15765Msg( SID_REQ       *pSidReq,
 }
 
 
+//*****************************************************************************
+//
+//	Function:   IsSupportIdExpected
+//
+//	Purpose:    Determine if an ECU is expected to answer support ID Id
+//	            ($00, $20, ...).  Support ID Id is the last bit of the
+//	            previous support ID's response, so the ECU is expected if
+//	            that bit is set.  If the previous response has not been
+//	            saved, the ECU is expected unless the last response saved
+//	            says the next support ID is not supported.  SupportSize is
+//	            the ECU's number of support elements for Sid (not 0).
+//
+//*****************************************************************************
+static BOOL IsSupportIdExpected( unsigned long EcuIndex, unsigned char Sid,
+                                 unsigned char Id, unsigned char SupportSize )
+{
+	unsigned long PrevElement;
+
+	/* every ECU answers $00 */
+	if ( Id == 0x00 )
+	{
+		return TRUE;
+	}
+
+	/* the reverse order test clears the SID $1 support data as it goes */
+	if ( Sid == 0x01 && gReverseOrderState[EcuIndex] != NOT_REVERSE_ORDER )
+	{
+		return TRUE;
+	}
+
+	PrevElement = (Id >> 5) - 1;
+	if ( PrevElement < SupportSize )
+	{
+		return SupportMapTest (Sid, EcuIndex, Id);
+	}
+
+	return SupportMapTest (Sid, EcuIndex, (unsigned int)SupportSize << 5);
+}
+
+
+//*****************************************************************************
+//
+//	Function:   GetExpectedEcuFlags
+//
+//	Purpose:    Build the set of ECUs (bit per gOBDResponse index) that are
+//	            expected to respond to a request, so SidRequest can stop
+//	            waiting once all of them have sent a final response.
+//
+//	            Only used for ISO15765 after the OBD ECUs are determined,
+//	            where each ECU sends a single (possibly segmented) response.
+//	            ECUs without support data are always expected.  Returns 0
+//	            if the full response window must be used.
+//
+//*****************************************************************************
+unsigned long GetExpectedEcuFlags( SID_REQ *pSidReq )
+{
+	unsigned long EcuIndex;
+	unsigned long IdIndex;
+	unsigned long ulFlags = 0;
+	unsigned char SupportSize;
+	BOOL          bSupported;
+
+	if ( gOBDDetermined == FALSE ||
+	     gOBDList[gOBDListIndex].Protocol != ISO15765 ||
+	     gOBDNumEcus == 0 ||
+	     gOBDNumEcus > 32 )
+	{
+		return 0;
+	}
+
+	for ( EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++ )
+	{
+		/* Support data for the requested service, if the ECU only answers supported IDs */
+		switch ( pSidReq->SID )
+		{
+			case 0x01:
+				SupportSize = gOBDResponse[EcuIndex].Sid1PidSupportSize;
+				break;
+			case 0x06:
+				SupportSize = gOBDResponse[EcuIndex].Sid6MidSupportSize;
+				break;
+			case 0x08:
+				SupportSize = gOBDResponse[EcuIndex].Sid8TidSupportSize;
+				break;
+			case 0x09:
+				SupportSize = gOBDResponse[EcuIndex].Sid9InfSupportSize;
+				break;
+			default:
+				SupportSize = 0;
+				break;
+		}
+
+		bSupported = TRUE;
+		if ( SupportSize != 0 && pSidReq->NumIds != 0 )
+		{
+			bSupported = FALSE;
+			for ( IdIndex = 0; IdIndex < pSidReq->NumIds && bSupported == FALSE; IdIndex++ )
+			{
+				/* support IDs ($00, $20, ...) come from the previous support bitmap */
+				if ( (pSidReq->Ids[IdIndex] & 0x1F) == 0 )
+				{
+					bSupported = IsSupportIdExpected (EcuIndex, pSidReq->SID, pSidReq->Ids[IdIndex], SupportSize);
+				}
+				else if ( pSidReq->SID == 0x01 )
+				{
+					bSupported = IsSid1PidSupported (EcuIndex, pSidReq->Ids[IdIndex]);
+				}
+				else if ( pSidReq->SID == 0x06 )
+				{
+					bSupported = IsSid6MidSupported (EcuIndex, pSidReq->Ids[IdIndex]);
+				}
+				else if ( pSidReq->SID == 0x08 )
+				{
+					bSupported = IsSid8TidSupported (EcuIndex, pSidReq->Ids[IdIndex]);
+				}
+				else
+				{
+					bSupported = IsSid9InfSupported (EcuIndex, pSidReq->Ids[IdIndex]);
+				}
+			}
+		}
+
+		if ( bSupported == TRUE )
+		{
+			ulFlags |= (1UL<<EcuIndex);
+		}
+	}
+
+	return ulFlags;
+}
+
+
+//*****************************************************************************
+//
+//	Function:   TransferWindowEnd
+//
+//	Purpose:    Get the end of the response window, the later of
+//	            WindowEndMsecs and the deadline of each ISO15765 segmented
+//	            transfer still in progress.  Transfers past their deadline
+//	            are closed.  Returns the number of transfers in progress
+//	            in *pNumTransfers.
+//
+//*****************************************************************************
+static unsigned long TransferWindowEnd( unsigned long WindowEndMsecs, unsigned long *pNumTransfers )
+{
+	unsigned long EcuTimingIndex;
+	unsigned long NowMsecs;
+	ISO15765_TRANSFER *pTransfer;
+
+	*pNumTransfers = 0;
+	NowMsecs = GetTickCount();
+
+	for ( EcuTimingIndex = 0; EcuTimingIndex < gOBDEcuCapacity; EcuTimingIndex++ )
+	{
+		pTransfer = &gEcuTimingData[EcuTimingIndex].Transfer;
+		if ( pTransfer->Active == FALSE )
+		{
+			continue;
+		}
+
+		if ( (long)(pTransfer->DeadlineMsecs - NowMsecs) <= 0 )
+		{
+			/* Give up on this transfer, the others keep their own deadlines */
+			pTransfer->Active = FALSE;
+			Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "ECU %X  Segmented response not completed within %d msec of the FirstFrame indication\n",
+			     gEcuTimingData[EcuTimingIndex].EcuId, ISO15765_TRANSFER_TIMEOUT_MSECS );
+			continue;
+		}
+
+		(*pNumTransfers)++;
+		if ( (long)(pTransfer->DeadlineMsecs - WindowEndMsecs) > 0 )
+		{
+			WindowEndMsecs = pTransfer->DeadlineMsecs;
+		}
+	}
+
+	return WindowEndMsecs;
+}
+
+
 //*****************************************************************************
 //
 //	Function:   SetupRequestMSG
@@ -51,15 +51,32 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 {
 	unsigned long HeaderSize;
 	unsigned long EcuIndex;
+	unsigned long IdIndex;
 
 	/* Set the response header size based on the protocol */
 	HeaderSize = gOBDList[gOBDListIndex].HeaderSize;
 
 	/* Reset SID response data for all ECUs */
-	for (EcuIndex = 0; EcuIndex < OBD_MAX_ECUS; EcuIndex++)
+	for (EcuIndex = 0; EcuIndex < gOBDEcuCapacity; EcuIndex++)
 	{
 		gOBDResponse[EcuIndex].bResponseReceived = FALSE; // reset response received flag
-		
+
+		/* Records saved for an earlier request are no longer duplicates */
+		DupSetReset (EcuIndex);
+
+		/* A support request ($00/$20/...) may clear the ECU's support data */
+		if ( TxMsg->DataSize > (HeaderSize + 1) &&
+		     (TxMsg->Data[HeaderSize + 1] & 0x1F) == 0 )
+		{
+			SupportMapInvalidate (TxMsg->Data[HeaderSize], EcuIndex);
+		}
+
+		/* The decoded values of the requested PIDs / INF are replaced by the new response */
+		for (IdIndex = HeaderSize + 1; IdIndex < TxMsg->DataSize; IdIndex++)
+		{
+			SampleCacheInvalidate (TxMsg->Data[HeaderSize], TxMsg->Data[IdIndex], EcuIndex);
+		}
+
 		/* Save the data in the appropriate SID/PID/MID/TID/InfoType */
 		switch(TxMsg->Data[HeaderSize])
 		{
@@ -149,9 +166,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 					default:
 					{
 						/* All other requests reset the PID data */
-						gOBDResponse[EcuIndex].Sid2PidSize = 0;
-						memset(gOBDResponse[EcuIndex].Sid2Pid, 0,
-						sizeof(gOBDResponse[EcuIndex].Sid2Pid));
+						SidDataReset (&gOBDResponse[EcuIndex].Sid2Pid);
 					}
 					break;
 				}
@@ -161,10 +176,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 			case 0x03:
 			{
 				gOBDResponse[EcuIndex].Sid3Supported = FALSE;
-				gOBDResponse[EcuIndex].Sid3Size = 0;
-				memset( gOBDResponse[EcuIndex].Sid3,
-				        0,
-				        sizeof(gOBDResponse[EcuIndex].Sid3) );
+				SidDataReset (&gOBDResponse[EcuIndex].Sid3);
 			}
 			break;
 			/* SID 4 (Mode 4) */
@@ -200,9 +212,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 					default:
 					{
 						/* All other requests reset the PID data */
-						gOBDResponse[EcuIndex].Sid5TidSize = 0;
-						memset(gOBDResponse[EcuIndex].Sid5Tid, 0,
-						sizeof(gOBDResponse[EcuIndex].Sid5Tid));
+						SidDataReset (&gOBDResponse[EcuIndex].Sid5Tid);
 					}
 					break;
 				}
@@ -237,9 +247,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 					default:
 					{
 						/* All other requests reset the PID data */
-						gOBDResponse[EcuIndex].Sid6MidSize = 0;
-						memset(gOBDResponse[EcuIndex].Sid6Mid, 0,
-						sizeof(gOBDResponse[EcuIndex].Sid6Mid));
+						SidDataReset (&gOBDResponse[EcuIndex].Sid6Mid);
 					}
 					break;
 				}
@@ -249,10 +257,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 			case 0x07:
 			{
 				gOBDResponse[EcuIndex].Sid7Supported = FALSE;
-				gOBDResponse[EcuIndex].Sid7Size = 0;
-				memset( gOBDResponse[EcuIndex].Sid7,
-				        0,
-				        sizeof(gOBDResponse[EcuIndex].Sid7) );
+				SidDataReset (&gOBDResponse[EcuIndex].Sid7);
 			}
 			break;
 			/* SID 8 (Mode 8) */
@@ -284,9 +289,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 					default:
 					{
 						/* All other requests reset the PID data */
-						gOBDResponse[EcuIndex].Sid8TidSize = 0;
-						memset(gOBDResponse[EcuIndex].Sid8Tid, 0,
-						sizeof(gOBDResponse[EcuIndex].Sid8Tid));
+						SidDataReset (&gOBDResponse[EcuIndex].Sid8Tid);
 					}
 					break;
 				}
@@ -321,9 +324,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 					default:
 					{
 						/* All other requests reset the PID data */
-						gOBDResponse[EcuIndex].Sid9InfSize = 0;
-						memset(gOBDResponse[EcuIndex].Sid9Inf, 0,
-						sizeof(gOBDResponse[EcuIndex].Sid9Inf));
+						SidDataReset (&gOBDResponse[EcuIndex].Sid9Inf);
 					}
 					break;
 				}
@@ -336,10 +337,7 @@ STATUS SidResetResponseData(PASSTHRU_MSG *TxMsg)
 			{
 				/* reset the PID data */
 				gOBDResponse[EcuIndex].Sid3Supported = FALSE;
-				gOBDResponse[EcuIndex].SidASize = 0;
-				memset( gOBDResponse[EcuIndex].SidA,
-				        0,
-				        sizeof(gOBDResponse[EcuIndex].SidA) );
+				SidDataReset (&gOBDResponse[EcuIndex].SidA);
 			}
 			break;
 
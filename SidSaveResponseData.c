@@ -43,10 +43,11 @@
 #include "j1699.h"
 
 void ChkIFRAdjust( PASSTHRU_MSG *RxMsg );	/* Logic ajustment for PID Group Reverse order request. */
+STATUS SaveSid1PackedData( PASSTHRU_MSG *RxMsg, unsigned long EcuIndex );	/* Split a multiple PID response */
 STATUS IsMessageUnique
                       (
-                        unsigned char *pucBuffer,	/* pointer to buffer */
-                        unsigned short usSize,		/* size of buffer */
+                        unsigned long  EcuIndex,	/* ECU of the message */
+                        SID_DATA      *pSidData,	/* response data saved so far */
                         unsigned char *pucMsg,		/* pointer to message to be checked */
                         unsigned short usMsgSize	/* size of message */
                       );
@@ -71,6 +72,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 	unsigned long ByteIndex;
 	unsigned char bElementOffset;
 	unsigned long ulInx;	// coordinate mode 6 data respones for multiple data response.
+	int           PidSize;
 
 
 	/* Set the response header size based on the protocol */
@@ -94,6 +96,13 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 		(*pulNumResponses)++;	// count the new response
 	}
 
+	/* A support response ($00/$20/...) changes the ECU's support map */
+	if ( RxMsg->DataSize > (HeaderSize + 1) &&
+	     (RxMsg->Data[HeaderSize + 1] & 0x1F) == 0 )
+	{
+		SupportMapInvalidate ((unsigned char)(RxMsg->Data[HeaderSize] - 0x40), EcuIndex);
+	}
+
 	/* Save the data in the appropriate SID/PID/MID/TID/InfoType */
 	switch(RxMsg->Data[HeaderSize])
 	{
@@ -159,6 +168,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 
 				default:
 				{
+					/* Packed request, save each PID in its own SID1 entry */
+					if ( gSid1PackedRequest == TRUE && SidReq->NumIds > 1 )
+					{
+						return ( SaveSid1PackedData( RxMsg, EcuIndex ) );
+					}
+
 					/* If not PID 0, then check if this is a response to an unsupported PID */
 					if ( gIgnoreUnsupported == FALSE &&
 					     RxMsg->Data[HeaderSize + 1] != 0 &&
@@ -190,379 +205,17 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					*/
 					if (SidReq->NumIds == 1)
 					{
-						switch (RxMsg->Data[HeaderSize + 1])
+						PidSize = GetSid1PidDataSize (RxMsg->Data[HeaderSize + 1]);
+						if ( PidSize >= 0 &&
+						     (RxMsg->DataSize - (HeaderSize + 2)) != (unsigned long)PidSize )
 						{
-							/* Single byte PIDs */
-							case 0x04:
-							case 0x05:
-							case 0x0A:
-							case 0x0B:
-							case 0x0D:
-							case 0x0E:
-							case 0x0F:
-							case 0x11:
-							case 0x12:
-							case 0x13:
-							case 0x1C:
-							case 0x1D:
-							case 0x1E:
-							case 0x2C:
-							case 0x2D:
-							case 0x2E:
-							case 0x2F:
-							case 0x30:
-							case 0x33:
-							case 0x45:
-							case 0x46:
-							case 0x47:
-							case 0x48:
-							case 0x49:
-							case 0x4A:
-							case 0x4B:
-							case 0x4C:
-							case 0x51:
-							case 0x52:
-							case 0x5A:
-							case 0x5B:
-							case 0x5C:
-							case 0x5F:
-							case 0x61:
-							case 0x62:
-							case 0x7D:
-							case 0x7E:
-							case 0x84:
-							case 0x8D:
-							case 0x8E:
-							{
-								/* Check for one data byte */
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 1)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 1)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Two byte PIDs */
-							case 0x02:
-							case 0x03:
-							case 0x0C:
-							case 0x10:
-							case 0x14:
-							case 0x15:
-							case 0x16:
-							case 0x17:
-							case 0x18:
-							case 0x19:
-							case 0x1A:
-							case 0x1B:
-							case 0x1F:
-							case 0x21:
-							case 0x22:
-							case 0x23:
-							case 0x31:
-							case 0x32:
-							case 0x3C:
-							case 0x3D:
-							case 0x3E:
-							case 0x3F:
-							case 0x42:
-							case 0x43:
-							case 0x44:
-							case 0x4D:
-							case 0x4E:
-							case 0x53:
-							case 0x54:
-							case 0x59:
-							case 0x5D:
-							case 0x5E:
-							case 0x63:
-							case 0x65:
-							case 0x92:
-							case 0x9E:
-							case 0xA2:
-							{
-								/* Check for two data bytes */
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 2)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 2)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)) );
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Three byte PIDs */
-							case 0x67:
-							case 0x6F:
-							case 0x90:
-							case 0x93:
-							{
-								/* Check for four data bytes */
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 3)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 3)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Four byte PIDs */
-							case 0x00:
-							case 0x20:
-							case 0x40:
-							case 0x60:
-							case 0x80:
-							case 0xA0:
-							case 0xC0:
-							case 0xE0:
-							case 0x01:
-							case 0x24:
-							case 0x25:
-							case 0x26:
-							case 0x27:
-							case 0x28:
-							case 0x29:
-							case 0x2A:
-							case 0x2B:
-							case 0x34:
-							case 0x35:
-							case 0x36:
-							case 0x37:
-							case 0x38:
-							case 0x39:
-							case 0x3A:
-							case 0x3B:
-							case 0x41:
-							case 0x4F:
-							case 0x50:
-							case 0x9B:
-							case 0x9D:
-							{
-								/* Check for four data bytes */
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 4)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 4)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Five byte PIDs */
-							case 0x64:
-							case 0x66:
-							case 0x6A:
-							case 0x6B:
-							case 0x6C:
-							case 0x72:
-							case 0x73:
-							case 0x74:
-							case 0x77:
-							case 0x86:
-							case 0x87:
-							case 0x91:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 5)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 5)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Six byte PIDs */
-							case 0x71:
-							case 0x9A:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 6)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 6)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Seven byte PIDs */
-							case 0x68:
-							case 0x69:
-							case 0x75:
-							case 0x76:
-							case 0x7A:
-							case 0x7B:
-							case 0x8B:
-							case 0x8F:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 7)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 7)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Nine byte PIDs */
-							case 0x6E:
-							case 0x78:
-							case 0x79:
-							case 0x7C:
-							case 0x83:
-							case 0x98:
-							case 0x99:
-							case 0x9F:
-							case 0xA1:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 9)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 9)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Ten byte PIDs */
-							case 0x70:
-							case 0x85:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 10)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 10)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Eleven byte PIDs */
-							case 0x6D:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 11)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 11)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Twelve byte PIDs */
-							case 0x94:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 12)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 12)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Thirteen byte PIDs */
-							case 0x7F:
-							case 0x88:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 13)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 13)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Seventeen byte PIDs */
-							case 0x8C:
-							case 0x9C:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 17)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 17)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* Forty-One byte PIDs */
-							case 0x81:
-							case 0x82:
-							case 0x89:
-							case 0x8A:
-							{
-								if ((RxMsg->DataSize - (HeaderSize + 2)) != 41)
-								{
-									Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-									     "ECU %X  SID $1 PID $%02X has %d data bytes (should be 41)\n",
-									     GetEcuId(EcuIndex),
-									     RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 2)));
-									return(FAIL);
-								}
-							}
-							break;
-
-							/* 1 or 2 byte PIDs */
-							case 0x06:      /* PID $06 1 / 2-Byte definition */
-							case 0x07:      /* PID $07 1 / 2-Byte definition */
-							case 0x08:      /* PID $08 1 / 2-Byte definition */
-							case 0x09:      /* PID $09 1 / 2-Byte definition */
-							case 0x55:      /* PID $55 1 / 2-Byte definition */
-							case 0x56:      /* PID $56 1 / 2-Byte definition */
-							case 0x57:      /* PID $57 1 / 2-Byte definition */
-							case 0x58:      /* PID $58 1 / 2-Byte definition */
-							{
-								/* Only check if successfully determined the (variable) PID size */
-								if (gSid1VariablePidSize > 0)
-								{
-									/* Check for one or two data bytes */
-									if ((RxMsg->DataSize - (HeaderSize + 2)) != (unsigned)gSid1VariablePidSize)
-									{
-										Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-										     "ECU %X  SID $1 PID $%02X has %d data bytes (should be %u)\n",
-										     GetEcuId(EcuIndex),
-										     RxMsg->Data[HeaderSize + 1],
-										     (RxMsg->DataSize - (HeaderSize + 2)),
-										     gSid1VariablePidSize);
-										return(FAIL);
-									}
-								}
-							}
-							default:
-							{
-								/* Non-OBD PID */
-							}
-							break;
+							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+							     "ECU %X  SID $1 PID $%02X has %d data bytes (should be %d)\n",
+							     GetEcuId(EcuIndex),
+							     RxMsg->Data[HeaderSize + 1],
+							     (RxMsg->DataSize - (HeaderSize + 2)),
+							     PidSize);
+							return(FAIL);
 						}
 					}
 
@@ -580,6 +233,9 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					        &RxMsg->Data[HeaderSize + 1],
 					        (RxMsg->DataSize - HeaderSize - 1) );
 					gOBDResponse[EcuIndex].Sid1PidSize = (unsigned short)(RxMsg->DataSize - HeaderSize - 1);
+
+					/* Decode the PID value once for the readers */
+					SampleCacheSaveSid1 (EcuIndex, (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0]);
 				}
 				break;
 			}
@@ -658,7 +314,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					}
 
 					/* Determine if there is enough room in the buffer to store the data */
-					if ((RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].Sid2Pid) )
+					if ((RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  SID $2 response data exceeded buffer size\n",
@@ -667,10 +323,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					}
 
 					/* Save the data in the buffer and set the new size */
-					memcpy( &gOBDResponse[EcuIndex].Sid2Pid[0],
-					        &RxMsg->Data[HeaderSize + 1],
-					        (RxMsg->DataSize - HeaderSize - 1) );
-					gOBDResponse[EcuIndex].Sid2PidSize = (unsigned short)(RxMsg->DataSize - HeaderSize - 1);
+					if ( SidDataSet( &gOBDResponse[EcuIndex].Sid2Pid,
+					                 &RxMsg->Data[HeaderSize + 1],
+					                 (RxMsg->DataSize - HeaderSize - 1) ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 				break;
 			}
@@ -685,8 +343,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 
 			if (gOBDList[gOBDListIndex].Protocol != ISO15765)
 			{
-				if ( IsMessageUnique(&gOBDResponse[EcuIndex].Sid3[0],
-				                     gOBDResponse[EcuIndex].Sid3Size,
+				if ( IsMessageUnique(EcuIndex, &gOBDResponse[EcuIndex].Sid3,
 				                     &RxMsg->Data[HeaderSize + 1],
 				                     (unsigned short)(RxMsg->DataSize - HeaderSize - 1)) == FAIL )
 				{
@@ -698,7 +355,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 				{
 					/* Determine if there is enough room in the buffer to store the data */
 					if ( (RxMsg->DataSize - HeaderSize - 1) >
-						 (sizeof(gOBDResponse[EcuIndex].Sid3) - gOBDResponse[EcuIndex].Sid3Size) )
+						 (OBD_MAX_SID_DATA_SIZE - gOBDResponse[EcuIndex].Sid3.Size) )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  SID $3 response data exceeded buffer size\n",
@@ -707,10 +364,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					}
 
 					/* Just copy the DTC bytes */
-					memcpy( &gOBDResponse[EcuIndex].Sid3[gOBDResponse[EcuIndex].Sid3Size],
-					        &RxMsg->Data[HeaderSize + 1],
-					       RxMsg->DataSize - HeaderSize - 1);
-					gOBDResponse[EcuIndex].Sid3Size += (unsigned short)(RxMsg->DataSize - HeaderSize - 1);
+					if ( SidDataAppend( &gOBDResponse[EcuIndex].Sid3,
+					                    &RxMsg->Data[HeaderSize + 1],
+					                    RxMsg->DataSize - HeaderSize - 1 ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 			}
 			else
@@ -719,7 +378,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 				gOBDResponse[EcuIndex].bResponseReceived = TRUE;
 
 				/* Determine if there is enough room in the buffer to store the data */
-				if ( (RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].Sid3) )
+				if ( (RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $3 response data exceeded buffer size\n",
@@ -731,16 +390,20 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 				if (RxMsg->DataSize <= (HeaderSize + 2) || (RxMsg->Data[HeaderSize + 1] == 0))
 				{
 					/* If no DTCs, set to zero */
-					memset(&gOBDResponse[EcuIndex].Sid3[0], 0, 2);
-					gOBDResponse[EcuIndex].Sid3Size = 2;
+					if ( SidDataSet( &gOBDResponse[EcuIndex].Sid3, NULL, 2 ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 				else
 				{
 					/* Otherwise copy the DTC data */
-					memcpy( &gOBDResponse[EcuIndex].Sid3[0],
-					        &RxMsg->Data[HeaderSize + 2],
-					        (RxMsg->DataSize - HeaderSize - 2));
-					gOBDResponse[EcuIndex].Sid3Size = (unsigned short)(RxMsg->DataSize - HeaderSize - 2);
+					if ( SidDataSet( &gOBDResponse[EcuIndex].Sid3,
+					                 &RxMsg->Data[HeaderSize + 2],
+					                 (RxMsg->DataSize - HeaderSize - 2) ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 
 				/* Per J1699 rev 11.6- TC# 6.3 & 7.3 verify that reported number of DTCs
@@ -778,8 +441,10 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 			gOBDResponse[EcuIndex].bResponseReceived = TRUE;
 
 			/* Indicate positive response */
-			gOBDResponse[EcuIndex].Sid5Tid[0] = 0x45;
-			gOBDResponse[EcuIndex].Sid5TidSize = 1;
+			if ( SidDataSet( &gOBDResponse[EcuIndex].Sid5Tid, &RxMsg->Data[HeaderSize], 1 ) != PASS )
+			{
+				return(FAIL);
+			}
 		}
 		break;
 
@@ -871,7 +536,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 					{
 						/* Determine if there is enough room in the buffer to store the data */
-						if ((RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].Sid6Mid) )
+						if ((RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE )
 						{
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $6 response data exceeded buffer size\n",
@@ -879,10 +544,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 							return(FAIL);
 						}
 
-						memcpy( &gOBDResponse[EcuIndex].Sid6Mid[0],
-						        &RxMsg->Data[HeaderSize + 1],
-						        (RxMsg->DataSize - HeaderSize - 1));
-						gOBDResponse[EcuIndex].Sid6MidSize = (unsigned short)(RxMsg->DataSize - HeaderSize - 1);
+						if ( SidDataSet( &gOBDResponse[EcuIndex].Sid6Mid,
+						                 &RxMsg->Data[HeaderSize + 1],
+						                 (RxMsg->DataSize - HeaderSize - 1) ) != PASS )
+						{
+							return(FAIL);
+						}
 					}
 					else
 					{
@@ -919,8 +586,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 						/* Adjust the message size */
 						RxMsg->DataSize += 3;
 
-						if ( IsMessageUnique(&gOBDResponse[EcuIndex].Sid6Mid[0],
-						                     gOBDResponse[EcuIndex].Sid6MidSize,
+						if ( IsMessageUnique(EcuIndex, &gOBDResponse[EcuIndex].Sid6Mid,
 						                     &RxMsg->Data[HeaderSize + 1],
 						                     (unsigned short)(RxMsg->DataSize - HeaderSize - 1)) == FAIL )
 						{
@@ -931,8 +597,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 						else
 						{
 							/* Determine if there is enough room in the buffer to store the data */
-							if ((RxMsg->DataSize - HeaderSize - 1) > (sizeof(
-								gOBDResponse[EcuIndex].Sid6Mid) - gOBDResponse[EcuIndex].Sid6MidSize))
+							if ((RxMsg->DataSize - HeaderSize - 1) > (OBD_MAX_SID_DATA_SIZE - gOBDResponse[EcuIndex].Sid6Mid.Size))
 							{
 								Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								     "ECU %X  SID $6 response data exceeded buffer size\n",
@@ -940,10 +605,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 								return(FAIL);
 							}
 
-							memcpy( &gOBDResponse[EcuIndex].Sid6Mid[gOBDResponse[EcuIndex].Sid6MidSize],
-							        &RxMsg->Data[HeaderSize + 1],
-							        (RxMsg->DataSize - HeaderSize - 1));
-							gOBDResponse[EcuIndex].Sid6MidSize += (unsigned short)(RxMsg->DataSize - HeaderSize - 1);
+							if ( SidDataAppend( &gOBDResponse[EcuIndex].Sid6Mid,
+							                    &RxMsg->Data[HeaderSize + 1],
+							                    (RxMsg->DataSize - HeaderSize - 1) ) != PASS )
+							{
+								return(FAIL);
+							}
 						}
 					}
 				}
@@ -960,8 +627,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 
 			if (gOBDList[gOBDListIndex].Protocol != ISO15765)
 			{
-				if ( IsMessageUnique(&gOBDResponse[EcuIndex].Sid7[0],
-				                     gOBDResponse[EcuIndex].Sid7Size,
+				if ( IsMessageUnique(EcuIndex, &gOBDResponse[EcuIndex].Sid7,
 				                     &RxMsg->Data[HeaderSize + 1],
 				                     (unsigned short)(RxMsg->DataSize - HeaderSize - 1)) == FAIL )
 				{
@@ -973,7 +639,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 				{
 					/* Determine if there is enough room in the buffer to store the data */
 					if ( (RxMsg->DataSize - HeaderSize - 1) >
-					     (sizeof(gOBDResponse[EcuIndex].Sid7) - gOBDResponse[EcuIndex].Sid7Size) )
+					     (OBD_MAX_SID_DATA_SIZE - gOBDResponse[EcuIndex].Sid7.Size) )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  SID $7 response data exceeded buffer size\n",
@@ -982,9 +648,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					}
 
 					/* Just copy the DTC bytes */
-					memcpy(&gOBDResponse[EcuIndex].Sid7[gOBDResponse[EcuIndex].Sid7Size],
-					       &RxMsg->Data[HeaderSize + 1], RxMsg->DataSize - HeaderSize - 1);
-					gOBDResponse[EcuIndex].Sid7Size += (unsigned short)(RxMsg->DataSize - HeaderSize - 1);
+					if ( SidDataAppend( &gOBDResponse[EcuIndex].Sid7,
+					                    &RxMsg->Data[HeaderSize + 1],
+					                    RxMsg->DataSize - HeaderSize - 1 ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 			}
 			else
@@ -993,7 +662,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 				gOBDResponse[EcuIndex].bResponseReceived = TRUE;
 
 				/* Determine if there is enough room in the buffer to store the data */
-				if ( (RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].Sid7) )
+				if ( (RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					    "ECU %X  SID $7 response data exceeded buffer size\n",
@@ -1005,15 +674,20 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 				if (RxMsg->DataSize <= (HeaderSize + 2) || (RxMsg->Data[HeaderSize + 1] == 0))
 				{
 					/* If no DTCs, set to zero */
-					memset(&gOBDResponse[EcuIndex].Sid7[0], 0, 2);
-					gOBDResponse[EcuIndex].Sid7Size = 2;
+					if ( SidDataSet( &gOBDResponse[EcuIndex].Sid7, NULL, 2 ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 				else
 				{
 					/* Otherwise copy the DTC data */
-					memcpy(&gOBDResponse[EcuIndex].Sid7[0],
-					       &RxMsg->Data[HeaderSize + 2], (RxMsg->DataSize - HeaderSize - 2));
-					gOBDResponse[EcuIndex].Sid7Size = (unsigned short)(RxMsg->DataSize - HeaderSize - 2);
+					if ( SidDataSet( &gOBDResponse[EcuIndex].Sid7,
+					                 &RxMsg->Data[HeaderSize + 2],
+					                 (RxMsg->DataSize - HeaderSize - 2) ) != PASS )
+					{
+						return(FAIL);
+					}
 				}
 
 				/* Per J1699 rev 11.6- TC# 6.3 & 7.3 verify that reported number of DTCs
@@ -1100,7 +774,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 					{
 						/* Determine if there is enough room in the buffer to store the data */
-						if ( (RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].Sid8Tid) )
+						if ( (RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE )
 						{
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $8 response data exceeded buffer size\n",
@@ -1108,15 +782,18 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 							return(FAIL);
 						}
 
-						memcpy( &gOBDResponse[EcuIndex].Sid8Tid[0],
-						        &RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 1)) );
-						gOBDResponse[EcuIndex].Sid8TidSize = (unsigned short)(RxMsg->DataSize - (HeaderSize + 1));
+						if ( SidDataSet( &gOBDResponse[EcuIndex].Sid8Tid,
+						                 &RxMsg->Data[HeaderSize + 1],
+						                 (RxMsg->DataSize - (HeaderSize + 1)) ) != PASS )
+						{
+							return(FAIL);
+						}
 					}
 					else
 					{
 						/* Determine if there is enough room in the buffer to store the data */
 						if ( (RxMsg->DataSize - HeaderSize - 1) >
-							 (sizeof(gOBDResponse[EcuIndex].Sid8Tid) - gOBDResponse[EcuIndex].Sid8TidSize) )
+							 (OBD_MAX_SID_DATA_SIZE - gOBDResponse[EcuIndex].Sid8Tid.Size) )
 						{
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $8 response data exceeded buffer size\n",
@@ -1124,9 +801,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 							return(FAIL);
 						}
 
-						memcpy( &gOBDResponse[EcuIndex].Sid8Tid[gOBDResponse[EcuIndex].Sid8TidSize],
-						        &RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 1)) );
-						gOBDResponse[EcuIndex].Sid8TidSize += (unsigned short)(RxMsg->DataSize - (HeaderSize + 1));
+						if ( SidDataAppend( &gOBDResponse[EcuIndex].Sid8Tid,
+						                    &RxMsg->Data[HeaderSize + 1],
+						                    (RxMsg->DataSize - (HeaderSize + 1)) ) != PASS )
+						{
+							return(FAIL);
+						}
 					}
 
 					break;
@@ -1243,7 +923,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 					{
 						/* Determine if there is enough room in the buffer to store the data */
-						if ( (RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].Sid9Inf)  )
+						if ( (RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE  )
 						{
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $9 response data exceeded buffer size\n",
@@ -1251,9 +931,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 							return(FAIL);
 						}
 
-						memcpy(&gOBDResponse[EcuIndex].Sid9Inf[0],
-						       &RxMsg->Data[HeaderSize + 1], (RxMsg->DataSize - (HeaderSize + 1)));
-						gOBDResponse[EcuIndex].Sid9InfSize = (unsigned short)(RxMsg->DataSize - (HeaderSize + 1));
+						if ( SidDataSet( &gOBDResponse[EcuIndex].Sid9Inf,
+						                 &RxMsg->Data[HeaderSize + 1],
+						                 (RxMsg->DataSize - (HeaderSize + 1)) ) != PASS )
+						{
+							return(FAIL);
+						}
 
 						/* Verify CVNs contain 4 HEX bytes */
 						if ( RxMsg->Data[HeaderSize+1] == INF_TYPE_CVN )
@@ -1278,8 +961,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 					}
 					else
 					{
-						if ( IsMessageUnique(&gOBDResponse[EcuIndex].Sid9Inf[0],
-						                     gOBDResponse[EcuIndex].Sid9InfSize,
+						if ( IsMessageUnique(EcuIndex, &gOBDResponse[EcuIndex].Sid9Inf,
 						                     &RxMsg->Data[HeaderSize + 1],
 						                     (unsigned short)(RxMsg->DataSize - HeaderSize - 1)) == FAIL )
 						{
@@ -1291,7 +973,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 						{
 							/* Determine if there is enough room in the buffer to store the data */
 							if ( (RxMsg->DataSize - HeaderSize - 1) >
-								 (sizeof(gOBDResponse[EcuIndex].Sid9Inf) - gOBDResponse[EcuIndex].Sid9InfSize) )
+								 (OBD_MAX_SID_DATA_SIZE - gOBDResponse[EcuIndex].Sid9Inf.Size) )
 							{
 								Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								     "ECU %X  SID $9 response data exceeded buffer size\n",
@@ -1299,10 +981,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 								return(FAIL);
 							}
 
-							memcpy( &gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize],
-							        &RxMsg->Data[HeaderSize + 1],
-							        sizeof(SID9) );
-							gOBDResponse[EcuIndex].Sid9InfSize += sizeof(SID9);
+							if ( SidDataAppend( &gOBDResponse[EcuIndex].Sid9Inf,
+							                    &RxMsg->Data[HeaderSize + 1],
+							                    sizeof(SID9) ) != PASS )
+							{
+								return(FAIL);
+							}
 
 							/* Verify CALIDs and CVNs contain 4 HEX bytes */
 							if ( ( (RxMsg->Data[HeaderSize+1] == INF_TYPE_CVN) ||
@@ -1316,6 +1000,12 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 							}
 						}
 					}
+
+					/* Decode the IPT counters once for the readers */
+					if ( RxMsg->Data[HeaderSize+1] == 0x08 || RxMsg->Data[HeaderSize+1] == 0x0B )
+					{
+						SampleCacheSaveSid9Ipt (EcuIndex);
+					}
 				}
 				break;
 			}
@@ -1336,7 +1026,7 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 			gOBDResponse[EcuIndex].bResponseReceived = TRUE;
 
 			/* Determine if there is enough room in the buffer to store the data */
-			if ( (RxMsg->DataSize - HeaderSize - 1) > sizeof(gOBDResponse[EcuIndex].SidA) )
+			if ( (RxMsg->DataSize - HeaderSize - 1) > OBD_MAX_SID_DATA_SIZE )
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  SID $A response data exceeded buffer size\n",
@@ -1348,16 +1038,20 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 			if (RxMsg->DataSize <= (HeaderSize + 2) || (RxMsg->Data[HeaderSize + 1] == 0))
 			{
 				/* If no DTCs, set to zero */
-				memset(&gOBDResponse[EcuIndex].SidA[0], 0, 2);
-				gOBDResponse[EcuIndex].Sid7Size = 2;
+				if ( SidDataSet( &gOBDResponse[EcuIndex].SidA, NULL, 2 ) != PASS )
+				{
+					return(FAIL);
+				}
 			}
 			else
 			{
 				/* Otherwise copy the DTC data */
-				memcpy( &gOBDResponse[EcuIndex].SidA[0],
-				        &RxMsg->Data[HeaderSize + 2],
-				        (RxMsg->DataSize - HeaderSize - 2) );
-				gOBDResponse[EcuIndex].SidASize = (unsigned short)(RxMsg->DataSize - HeaderSize - 2);
+				if ( SidDataSet( &gOBDResponse[EcuIndex].SidA,
+				                 &RxMsg->Data[HeaderSize + 2],
+				                 (RxMsg->DataSize - HeaderSize - 2) ) != PASS )
+				{
+					return(FAIL);
+				}
 			}
 
 			/* Verify that reported number of DTCs matches that of actual DTC count. */
@@ -1401,6 +1095,386 @@ STATUS SidSaveResponseData(PASSTHRU_MSG *RxMsg, SID_REQ *SidReq, unsigned long *
 	return(PASS);
 }
 
+/*
+*******************************************************************************
+** Sid1PidDesc -
+** SID $1 PID descriptors indexed by PID.  Data sizes do not include the PID
+** byte, so a response can be split by stepping DataSize + 1 bytes per PID.
+*******************************************************************************
+*/
+static const SID1_PID_DESC Sid1PidDesc[256] =
+{
+	{ 4,                      "PIDs supported [$01 - $20]" },                                  /* $00 */
+	{ 4,                      "Monitor status since DTCs cleared" },                           /* $01 */
+	{ 2,                      "DTC that caused required freeze frame data storage" },          /* $02 */
+	{ 2,                      "Fuel system status" },                                          /* $03 */
+	{ 1,                      "Calculated load value" },                                       /* $04 */
+	{ 1,                      "Engine coolant temperature" },                                  /* $05 */
+	{ SID1_PID_VARIABLE_SIZE, "Short term fuel trim bank 1 (and 3)" },                         /* $06 */
+	{ SID1_PID_VARIABLE_SIZE, "Long term fuel trim bank 1 (and 3)" },                          /* $07 */
+	{ SID1_PID_VARIABLE_SIZE, "Short term fuel trim bank 2 (and 4)" },                         /* $08 */
+	{ SID1_PID_VARIABLE_SIZE, "Long term fuel trim bank 2 (and 4)" },                          /* $09 */
+	{ 1,                      "Fuel rail pressure (gauge)" },                                  /* $0A */
+	{ 1,                      "Intake manifold absolute pressure" },                           /* $0B */
+	{ 2,                      "Engine RPM" },                                                  /* $0C */
+	{ 1,                      "Vehicle speed" },                                               /* $0D */
+	{ 1,                      "Ignition timing advance" },                                     /* $0E */
+	{ 1,                      "Intake air temperature" },                                      /* $0F */
+	{ 2,                      "Air flow rate from mass air flow sensor" },                     /* $10 */
+	{ 1,                      "Absolute throttle position" },                                  /* $11 */
+	{ 1,                      "Commanded secondary air status" },                              /* $12 */
+	{ 1,                      "Location of oxygen sensors (2 banks)" },                        /* $13 */
+	{ 2,                      "Oxygen sensor output voltage bank 1 sensor 1" },                /* $14 */
+	{ 2,                      "Oxygen sensor output voltage bank 1 sensor 2" },                /* $15 */
+	{ 2,                      "Oxygen sensor output voltage bank 1 sensor 3" },                /* $16 */
+	{ 2,                      "Oxygen sensor output voltage bank 1 sensor 4" },                /* $17 */
+	{ 2,                      "Oxygen sensor output voltage bank 2 sensor 1" },                /* $18 */
+	{ 2,                      "Oxygen sensor output voltage bank 2 sensor 2" },                /* $19 */
+	{ 2,                      "Oxygen sensor output voltage bank 2 sensor 3" },                /* $1A */
+	{ 2,                      "Oxygen sensor output voltage bank 2 sensor 4" },                /* $1B */
+	{ 1,                      "OBD requirements to which vehicle is designed" },               /* $1C */
+	{ 1,                      "Location of oxygen sensors (4 banks)" },                        /* $1D */
+	{ 1,                      "Auxiliary input status" },                                      /* $1E */
+	{ 2,                      "Time since engine start" },                                     /* $1F */
+	{ 4,                      "PIDs supported [$21 - $40]" },                                  /* $20 */
+	{ 2,                      "Distance traveled while MIL is activated" },                    /* $21 */
+	{ 2,                      "Fuel rail pressure relative to manifold vacuum" },              /* $22 */
+	{ 2,                      "Fuel rail pressure" },                                          /* $23 */
+	{ 4,                      "Wide range oxygen sensor 1 equivalence ratio and voltage" },    /* $24 */
+	{ 4,                      "Wide range oxygen sensor 2 equivalence ratio and voltage" },    /* $25 */
+	{ 4,                      "Wide range oxygen sensor 3 equivalence ratio and voltage" },    /* $26 */
+	{ 4,                      "Wide range oxygen sensor 4 equivalence ratio and voltage" },    /* $27 */
+	{ 4,                      "Wide range oxygen sensor 5 equivalence ratio and voltage" },    /* $28 */
+	{ 4,                      "Wide range oxygen sensor 6 equivalence ratio and voltage" },    /* $29 */
+	{ 4,                      "Wide range oxygen sensor 7 equivalence ratio and voltage" },    /* $2A */
+	{ 4,                      "Wide range oxygen sensor 8 equivalence ratio and voltage" },    /* $2B */
+	{ 1,                      "Commanded EGR" },                                               /* $2C */
+	{ 1,                      "EGR error" },                                                   /* $2D */
+	{ 1,                      "Commanded evaporative purge" },                                 /* $2E */
+	{ 1,                      "Fuel level input" },                                            /* $2F */
+	{ 1,                      "Number of warm-ups since DTCs cleared" },                       /* $30 */
+	{ 2,                      "Distance traveled since DTCs cleared" },                        /* $31 */
+	{ 2,                      "Evap system vapor pressure" },                                  /* $32 */
+	{ 1,                      "Barometric pressure" },                                         /* $33 */
+	{ 4,                      "Wide range oxygen sensor 1 equivalence ratio and current" },    /* $34 */
+	{ 4,                      "Wide range oxygen sensor 2 equivalence ratio and current" },    /* $35 */
+	{ 4,                      "Wide range oxygen sensor 3 equivalence ratio and current" },    /* $36 */
+	{ 4,                      "Wide range oxygen sensor 4 equivalence ratio and current" },    /* $37 */
+	{ 4,                      "Wide range oxygen sensor 5 equivalence ratio and current" },    /* $38 */
+	{ 4,                      "Wide range oxygen sensor 6 equivalence ratio and current" },    /* $39 */
+	{ 4,                      "Wide range oxygen sensor 7 equivalence ratio and current" },    /* $3A */
+	{ 4,                      "Wide range oxygen sensor 8 equivalence ratio and current" },    /* $3B */
+	{ 2,                      "Catalyst temperature bank 1 sensor 1" },                        /* $3C */
+	{ 2,                      "Catalyst temperature bank 2 sensor 1" },                        /* $3D */
+	{ 2,                      "Catalyst temperature bank 1 sensor 2" },                        /* $3E */
+	{ 2,                      "Catalyst temperature bank 2 sensor 2" },                        /* $3F */
+	{ 4,                      "PIDs supported [$41 - $60]" },                                  /* $40 */
+	{ 4,                      "Monitor status this driving cycle" },                           /* $41 */
+	{ 2,                      "Control module voltage" },                                      /* $42 */
+	{ 2,                      "Absolute load value" },                                         /* $43 */
+	{ 2,                      "Commanded equivalence ratio" },                                 /* $44 */
+	{ 1,                      "Relative throttle position" },                                  /* $45 */
+	{ 1,                      "Ambient air temperature" },                                     /* $46 */
+	{ 1,                      "Absolute throttle position B" },                                /* $47 */
+	{ 1,                      "Absolute throttle position C" },                                /* $48 */
+	{ 1,                      "Accelerator pedal position D" },                                /* $49 */
+	{ 1,                      "Accelerator pedal position E" },                                /* $4A */
+	{ 1,                      "Accelerator pedal position F" },                                /* $4B */
+	{ 1,                      "Commanded throttle actuator control" },                         /* $4C */
+	{ 2,                      "Engine run time while MIL is activated" },                      /* $4D */
+	{ 2,                      "Engine run time since DTCs cleared" },                          /* $4E */
+	{ 4,                      "Maximum equivalence ratio, oxygen sensor voltage, current and MAP" },/* $4F */
+	{ 4,                      "Maximum air flow rate from mass air flow sensor" },             /* $50 */
+	{ 1,                      "Type of fuel currently being utilized" },                       /* $51 */
+	{ 1,                      "Alcohol fuel percentage" },                                     /* $52 */
+	{ 2,                      "Absolute evap system vapor pressure" },                         /* $53 */
+	{ 2,                      "Evap system vapor pressure (wide range)" },                     /* $54 */
+	{ SID1_PID_VARIABLE_SIZE, "Short term secondary oxygen sensor fuel trim bank 1 (and 3)" }, /* $55 */
+	{ SID1_PID_VARIABLE_SIZE, "Long term secondary oxygen sensor fuel trim bank 1 (and 3)" },  /* $56 */
+	{ SID1_PID_VARIABLE_SIZE, "Short term secondary oxygen sensor fuel trim bank 2 (and 4)" }, /* $57 */
+	{ SID1_PID_VARIABLE_SIZE, "Long term secondary oxygen sensor fuel trim bank 2 (and 4)" },  /* $58 */
+	{ 2,                      "Fuel rail pressure (absolute)" },                               /* $59 */
+	{ 1,                      "Relative accelerator pedal position" },                         /* $5A */
+	{ 1,                      "Hybrid/EV battery pack remaining charge" },                     /* $5B */
+	{ 1,                      "Engine oil temperature" },                                      /* $5C */
+	{ 2,                      "Fuel injection timing" },                                       /* $5D */
+	{ 2,                      "Engine fuel rate" },                                            /* $5E */
+	{ 1,                      "Emission requirements to which vehicle is designed" },          /* $5F */
+	{ 4,                      "PIDs supported [$61 - $80]" },                                  /* $60 */
+	{ 1,                      "Driver's demand engine percent torque" },                       /* $61 */
+	{ 1,                      "Actual engine percent torque" },                                /* $62 */
+	{ 2,                      "Engine reference torque" },                                     /* $63 */
+	{ 5,                      "Engine percent torque data" },                                  /* $64 */
+	{ 2,                      "Auxiliary inputs / outputs" },                                  /* $65 */
+	{ 5,                      "Mass air flow sensor" },                                        /* $66 */
+	{ 3,                      "Engine coolant temperature sensors" },                          /* $67 */
+	{ 7,                      "Intake air temperature sensors" },                              /* $68 */
+	{ 7,                      "Commanded EGR and EGR error" },                                 /* $69 */
+	{ 5,                      "Commanded diesel intake air flow control and relative intake air flow position" },/* $6A */
+	{ 5,                      "Exhaust gas recirculation temperature" },                       /* $6B */
+	{ 5,                      "Commanded throttle actuator control and relative throttle position" },/* $6C */
+	{ 11,                     "Fuel pressure control system" },                                /* $6D */
+	{ 9,                      "Injection pressure control system" },                           /* $6E */
+	{ 3,                      "Turbocharger compressor inlet pressure" },                      /* $6F */
+	{ 10,                     "Boost pressure control" },                                      /* $70 */
+	{ 6,                      "Variable geometry turbo control" },                             /* $71 */
+	{ 5,                      "Wastegate control" },                                           /* $72 */
+	{ 5,                      "Exhaust pressure" },                                            /* $73 */
+	{ 5,                      "Turbocharger RPM" },                                            /* $74 */
+	{ 7,                      "Turbocharger A temperature" },                                  /* $75 */
+	{ 7,                      "Turbocharger B temperature" },                                  /* $76 */
+	{ 5,                      "Charge air cooler temperature" },                               /* $77 */
+	{ 9,                      "Exhaust gas temperature bank 1" },                              /* $78 */
+	{ 9,                      "Exhaust gas temperature bank 2" },                              /* $79 */
+	{ 7,                      "Diesel particulate filter bank 1" },                            /* $7A */
+	{ 7,                      "Diesel particulate filter bank 2" },                            /* $7B */
+	{ 9,                      "Diesel particulate filter temperature" },                       /* $7C */
+	{ 1,                      "NOx NTE control area status" },                                 /* $7D */
+	{ 1,                      "PM NTE control area status" },                                  /* $7E */
+	{ 13,                     "Engine run time" },                                             /* $7F */
+	{ 4,                      "PIDs supported [$81 - $A0]" },                                  /* $80 */
+	{ 41,                     "Engine run time for AECD #1 - #5" },                            /* $81 */
+	{ 41,                     "Engine run time for AECD #6 - #10" },                           /* $82 */
+	{ 9,                      "NOx sensor" },                                                  /* $83 */
+	{ 1,                      "Manifold surface temperature" },                                /* $84 */
+	{ 10,                     "NOx reagent system" },                                          /* $85 */
+	{ 5,                      "Particulate matter sensor" },                                   /* $86 */
+	{ 5,                      "Intake manifold absolute pressure" },                           /* $87 */
+	{ 13,                     "SCR inducement system" },                                       /* $88 */
+	{ 41,                     "Engine run time for AECD #11 - #15" },                          /* $89 */
+	{ 41,                     "Engine run time for AECD #16 - #20" },                          /* $8A */
+	{ 7,                      "Diesel aftertreatment" },                                       /* $8B */
+	{ 17,                     "Wide range oxygen sensors" },                                   /* $8C */
+	{ 1,                      "Throttle position G" },                                         /* $8D */
+	{ 1,                      "Engine friction percent torque" },                              /* $8E */
+	{ 7,                      "Particulate matter sensor bank 1 and 2" },                      /* $8F */
+	{ 3,                      "WWH-OBD vehicle OBD system information" },                      /* $90 */
+	{ 5,                      "WWH-OBD ECU OBD system information" },                          /* $91 */
+	{ 2,                      "Fuel system control" },                                         /* $92 */
+	{ 3,                      "WWH-OBD vehicle OBD counters" },                                /* $93 */
+	{ 12,                     "NOx warning and inducement system" },                           /* $94 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $95 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $96 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $97 */
+	{ 9,                      "Exhaust gas temperature sensors bank 1" },                      /* $98 */
+	{ 9,                      "Exhaust gas temperature sensors bank 2" },                      /* $99 */
+	{ 6,                      "Hybrid/EV vehicle system data" },                               /* $9A */
+	{ 4,                      "Diesel exhaust fluid sensor data" },                            /* $9B */
+	{ 17,                     "Oxygen sensor data" },                                          /* $9C */
+	{ 4,                      "Engine fuel rate" },                                            /* $9D */
+	{ 2,                      "Engine exhaust flow rate" },                                    /* $9E */
+	{ 9,                      "Fuel system percentage use" },                                  /* $9F */
+	{ 4,                      "PIDs supported [$A1 - $C0]" },                                  /* $A0 */
+	{ 9,                      "NOx sensor corrected data" },                                   /* $A1 */
+	{ 2,                      "Cylinder fuel rate" },                                          /* $A2 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A3 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A4 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A5 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A6 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A7 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A8 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $A9 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $AA */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $AB */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $AC */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $AD */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $AE */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $AF */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B0 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B1 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B2 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B3 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B4 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B5 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B6 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B7 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B8 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $B9 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $BA */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $BB */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $BC */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $BD */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $BE */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $BF */
+	{ 4,                      "PIDs supported [$C1 - $E0]" },                                  /* $C0 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C1 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C2 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C3 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C4 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C5 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C6 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C7 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C8 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $C9 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $CA */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $CB */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $CC */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $CD */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $CE */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $CF */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D0 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D1 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D2 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D3 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D4 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D5 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D6 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D7 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D8 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $D9 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $DA */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $DB */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $DC */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $DD */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $DE */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $DF */
+	{ 4,                      "PIDs supported [$E1 - $FF]" },                                  /* $E0 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E1 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E2 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E3 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E4 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E5 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E6 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E7 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E8 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $E9 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $EA */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $EB */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $EC */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $ED */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $EE */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $EF */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F0 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F1 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F2 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F3 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F4 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F5 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F6 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F7 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F8 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $F9 */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $FA */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $FB */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $FC */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $FD */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $FE */
+	{ SID1_PID_UNKNOWN_SIZE,  NULL },                                                          /* $FF */
+};
+
+/*
+*******************************************************************************
+** GetSid1PidDesc -
+** Function to get the descriptor of a SID $1 PID.
+*******************************************************************************
+*/
+const SID1_PID_DESC *GetSid1PidDesc (unsigned char Pid)
+{
+	return (&Sid1PidDesc[Pid]);
+}
+
+/*
+*******************************************************************************
+** GetSid1PidDataSize -
+** Function to get the number of data bytes in a SID $1 PID response
+** (not including the PID byte).  Returns -1 for PIDs of unknown size.
+*******************************************************************************
+*/
+int GetSid1PidDataSize (unsigned char Pid)
+{
+	int DataSize;
+
+	DataSize = Sid1PidDesc[Pid].DataSize;
+	if ( DataSize == SID1_PID_VARIABLE_SIZE )
+	{
+		/* 1 or 2 byte PIDs, unknown until DetermineVariablePidSize has run */
+		DataSize = (gSid1VariablePidSize > 0) ? (int)gSid1VariablePidSize : -1;
+	}
+
+	return (DataSize);
+}
+
+/*
+********************************************************************************
+**
+**	FUNCTION    SaveSid1PackedData
+**
+**	PURPOSE     Split the response to a packed (multiple PID) SID $1 request
+**	            into one SID1 entry per PID in gOBDResponse[].Sid1Pid.
+**
+********************************************************************************
+*/
+STATUS SaveSid1PackedData (PASSTHRU_MSG *RxMsg, unsigned long EcuIndex)
+{
+	unsigned long HeaderSize;
+	unsigned long ByteIndex;
+	unsigned long NumPids;
+	unsigned char Pid;
+	int           PidSize;
+	SID1         *pSid1;
+
+	HeaderSize = gOBDList[gOBDListIndex].HeaderSize;
+
+	pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
+	memset( &gOBDResponse[EcuIndex].Sid1Pid[0], 0x00, sizeof(gOBDResponse[EcuIndex].Sid1Pid) );
+	gOBDResponse[EcuIndex].Sid1PidSize = 0;
+
+	NumPids = 0;
+	for ( ByteIndex = HeaderSize + 1; ByteIndex < RxMsg->DataSize; ByteIndex += PidSize + 1 )
+	{
+		Pid = RxMsg->Data[ByteIndex];
+
+		/* The size of each PID is needed to find the next one */
+		PidSize = GetSid1PidDataSize (Pid);
+		if ( PidSize < 0 )
+		{
+			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "ECU %X  SID $1 PID $%02X of unknown size in multiple PID response\n",
+			     GetEcuId(EcuIndex),
+			     Pid );
+			return(FAIL);
+		}
+
+		if ( (ByteIndex + 1 + PidSize) > RxMsg->DataSize )
+		{
+			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "ECU %X  SID $1 PID $%02X has %d data bytes (should be %d)\n",
+			     GetEcuId(EcuIndex),
+			     Pid,
+			     (RxMsg->DataSize - (ByteIndex + 1)),
+			     PidSize );
+			return(FAIL);
+		}
+
+		if ( NumPids >= MAX_SID1_PACKED_PIDS )
+		{
+			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "ECU %X  SID $1 response data exceeded buffer size\n",
+			     GetEcuId(EcuIndex) );
+			return(FAIL);
+		}
+
+		/* Check if this is a response to an unsupported PID */
+		if ( gIgnoreUnsupported == FALSE &&
+		     IsSid1PidSupported (EcuIndex, Pid) == FALSE )
+		{
+			Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "ECU %X  Unsupported SID $1 PID $%02X detected\n",
+			     GetEcuId(EcuIndex),
+			     Pid );
+		}
+
+		pSid1[NumPids].PID = Pid;
+		memcpy( &pSid1[NumPids].Data[0], &RxMsg->Data[ByteIndex + 1], PidSize );
+		SampleCacheSaveSid1 (EcuIndex, &pSid1[NumPids]);
+		NumPids++;
+	}
+
+	gOBDResponse[EcuIndex].Sid1PidSize = (unsigned short)(NumPids * sizeof(SID1));
+
+	return(PASS);
+}
+
 /*
 ********************************************************************************
 **
@@ -1431,108 +1505,176 @@ void ChkIFRAdjust (PASSTHRU_MSG *RxMsg)
 */
 STATUS LookupEcuIndex (PASSTHRU_MSG *RxMsg, unsigned long *pulEcuIndex)
 {
+	ECU_REGISTRY_ENTRY *pEntry;
 	unsigned long HeaderSize;
 	unsigned long EcuIndex;
 	unsigned long ByteIndex;
 	unsigned long EcuId = 0;
 
-	BOOL bTestFailed = FALSE;
-
 	/* Set the response header size based on the protocol */
 	HeaderSize = gOBDList[gOBDListIndex].HeaderSize;
 
-	/* Find the appropriate EcuIndex based on the header information */
-	for (EcuIndex = 0; EcuIndex < OBD_MAX_ECUS; EcuIndex++)
+	/* Known ECUs are found by their header in the ECU registry */
+	pEntry = EcuRegistryLookup (&RxMsg->Data[0], HeaderSize);
+	if (pEntry != NULL && pEntry->EcuIndex != ECU_REGISTRY_NONE)
 	{
-		/* Check if we have a header match */
-		for (ByteIndex = 0; ByteIndex < HeaderSize; ByteIndex++)
-		{
-			if (RxMsg->Data[ByteIndex] != gOBDResponse[EcuIndex].Header[ByteIndex])
-			{
-				/*
-				** If ISO14230 protocol,
-				** ignore the length bits in the first byte of header
-				*/
-				if ( (gOBDList[gOBDListIndex].Protocol == ISO14230) &&
-				     (ByteIndex == 0))
-				{
-					if ( (RxMsg->Data[ByteIndex] & 0xC0) !=
-					     (gOBDResponse[EcuIndex].Header[ByteIndex] & 0xC0) )
-					{
-						break;
-					}
-				}
-				else
-				{
-					break;
-				}
-			}
-		}
-		/* If no match, check if EcuIndex is empty */
-		if (ByteIndex != HeaderSize)
-		{
-			if (gOBDResponse[EcuIndex].Header[0] == 0x00 &&
-			    gOBDResponse[EcuIndex].Header[1] == 0x00 &&
-			    gOBDResponse[EcuIndex].Header[2] == 0x00 &&
-			    gOBDResponse[EcuIndex].Header[3] == 0x00)
-			{
-				/* if not currently in the process of determining the protocol
-				 * then check every Rx msg's ID
-				 */
-				if (gOBDDetermined == TRUE)
-				{
-					if (VerifyEcuID (&RxMsg->Data[0]) == FAIL)
-					{
-						/* create the ECU ID for later use */
-						for (ByteIndex = 0; ByteIndex < HeaderSize; ByteIndex++)
-						{
-							EcuId = (EcuId << 8) + (RxMsg->Data[ByteIndex]);
-						}
-
-						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-						     "Response from ECU %X not in initial list\n", EcuId );
-						bTestFailed = TRUE;
-						break;
-					}
-				}
+		*pulEcuIndex = pEntry->EcuIndex;
+		return(PASS);
+	}
 
-				/* If empty, add the new response */
-				memcpy(&gOBDResponse[EcuIndex].Header[0], &RxMsg->Data[0], HeaderSize);
-				break;
-			}
-		}
-		else
+	/* New header, find the first empty EcuIndex */
+	for (EcuIndex = 0; EcuIndex < gOBDEcuCapacity; EcuIndex++)
+	{
+		if (gOBDResponse[EcuIndex].Header[0] == 0x00 &&
+		    gOBDResponse[EcuIndex].Header[1] == 0x00 &&
+		    gOBDResponse[EcuIndex].Header[2] == 0x00 &&
+		    gOBDResponse[EcuIndex].Header[3] == 0x00)
 		{
-			/* We have a header match */
 			break;
 		}
 	}
 
 	*pulEcuIndex = EcuIndex;
 
-	if ( EcuIndex == OBD_MAX_ECUS )
+	/* if not currently in the process of determining the protocol
+	 * then check every Rx msg's ID
+	 */
+	if (gOBDDetermined == TRUE)
+	{
+		if (VerifyEcuID (&RxMsg->Data[0]) == FAIL)
+		{
+			/* create the ECU ID for later use */
+			for (ByteIndex = 0; ByteIndex < HeaderSize; ByteIndex++)
+			{
+				EcuId = (EcuId << 8) + (RxMsg->Data[ByteIndex]);
+			}
+
+			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "Response from ECU %X not in initial list\n", EcuId );
+			return(FAIL);
+		}
+	}
+
+	/* Grow the ECU tables if all entries are used (only while determining the protocol) */
+	if ( pEntry == NULL || EcuTableReserveEcu (&RxMsg->Data[0], EcuIndex + 1) != PASS )
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Too many OBD ECU responses\n" );
-		bTestFailed = TRUE;
+		return(FAIL);
 	}
 
+	/* If empty, add the new response */
+	memcpy(&gOBDResponse[EcuIndex].Header[0], &RxMsg->Data[0], HeaderSize);
+	pEntry->EcuIndex = EcuIndex;
+
+	return(PASS);
+}
+
+
+/*
+** Records already saved by each ECU for the current request, for
+** IsMessageUnique.  The set holds the offsets of the saved records in
+** open addressed slots hashed on the record bytes.  A slot is in use only
+** if it has the set's Generation, so the set is emptied in O(1) by
+** bumping Generation when the ECU's response data is reset or a
+** different SID (or record size) is checked.
+*/
+#define DUP_SET_SIZE      1024      /* power of 2 */
+#define DUP_MIN_MSG_SIZE  3         /* smaller records could fill more than 2/3 of the slots */
+
+typedef struct
+{
+	unsigned long  Generation;
+	unsigned short Offset;          /* record offset in the response data */
+} DUP_SLOT;
+
+typedef struct
+{
+	SID_DATA      *pSidData;        /* response data the records belong to */
+	unsigned short usMsgSize;       /* record size */
+	unsigned short usIndexed;       /* bytes of response data entered in the set */
+	unsigned long  Generation;
+	DUP_SLOT       Slot[DUP_SET_SIZE];
+} DUP_SET;
+
+static DUP_SET *pDupSet[OBD_MAX_ECUS];
 
-	if ( bTestFailed == TRUE )
+/*
+*******************************************************************************
+** DupSetEmpty - Function to empty a duplicate record set
+*******************************************************************************
+*/
+static void DupSetEmpty (DUP_SET *pSet)
+{
+	if (++pSet->Generation == 0)
 	{
-		return(FAIL);
+		memset (pSet->Slot, 0, sizeof(pSet->Slot));
+		pSet->Generation = 1;
 	}
+	pSet->usIndexed = 0;
+}
 
-	return(PASS);
+/*
+*******************************************************************************
+** DupSetReset - Function to empty the duplicate record set of an ECU when
+**               its response data is reset
+*******************************************************************************
+*/
+void DupSetReset (unsigned long EcuIndex)
+{
+	if (EcuIndex < OBD_MAX_ECUS && pDupSet[EcuIndex] != NULL)
+	{
+		DupSetEmpty (pDupSet[EcuIndex]);
+	}
 }
 
+/*
+********************************************************************************
+**
+**	FUNCTION    DupSetFind
+**
+**	PURPOSE     Find the record in the set, or the empty slot for it
+**
+**	RETURNS     TRUE if the record is in the set
+**
+********************************************************************************
+*/
+static BOOL DupSetFind (DUP_SET *pSet, const unsigned char *pucData,
+                        const unsigned char *pucMsg, DUP_SLOT **ppSlot)
+{
+	unsigned long  Hash = 2166136261UL;    /* FNV-1a */
+	unsigned short x;
+	DUP_SLOT      *pSlot;
+
+	for (x = 0; x < pSet->usMsgSize; x++)
+	{
+		Hash = ((Hash ^ pucMsg[x]) * 16777619UL) & 0xFFFFFFFFUL;
+	}
+
+	for (Hash &= DUP_SET_SIZE - 1; ; Hash = (Hash + 1) & (DUP_SET_SIZE - 1))
+	{
+		pSlot = &pSet->Slot[Hash];
+		if (pSlot->Generation != pSet->Generation)
+		{
+			*ppSlot = pSlot;
+			return FALSE;
+		}
+
+		if (memcmp (&pucData[pSlot->Offset], pucMsg, pSet->usMsgSize) == 0)
+		{
+			*ppSlot = pSlot;
+			return TRUE;
+		}
+	}
+}
 
 /*
 ********************************************************************************
 **
 **	FUNCTION    IsMessageUnique
 **
-**	PURPOSE     Check to see if this is a duplicate message
+**	PURPOSE     Check to see if this is a duplicate message, that is, the
+**	            same bytes as one of the usMsgSize records saved so far
 **
 **	RETURNS     PASS - message is unique
 **	            FAIL - message is a duplicate
@@ -1541,32 +1683,70 @@ STATUS LookupEcuIndex (PASSTHRU_MSG *RxMsg, unsigned long *pulEcuIndex)
 */
 STATUS IsMessageUnique
           (
-            unsigned char *pucBuffer,   /* pointer to buffer */
-            unsigned short usSize,      /* size of buffer */
+            unsigned long  EcuIndex,    /* ECU of the message */
+            SID_DATA      *pSidData,    /* response data saved so far */
             unsigned char *pucMsg,      /* pointer to message to be checked */
             unsigned short usMsgSize    /* size of message */
           )
 {
-	unsigned short i;
-	unsigned short x;
-	BOOL bDone = FALSE;
+	DUP_SET             *pSet;
+	DUP_SLOT            *pSlot;
+	const unsigned char *pucData;
+	unsigned short       i;
+
+	pucData = SidDataPtr (pSidData);
 
-	for (i = 0, x = 0; (i < usSize) && (x < usMsgSize); i += usMsgSize)
+	if (usMsgSize == 0)
 	{
-		x = 0;
+		return(PASS);
+	}
+
+	pSet = NULL;
+	if (EcuIndex < OBD_MAX_ECUS && usMsgSize >= DUP_MIN_MSG_SIZE)
+	{
+		/* Generation 0 marks the slots of a new set empty */
+		if (pDupSet[EcuIndex] == NULL)
+		{
+			pDupSet[EcuIndex] = (DUP_SET *)calloc (1, sizeof(DUP_SET));
+		}
+		pSet = pDupSet[EcuIndex];
+	}
 
-		while ( (pucBuffer[i + x] == pucMsg[x]) && (x < usMsgSize) && ((i + x) < usSize) )
+	/* Records too short for the set (or no set), compare with each record */
+	if (pSet == NULL)
+	{
+		for (i = 0; i + usMsgSize <= pSidData->Size; i += usMsgSize)
 		{
-			x++;
+			if (memcmp (&pucData[i], pucMsg, usMsgSize) == 0)
+			{
+				return(FAIL);
+			}
 		}
+		return(PASS);
+	}
 
-		if (x == usMsgSize)
+	/* Start over for other response data (a reset is handled by DupSetReset) */
+	if (pSet->Generation == 0 ||
+	    pSet->pSidData != pSidData ||
+	    pSet->usMsgSize != usMsgSize)
+	{
+		DupSetEmpty (pSet);
+		pSet->pSidData  = pSidData;
+		pSet->usMsgSize = usMsgSize;
+	}
+
+	/* Enter the records saved since the last check */
+	while (pSet->usIndexed + usMsgSize <= pSidData->Size)
+	{
+		if (DupSetFind (pSet, pucData, &pucData[pSet->usIndexed], &pSlot) == FALSE)
 		{
-			bDone = TRUE;
+			pSlot->Generation = pSet->Generation;
+			pSlot->Offset     = pSet->usIndexed;
 		}
+		pSet->usIndexed += usMsgSize;
 	}
 
-	if (bDone == TRUE)
+	if (DupSetFind (pSet, pucData, pucMsg, &pSlot) == TRUE)
 	{
 		return(FAIL);
 	}
@@ -91,6 +91,10 @@ void StopTest (STATUS ExitCode, TEST_PHASE eTestPhase)
 		PassThruClose (gulDeviceID);
 	}
 
+	/* write out anything queued for the log file (also on Ctrl-C / abort) */
+	LogWriterStop ();
+	TraceFileClose ();
+
 	/* close any open log files */
 	_fcloseall ();
 
@@ -0,0 +1,275 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** Supported PID/MID/TID/INF bitmaps for SIDs $1, $2, $6, $8 and $9.
+** Each ECU has a 256 bit map built from its ID_SUPPORT data (bit n set if
+** ID n is supported), and each SID has the union of the first gUserNumEcus
+** maps for the any-ECU (EcuIndex -1) queries.  A map is only rebuilt after a
+** support request ($00/$20/...) has been reset or saved for that ECU and SID.
+*/
+#define SUPPORT_MAP_NUM_SIDS    5
+#define SUPPORT_MAP_WORDS       (MAX_PIDS / 32)
+
+typedef struct
+{
+	BOOL          fValid;
+	unsigned long Bits[SUPPORT_MAP_WORDS];
+} SUPPORT_MAP;
+
+static SUPPORT_MAP   EcuMap[SUPPORT_MAP_NUM_SIDS][OBD_MAX_ECUS];
+static SUPPORT_MAP   UnionMap[SUPPORT_MAP_NUM_SIDS];
+static unsigned long UnionNumEcus[SUPPORT_MAP_NUM_SIDS];
+static SUPPORT_MAP   EmptyMap;      /* for ECUs beyond the ECU table */
+
+/* bit number of a single bit word, indexed by (bit * 0x077CB531) >> 27 */
+static const unsigned char DeBruijnBit[32] =
+{
+	 0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+	31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+};
+
+/*
+*******************************************************************************
+** SupportMapIndex - Function to get the map index of a SID, -1 if the SID
+**                   has no support map
+*******************************************************************************
+*/
+static int SupportMapIndex (unsigned char Sid)
+{
+	switch (Sid)
+	{
+		case 0x01: return 0;
+		case 0x02: return 1;
+		case 0x06: return 2;
+		case 0x08: return 3;
+		case 0x09: return 4;
+	}
+	return -1;
+}
+
+/*
+*******************************************************************************
+** SupportIdBits - Function to get the four support bytes of one ID_SUPPORT
+**                 element (IDs Element * 32 + 1 to Element * 32 + 32)
+*******************************************************************************
+*/
+static unsigned char *SupportIdBits (int Map, unsigned long EcuIndex, unsigned long Element)
+{
+	switch (Map)
+	{
+		case 0:  return gOBDResponse[EcuIndex].Sid1PidSupport[Element].IDBits;
+		case 1:  return gOBDResponse[EcuIndex].Sid2PidSupport[Element].IDBits;
+		case 2:  return gOBDResponse[EcuIndex].Sid6MidSupport[Element].IDBits;
+		case 3:  return gOBDResponse[EcuIndex].Sid8TidSupport[Element].IDBits;
+		default: return gOBDResponse[EcuIndex].Sid9InfSupport[Element].IDBits;
+	}
+}
+
+/*
+*******************************************************************************
+** SupportMapGet - Function to get an up to date support map, EcuIndex -1
+**                 for the union of all ECUs
+*******************************************************************************
+*/
+static const SUPPORT_MAP *SupportMapGet (int Map, unsigned long EcuIndex)
+{
+	SUPPORT_MAP   *pMap;
+	unsigned char *pIdBits;
+	unsigned long  Element;
+	unsigned long  Bit;
+	unsigned long  Id;
+	unsigned long  Word;
+
+	if ((signed long)EcuIndex < 0)
+	{
+		pMap = &UnionMap[Map];
+		if (pMap->fValid == TRUE && UnionNumEcus[Map] == gUserNumEcus)
+		{
+			return pMap;
+		}
+
+		memset (pMap->Bits, 0, sizeof(pMap->Bits));
+		for (EcuIndex = 0; EcuIndex < gUserNumEcus && EcuIndex < gOBDEcuCapacity; EcuIndex++)
+		{
+			const SUPPORT_MAP *pEcuMap = SupportMapGet (Map, EcuIndex);
+
+			for (Word = 0; Word < SUPPORT_MAP_WORDS; Word++)
+			{
+				pMap->Bits[Word] |= pEcuMap->Bits[Word];
+			}
+		}
+		UnionNumEcus[Map] = gUserNumEcus;
+		pMap->fValid = TRUE;
+		return pMap;
+	}
+
+	if (EcuIndex >= gOBDEcuCapacity)
+	{
+		return &EmptyMap;
+	}
+
+	pMap = &EcuMap[Map][EcuIndex];
+	if (pMap->fValid == TRUE)
+	{
+		return pMap;
+	}
+
+	memset (pMap->Bits, 0, sizeof(pMap->Bits));
+	for (Element = 0; Element < 8; Element++)
+	{
+		pIdBits = SupportIdBits (Map, EcuIndex, Element);
+		if ((pIdBits[0] | pIdBits[1] | pIdBits[2] | pIdBits[3]) == 0)
+		{
+			continue;
+		}
+
+		/* IDBits are MSB first, the first bit is ID Element * 32 + 1 */
+		for (Bit = 0; Bit < 32; Bit++)
+		{
+			Id = (Element << 5) + Bit + 1;
+			if (Id < MAX_PIDS &&
+			    (pIdBits[Bit >> 3] & (0x80 >> (Bit & 0x07))) != 0)
+			{
+				pMap->Bits[Id >> 5] |= 1UL << (Id & 0x1F);
+			}
+		}
+	}
+	pMap->fValid = TRUE;
+	return pMap;
+}
+
+/*
+*******************************************************************************
+** SupportMapInvalidate - Function to mark the support map of an ECU out of
+**                        date after its support data for SID has changed
+*******************************************************************************
+*/
+void SupportMapInvalidate (unsigned char Sid, unsigned long EcuIndex)
+{
+	int Map;
+
+	Map = SupportMapIndex (Sid);
+	if (Map < 0 || EcuIndex >= OBD_MAX_ECUS)
+	{
+		return;
+	}
+
+	EcuMap[Map][EcuIndex].fValid = FALSE;
+	UnionMap[Map].fValid = FALSE;
+}
+
+/*
+*******************************************************************************
+** SupportMapInvalidateAll - Function to mark all support maps out of date
+**                           (e.g. after gOBDResponse is restored)
+*******************************************************************************
+*/
+void SupportMapInvalidateAll (void)
+{
+	int           Map;
+	unsigned long EcuIndex;
+
+	for (Map = 0; Map < SUPPORT_MAP_NUM_SIDS; Map++)
+	{
+		for (EcuIndex = 0; EcuIndex < OBD_MAX_ECUS; EcuIndex++)
+		{
+			EcuMap[Map][EcuIndex].fValid = FALSE;
+		}
+		UnionMap[Map].fValid = FALSE;
+	}
+}
+
+/*
+*******************************************************************************
+** SupportMapTest - Function to determine if ID is supported by an ECU for
+**                  SID, EcuIndex -1 for any ECU
+*******************************************************************************
+*/
+unsigned int SupportMapTest (unsigned char Sid, unsigned long EcuIndex, unsigned int Id)
+{
+	const SUPPORT_MAP *pMap;
+	int                Map;
+
+	Map = SupportMapIndex (Sid);
+	if (Map < 0 || Id >= MAX_PIDS)
+	{
+		return FALSE;
+	}
+
+	pMap = SupportMapGet (Map, EcuIndex);
+	return ((pMap->Bits[Id >> 5] >> (Id & 0x1F)) & 1) ? TRUE : FALSE;
+}
+
+/*
+*******************************************************************************
+** SupportMapNext - Function to get the next ID after Id that is supported by
+**                  an ECU for SID, EcuIndex -1 for any ECU.  Returns MAX_PIDS
+**                  when there are no more.  SupportMapNext (Sid, EcuIndex, 0)
+**                  is the first supported ID.
+*******************************************************************************
+*/
+unsigned int SupportMapNext (unsigned char Sid, unsigned long EcuIndex, unsigned int Id)
+{
+	const SUPPORT_MAP *pMap;
+	unsigned long      Word;
+	int                Map;
+
+	Map = SupportMapIndex (Sid);
+	if (Map < 0)
+	{
+		return MAX_PIDS;
+	}
+
+	pMap = SupportMapGet (Map, EcuIndex);
+	for (Id++; Id < MAX_PIDS; Id = (Id | 0x1F) + 1)
+	{
+		Word = pMap->Bits[Id >> 5] >> (Id & 0x1F);
+		if (Word != 0)
+		{
+			Word = ((Word & (0 - Word)) * 0x077CB531UL) & 0xFFFFFFFFUL;
+			return Id + DeBruijnBit[Word >> 27];
+		}
+	}
+	return MAX_PIDS;
+}
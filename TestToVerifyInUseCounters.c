@@ -135,7 +135,7 @@ StaticTextElement  _string_elements10[] =
 
 	{"Test Status:", 60, TEST_STATUS_ROW},
 
-	{"Press ESC to abort the Drive Cycle and fail the test", 1, BOTTOM_ROW},
+	{"Press ESC to abort the Drive Cycle and fail the test, N to show the next ECUs", 1, BOTTOM_ROW},
 	{"", 0, BOTTOM_ROW+1},
 };
 
@@ -173,7 +173,7 @@ StaticTextElement  _string_elements10RPM[] =
 
 	{"Test Status:", 60, TEST_STATUS_ROW},
 
-	{"Press ESC to abort the Drive Cycle and fail the test", 1, BOTTOM_ROW},
+	{"Press ESC to abort the Drive Cycle and fail the test, N to show the next ECUs", 1, BOTTOM_ROW},
 	{"", 0, BOTTOM_ROW+1},
 };
 
@@ -299,6 +299,72 @@ const int _num_dynamic_elements10 = sizeof(_dynamic_elements10)/sizeof(_dynamic_
 SID9IPT Test10_10_Sid9FEOCNTR[OBD_MAX_ECUS];
 SID9IPT Last_Sid9IPT[OBD_MAX_ECUS];
 
+/* The ECU columns show one page of OBD_ECUS_PER_PAGE ECUs */
+static unsigned int EcuPage = 0;
+
+
+/*
+*******************************************************************************
+** SetEcuFieldDec - set the column of EcuIndex if it is on the current page
+*******************************************************************************
+*/
+static void SetEcuFieldDec (int Field, unsigned int EcuIndex, unsigned int Value)
+{
+	if (EcuIndex / OBD_ECUS_PER_PAGE == EcuPage)
+	{
+		SetFieldDec (Field + EcuIndex % OBD_ECUS_PER_PAGE, Value);
+	}
+}
+
+
+/*
+*******************************************************************************
+** DisplayEcuPage - redraw the ECU columns for the ECUs on Page
+*******************************************************************************
+*/
+static void DisplayEcuPage (unsigned int Page, unsigned int bSid9Ipt,
+                            const SID9IPT Sid9Ipt[], const SID9IPT Sid9FEOCNTR[])
+{
+	static const int EcuFields[] = {ECU_ID, INITIAL_OBDCOND, CURRENT_OBDCOND, INITIAL_IGNCTR,
+	                                CURRENT_IGNCTR, INITIAL_FEOCNTR, CURRENT_FEOCNTR};
+	unsigned int Column, EcuIndex, Field;
+
+	EcuPage = Page;
+	for (Column = 0; Column < OBD_ECUS_PER_PAGE; Column++)
+	{
+		for (Field = 0; Field < sizeof(EcuFields)/sizeof(EcuFields[0]); Field++)
+		{
+			SetFieldText (EcuFields[Field] + Column, "");
+		}
+
+		EcuIndex = Page * OBD_ECUS_PER_PAGE + Column;
+		if (EcuIndex >= gUserNumEcus)
+		{
+			continue;
+		}
+
+		SetFieldHex (ECU_ID + Column, GetEcuId (EcuIndex));
+		SetFieldDec (INITIAL_OBDCOND + Column, Test10_10_Sid9Ipt[EcuIndex].IPT[0]);
+		SetFieldDec (INITIAL_IGNCTR + Column, Test10_10_Sid9Ipt[EcuIndex].IPT[1]);
+
+		// current values once read, always if INF 8/B not supported
+		if ( bSid9Ipt == 0 || Sid9Ipt[EcuIndex].Flags != 0 )
+		{
+			SetFieldDec (CURRENT_OBDCOND + Column, Sid9Ipt[EcuIndex].IPT[0]);
+			SetFieldDec (CURRENT_IGNCTR + Column,  Sid9Ipt[EcuIndex].IPT[1]);
+		}
+
+		if ( gOBDPlugInFlag == TRUE )
+		{
+			SetFieldDec (INITIAL_FEOCNTR + Column, Test10_10_Sid9FEOCNTR[EcuIndex].IPT[0]);
+			if ( Sid9FEOCNTR[EcuIndex].Flags != 0 )
+			{
+				SetFieldDec (CURRENT_FEOCNTR + Column, Sid9FEOCNTR[EcuIndex].IPT[0]);
+			}
+		}
+	}
+}
+
 
 
 
@@ -341,12 +407,14 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
 	else if ( (VerifyVehicleState(gOBDEngineRunning, gOBDHybridFlag) != PASS) ||
 	          (gOBDTestSubsectionFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -354,6 +422,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -377,6 +446,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -384,6 +454,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -398,6 +469,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	eResults = StartLogFile(pbTestReEntered);
 	if ( eResults == FAIL )
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -426,6 +498,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -433,6 +506,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -461,6 +535,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -468,6 +543,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -497,6 +573,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -504,6 +581,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -530,6 +608,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -537,6 +616,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -560,6 +640,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -567,6 +648,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -590,6 +672,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -597,6 +680,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -620,6 +704,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -627,6 +712,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -644,6 +730,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 		if ( Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT,
 		          "Verify IPT Stored Data.\n" ) == 'N' )
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			return(FAIL);
 		}
@@ -658,6 +745,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	            (gUserInput.eComplianceType == OBDBr_NO_IUMPR) ) )
 	{
 		/* allowed to skip the CARB Drive Cycle */
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return PASS;
 	}
@@ -680,10 +768,12 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -701,12 +791,14 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
 	else if ( (VerifyVehicleState(gOBDEngineRunning, gOBDHybridFlag) != PASS) ||
 	          (gOBDTestSubsectionFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -714,6 +806,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -728,7 +821,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 
 	StopPeriodicMsg (TRUE);
-	Sleep (gOBDRequestDelay);
+	PacingWaitForRequest ();
 
 	gSuspendScreenOutput = TRUE;
 	eResults = RunDynamicTest10 (tEngineStartTimeStamp);
@@ -748,6 +841,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Errors detected during dynamic test.  View Logfile for more details.\n");
 
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -755,6 +849,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -784,6 +879,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -791,6 +887,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -824,6 +921,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -831,6 +929,7 @@ STATUS TestToVerifyInUseCounters (BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -876,6 +975,7 @@ STATUS StartLogFile (BOOL *pbTestReEntered)
 
 	/* Check for log file from Tests 5.xx - 9.xx  */
 	strcat (gLogFileName, ".log");
+	LogWriterFlush ();
 	if ( (ghTempLogFile != ghLogFile) && (ghLogFile != NULL) )
 	{
 		fclose (ghLogFile);
@@ -906,6 +1006,7 @@ STATUS StartLogFile (BOOL *pbTestReEntered)
 			return(eResult);
 		}
 
+		LogWriterFlush ();
 		ghLogFile = hTempFileHandle;
 
 		/* log file already exists, go to Test 11.x */
@@ -993,9 +1094,9 @@ STATUS ReadVIN (void)
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
 					/* Check the data to see if it is valid */
-					pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+					pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
-					if (gOBDResponse[EcuIndex].Sid9InfSize != 0)
+					if (gOBDResponse[EcuIndex].Sid9Inf.Size != 0)
 					{
 						NumResponses++;
 						Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -1048,7 +1149,7 @@ STATUS ReadVIN (void)
 			for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 			{
 				/* Check the data to see if it is valid */
-				pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+				pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 				if (pSid9->INF == INF_TYPE_VIN)
 				{
@@ -1078,7 +1179,7 @@ STATUS ReadVIN (void)
 
 						for (
 						      SidIndex = 0;
-						      SidIndex < (gOBDResponse[EcuIndex].Sid9InfSize / sizeof (SID9));
+						      SidIndex < (gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof (SID9));
 						      SidIndex++
 						    )
 						{
@@ -1171,9 +1272,9 @@ STATUS PrintCALIDs (void)
 					continue;
 
 				/* Check the data to see if it is valid */
-				pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+				pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
-				if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+				if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  No SID $9 INF $3 (CALID Count) data\n", GetEcuId(EcuIndex) );
@@ -1251,7 +1352,7 @@ STATUS PrintCVNs (void)
 					continue;
 
 				/* Save the data */
-				pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+				pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 				Inf5NumItems[EcuIndex] = pSid9[0].NumItems;
 			}
 		}
@@ -1421,117 +1522,51 @@ STATUS VerifyIPTData (BOOL *pbIPTSupported)
 //
 // Function:   GetSid9IptData
 //
-// Purpose: Copy from gOBDResponse[EcuIndex].Sid9Inf into common,
-//          protocol-independent format.
+// Purpose: Copy the IPT counters decoded from gOBDResponse[EcuIndex].Sid9Inf
+//          into common, protocol-independent format.
 //
 //*****************************************************************************
 STATUS GetSid9IptData ( unsigned int EcuIndex, SID9IPT *pSid9Ipt )
 {
-	unsigned int    SidIndex;
-	unsigned int	IptIndex;
-	unsigned short *pData;
-	SID9           *pSid9;
-	unsigned int    IPT_MAX;
+	const SID9IPT *pSample;
 	STATUS Result = FAIL;
 
 
 	// clear IPT structure
 	memset (pSid9Ipt, 0, sizeof (SID9IPT));
 
-	// point to IPT structure in gOBDResponse
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
-
 	// check to ensure that gOBDResponse contains IPT data
-	if ( gOBDResponse[EcuIndex].Sid9InfSize == 0 ||
-	     ( pSid9->INF != 0x08 && pSid9->INF != 0x0B ) )
+	// (the sample cache only holds INF $8 / $B responses)
+	pSample = GetSid9IptSample (EcuIndex, NULL);
+	if ( pSample == NULL )
 	{
 		return FAIL;
 	}
 
-	// if ISO15765 protocol
-	if ( gOBDList[gOBDListIndex].Protocol == ISO15765 )
+	// If NOT test 9.19, 10.12 or 11.2, log failures
+	if ( ( TestPhase != eTestNoFault3DriveCycle	|| TestSubsection != 19 ) &&
+	     ( TestPhase != eTestInUseCounters || TestSubsection != 12 ) &&
+	     ( TestPhase != eTestPerformanceCounters || TestSubsection != 2 ) )
 	{
-		memcpy (pSid9Ipt, &(gOBDResponse[EcuIndex].Sid9Inf[0]), sizeof (SID9IPT));
-		memcpy (&Last_Sid9IPT[EcuIndex], &(gOBDResponse[EcuIndex].Sid9Inf[0]), sizeof (SID9IPT));
-
-		// If NOT test 9.19, 10.12 or 11.2, log failures
-		if ( ( TestPhase != eTestNoFault3DriveCycle	|| TestSubsection != 19 ) &&
-		     ( TestPhase != eTestInUseCounters || TestSubsection != 12 ) &&
-		     ( TestPhase != eTestPerformanceCounters || TestSubsection != 2 ) )
+		if ( pSample->INF == 0x08 )
 		{
-			if ( pSid9->INF == 0x08 )
-			{
-				Result = VerifyINF8Data(EcuIndex);
-			}
-			else if ( pSid9->INF == 0x0B )
-			{
-				Result = VerifyINFBData(EcuIndex);
-			}
-
-			if (Result == FAIL)
-			{
-				return (Result);
-			}
-		} //end if !test 9.19 and !test 10.12 and !test11.2
-
-		// point to start of IPT data in structure
-		pData = &(pSid9Ipt->IPT[0]);
-
-		// calculate number of IPT data bytes
-		IPT_MAX = (pSid9Ipt->NODI <= INF_TYPE_IPT_NODI) ? (pSid9Ipt->NODI)*2 : INF_TYPE_IPT_NODI*2;
-
-		// swap low and high bytes
-		for ( SidIndex = 2, IptIndex = 0; SidIndex <= IPT_MAX; SidIndex+=2 )
-		{
-			*pData++ = gOBDResponse[EcuIndex].Sid9Inf[SidIndex] * 256
-			         + gOBDResponse[EcuIndex].Sid9Inf[SidIndex+1];
-			Last_Sid9IPT[EcuIndex].IPT[IptIndex++] = gOBDResponse[EcuIndex].Sid9Inf[SidIndex] * 256
-			                                       + gOBDResponse[EcuIndex].Sid9Inf[SidIndex+1];
+			Result = VerifyINF8Data(EcuIndex);
 		}
-	} // end if ( gOBDList[gOBDListIndex].Protocol == ISO15765 )
-
-	// else Legacy protocols
-	else
-	{
-		pSid9Ipt->INF  = gOBDResponse[EcuIndex].Sid9Inf[0];
-		pSid9Ipt->NODI = (gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9)) * 2; // MessageCount * 2
-
-		Last_Sid9IPT[EcuIndex].INF  = gOBDResponse[EcuIndex].Sid9Inf[0];
-		Last_Sid9IPT[EcuIndex].NODI = (gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9)) * 2; // MessageCount * 2
-
-		// If NOT test 9.19, 10.12 or 11.2, log failures
-		if ( ( TestPhase != eTestNoFault3DriveCycle	|| TestSubsection != 19 ) &&
-		     ( TestPhase != eTestInUseCounters || TestSubsection != 12 ) &&
-		     ( TestPhase != eTestPerformanceCounters || TestSubsection != 2 ) )
+		else if ( pSample->INF == 0x0B )
 		{
-			if ( pSid9->INF == 0x08 )
-			{
-				Result = VerifyINF8Data(EcuIndex);
-			}
-			else if ( pSid9->INF == 0x0B )
-			{
-				Result = VerifyINFBData(EcuIndex);
-			}
-
-			if (Result != PASS)
-			{
-				return (Result);
-			}
+			Result = VerifyINFBData(EcuIndex);
 		}
 
-		// point to start of IPT data
-		pData = &(pSid9Ipt->IPT[0]);
-
-		// save IPT data to structure
-		for ( SidIndex = 0, IptIndex = 0; SidIndex < (gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9)); SidIndex++ )
+		// ISO15765 only rejects the data on FAIL, legacy protocols on any error
+		if ( Result == FAIL ||
+		     ( Result != PASS && gOBDList[gOBDListIndex].Protocol != ISO15765 ) )
 		{
-			*pData++ = pSid9[SidIndex].Data[0] * 256 + pSid9[SidIndex].Data[1];
-			*pData++ = pSid9[SidIndex].Data[2] * 256 + pSid9[SidIndex].Data[3];
-
-			Last_Sid9IPT[EcuIndex].IPT[IptIndex++] = pSid9[SidIndex].Data[0] * 256 + pSid9[SidIndex].Data[1];
-			Last_Sid9IPT[EcuIndex].IPT[IptIndex++] = pSid9[SidIndex].Data[2] * 256 + pSid9[SidIndex].Data[3];
+			return (Result);
 		}
-	}
+	} //end if !test 9.19 and !test 10.12 and !test11.2
+
+	memcpy (pSid9Ipt, pSample, sizeof (SID9IPT));
+	memcpy (&Last_Sid9IPT[EcuIndex], pSample, sizeof (SID9IPT));
 
 	// data structure is valid
 	pSid9Ipt->Flags = 1;
@@ -1776,7 +1811,8 @@ BOOL ReadSid9IptFromLogFile ( const char * szTestSectionStart, const char * szTe
 		return FALSE;
 	}
 
-	// search from beginning of file
+	// search from beginning of file (after the queued log text is written)
+	LogWriterFlush ();
 	fseek (ghLogFile, 0, SEEK_SET);
 
 	while ( fgets (buf, sizeof(buf), ghLogFile) != 0 )
@@ -1851,14 +1887,14 @@ STATUS LogSid9Inf12 ( SID9IPT pSid9Ipt[] )
 	for ( EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++ )
 	{
 		// point to IPT structure in gOBDResponse
-		pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+		pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 		// check to ensure that gOBDResponse contains appropriate data
 		if ( IsSid9InfSupported (EcuIndex, 0x12) == FALSE )
 		{
 			continue;
 		}
-		else if ( gOBDResponse[EcuIndex].Sid9InfSize == 0 ||
+		else if ( gOBDResponse[EcuIndex].Sid9Inf.Size == 0 ||
 		          pSid9->INF != 0x12 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -1875,16 +1911,16 @@ STATUS LogSid9Inf12 ( SID9IPT pSid9Ipt[] )
 			// if ISO15765 protocol
 			if ( gOBDList[gOBDListIndex].Protocol == ISO15765 )
 			{
-				memcpy (&pSid9Ipt[EcuIndex], &(gOBDResponse[EcuIndex].Sid9Inf[0]), sizeof (SID9IPT));
+				memcpy (&pSid9Ipt[EcuIndex], SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf), sizeof (SID9IPT));
 			}
 			// else Legacy protocols
 			else
 			{
-				pSid9Ipt[EcuIndex].INF  = gOBDResponse[EcuIndex].Sid9Inf[0];
-				pSid9Ipt[EcuIndex].NODI = (gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9)) * 2; // MessageCount * 2
+				pSid9Ipt[EcuIndex].INF  = SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 0);
+				pSid9Ipt[EcuIndex].NODI = (gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9)) * 2; // MessageCount * 2
 			}
 
-			pSid9Ipt[EcuIndex].IPT[0] = (gOBDResponse[EcuIndex].Sid9Inf[2] * 256) + gOBDResponse[EcuIndex].Sid9Inf[3];
+			pSid9Ipt[EcuIndex].IPT[0] = (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 2) * 256) + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 3);
 
 			// If NOT test 9.19, 10.12 or 11.2, log
 			if ( ( TestPhase != eTestNoFault3DriveCycle || TestSubsection != 19 ) &&
@@ -1951,7 +1987,7 @@ STATUS VerifySid9Inf12 ( SID9IPT *pSid9Ipt )
 	for ( EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++ )
 	{
 		// point to IPT structure in gOBDResponse
-		pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+		pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 
 		// check to ensure that gOBDResponse contains appropriate data
@@ -1959,7 +1995,7 @@ STATUS VerifySid9Inf12 ( SID9IPT *pSid9Ipt )
 		{
 			continue;
 		}
-		else if ( gOBDResponse[EcuIndex].Sid9InfSize == 0 ||
+		else if ( gOBDResponse[EcuIndex].Sid9Inf.Size == 0 ||
 		          pSid9->INF != 0x12 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -1968,7 +2004,7 @@ STATUS VerifySid9Inf12 ( SID9IPT *pSid9Ipt )
 		}
 		else
 		{
-			FEOCNTR = (gOBDResponse[EcuIndex].Sid9Inf[2] * 256) + gOBDResponse[EcuIndex].Sid9Inf[3];
+			FEOCNTR = (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 2) * 256) + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 3);
 
 			// log FEOCNTRs
 			Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -2030,7 +2066,9 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 	SID_REQ        SidReq;
 	SID9IPT        Sid9Ipt[OBD_MAX_ECUS];
 	SID9IPT        Sid9FEOCNTR[OBD_MAX_ECUS];
-	SID1          *pSid1;
+	ULONGLONG      Sid9IptFingerprint[OBD_MAX_ECUS];   // fingerprint of the IPT data in Sid9Ipt
+	SID9IPT        PrevSid9Ipt;
+	const DECODED_SAMPLE *pSample;
 
 	STATUS eResult = PASS;
 
@@ -2063,15 +2101,11 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 	{
 		for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 		{
-			if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+			pSample = GetSid1Sample (EcuIndex, SAMPLE_OBDSUP);
+			if (pSample->fValid == TRUE)
 			{
-				pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-
-				if (pSid1->PID == 0x1c)
-				{
-					Sid1Pid1C = pSid1->Data[0];
-					break;
-				}
+				Sid1Pid1C = (unsigned char)pSample->lValue;
+				break;
 			}
 		}
 	}
@@ -2107,6 +2141,8 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 	/// Initialize Array */
 	//-------------------------------------------
 	memset ( Sid9Ipt, 0x00, sizeof(Sid9Ipt) );
+	memset ( Sid9FEOCNTR, 0x00, sizeof(Sid9FEOCNTR) );
+	memset ( Sid9IptFingerprint, 0x00, sizeof(Sid9IptFingerprint) );
 
 	if ( IsSid9InfSupported ( -1, 0x08 ) == TRUE )
 	{
@@ -2154,31 +2190,13 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 
 	for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 	{
-		// initialize ECU IDs
-		SetFieldHex (ECU_ID+EcuIndex, GetEcuId (EcuIndex));
-
-		// initialize initial OBDCONDs
-		SetFieldDec (INITIAL_OBDCOND+EcuIndex, Test10_10_Sid9Ipt[EcuIndex].IPT[0]);
-
-		// initialize initial IGNCTRs
-		SetFieldDec (INITIAL_IGNCTR+EcuIndex, Test10_10_Sid9Ipt[EcuIndex].IPT[1]);
-
-		if ( gOBDPlugInFlag == TRUE )
-		{
-			// initialize initial FEOCNTRs
-			SetFieldDec (INITIAL_FEOCNTR+EcuIndex, Test10_10_Sid9FEOCNTR[EcuIndex].IPT[0]);
-		}
-
 		tObdCondTimestamp[EcuIndex] = 0;
-
-		// if INF 8/B not supported, print 0 (INF8/B will never update)
-		if ( bSid9Ipt == 0 )
-		{
-			SetFieldDec (CURRENT_OBDCOND+EcuIndex, Sid9Ipt[EcuIndex].IPT[0]);
-			SetFieldDec (CURRENT_IGNCTR+EcuIndex,  Sid9Ipt[EcuIndex].IPT[1]);
-		 }
 	}
 
+	// initialize ECU IDs and initial OBDCONDs, IGNCTRs and FEOCNTRs of the first ECUs
+	// (if INF 8/B not supported, print 0 current values, INF8/B will never update)
+	DisplayEcuPage (0, bSid9Ipt, Sid9Ipt, Sid9FEOCNTR);
+
 	// flush the STDIN stream of any user input before loop
 	clear_keyboard_buffer ();
 
@@ -2230,7 +2248,7 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 				bPermDTC = FALSE;
 				for ( EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++ )
 				{
-					if ( (gOBDResponse[EcuIndex].SidA[0] != 0x00) || (gOBDResponse[EcuIndex].SidA[1] != 0x00) )
+					if ( (SidDataByte (&gOBDResponse[EcuIndex].SidA, 0) != 0x00) || (SidDataByte (&gOBDResponse[EcuIndex].SidA, 1) != 0x00) )
 					{
 						bPermDTC = TRUE;
 					}
@@ -2273,19 +2291,11 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+					pSample = GetSid1Sample (EcuIndex, SAMPLE_RPM);
+					if (pSample->fValid == TRUE)
 					{
-						pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-
-						if (pSid1->PID == 0x0c)
-						{
-							RPM = pSid1->Data[0];
-							RPM = RPM << 8 | pSid1->Data[1];
-
-							// convert from 1 cnt = 1/4 RPM to 1 cnt = 1 RPM
-							RPM >>= 2;
-							break;
-						}
+						RPM = (unsigned short)pSample->lValue;
+						break;
 					}
 				}
 
@@ -2325,20 +2335,14 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+					pSample = GetSid1Sample (EcuIndex, SAMPLE_VSS);
+					if (pSample->fValid == TRUE)
 					{
-						pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
+						SpeedKPH = (unsigned short)pSample->lValue;
 
-						if (pSid1->PID == 0x0d)
-						{
-							double dTemp = pSid1->Data[0];
-
-							SpeedKPH = pSid1->Data[0];
-
-							// convert from km/hr to mile/hr
-							SpeedMPH = (unsigned short)( ((dTemp * 6214) / 10000) + 0.5 );
-							break;
-						}
+						// convert from km/hr to mile/hr
+						SpeedMPH = (unsigned short)( (((double)pSample->lValue * 6214) / 10000) + 0.5 );
+						break;
 					}
 				}
 
@@ -2378,16 +2382,11 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+					pSample = GetSid1Sample (EcuIndex, SAMPLE_RUNTM);
+					if (pSample->fValid == TRUE)
 					{
-						pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-
-						if (pSid1->PID == 0x1f)
-						{
-							RunTime = pSid1->Data[0];
-							RunTime = RunTime << 8 | pSid1->Data[1];    // 1 cnt = 1 sec
-							break;
-						}
+						RunTime = (unsigned short)pSample->lValue;    // 1 cnt = 1 sec
+						break;
 					}
 				}
 
@@ -2431,10 +2430,26 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 
 				for ( EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++ )
 				{
-					if ( GetSid9IptData (EcuIndex, &Sid9Ipt[EcuIndex]) == PASS )
+					memcpy (&PrevSid9Ipt, &Sid9Ipt[EcuIndex], sizeof(SID9IPT));
+
+					if ( GetSid9IptData (EcuIndex, &Sid9Ipt[EcuIndex]) != PASS )
 					{
-						SetFieldDec (CURRENT_OBDCOND+EcuIndex, Sid9Ipt[EcuIndex].IPT[0]);
-						SetFieldDec (CURRENT_IGNCTR+EcuIndex,  Sid9Ipt[EcuIndex].IPT[1]);
+						// redraw both counters with the next good response
+						Sid9IptFingerprint[EcuIndex] = 0;
+					}
+					else if ( GetSid9IptFingerprint (EcuIndex) != Sid9IptFingerprint[EcuIndex] )
+					{
+						Sid9IptFingerprint[EcuIndex] = GetSid9IptFingerprint (EcuIndex);
+
+						// only redraw the counters that changed
+						if ( PrevSid9Ipt.Flags == 0 || PrevSid9Ipt.IPT[0] != Sid9Ipt[EcuIndex].IPT[0] )
+						{
+							SetEcuFieldDec (CURRENT_OBDCOND, EcuIndex, Sid9Ipt[EcuIndex].IPT[0]);
+						}
+						if ( PrevSid9Ipt.Flags == 0 || PrevSid9Ipt.IPT[1] != Sid9Ipt[EcuIndex].IPT[1] )
+						{
+							SetEcuFieldDec (CURRENT_IGNCTR, EcuIndex,  Sid9Ipt[EcuIndex].IPT[1]);
+						}
 
 						// check when OBDCOND counters increment
 						if ( (tObdCondTimestamp[EcuIndex] == 0) &&
@@ -2469,7 +2484,7 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 			{
 				for ( EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++ )
 				{
-					SetFieldDec (CURRENT_FEOCNTR+EcuIndex, Sid9FEOCNTR[EcuIndex].IPT[0]);
+					SetEcuFieldDec (CURRENT_FEOCNTR, EcuIndex, Sid9FEOCNTR[EcuIndex].IPT[0]);
 				}
 			}
 		}
@@ -2792,7 +2807,8 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 		{
 			if (_kbhit () != 0)
 			{
-				if (_getch () == 27)    // ESC key
+				char c = _getch ();
+				if (c == 27)            // ESC key
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "Drive Cycle Test aborted by user\n\n");
@@ -2801,6 +2817,12 @@ STATUS RunDynamicTest10 (unsigned long tEngineStartTimeStamp)
 					     tIdleTime, tAtSpeedTime, RunTime);
 					return FAIL;
 				}
+
+				if ( ((c == 'N') || (c == 'n')) && gUserNumEcus > OBD_ECUS_PER_PAGE )  // next ECUs
+				{
+					DisplayEcuPage (((EcuPage + 1) * OBD_ECUS_PER_PAGE < gUserNumEcus) ? EcuPage + 1 : 0,
+					                bSid9Ipt, Sid9Ipt, Sid9FEOCNTR);
+				}
 			}
 
 			tDelayTimeStamp = GetTickCount ();
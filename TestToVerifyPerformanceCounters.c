@@ -65,7 +65,8 @@ SID9IPT Test11_5_Sid9Ipt[OBD_MAX_ECUS];
 SID9IPT Test11_11_Sid9Ipt[OBD_MAX_ECUS];
 SID9IPT Test11CurrentDisplayData[OBD_MAX_ECUS];
 
-SID1    PreviousSid1Pid1[OBD_MAX_ECUS];
+ULONGLONG Sid1Pid1Fingerprint[OBD_MAX_ECUS];   // fingerprint of the SID $1 PID $1 data in Test11IMStatus
+ULONGLONG Sid9IptFingerprint[OBD_MAX_ECUS];    // fingerprint of the SID $9 IPT data in Test11CurrentDisplayData
 SID1    Sid1Pid41[OBD_MAX_ECUS];   // capture the response from SID01 PID41 response.
 
 
@@ -91,7 +92,7 @@ const char * szIM_Status[] = {"Complete", "Incomplete", "Not Supported", "Disabl
 const char * szTest_Status[] = {"Normal", "FAILURE"};
 
 BOOL IsIM_ReadinessComplete (SID1 * pSid1);
-BOOL SaveSid9IptData (unsigned int EcuIndex, SID9IPT * pSid9Ipt);
+BOOL SaveSid9IptData (unsigned int EcuIndex, SID9IPT * pSid9Ipt, unsigned long *pDirtyMask);
 STATUS EvaluateSid9Ipt (int EcuIndex, unsigned int *pDoneFlags, int test_stage, BOOL bDisplayErrorMsg);
 STATUS RunDynamicTest11 (BOOL bDisplayCARBTimers, unsigned long ulEngineStartTimeStamp);
 void PrintEcuData ( unsigned int  IMReadyDoneFlags, unsigned int  Sid9IptDoneFlags,
@@ -179,7 +180,7 @@ StaticTextElement  _string_elements11_INF856[] =
 
 	// misc
 	{"Test Status:",              COL1, PRESS_ESC_ROW-1},
-	{"Press ESC to exit, a number to change ECU display, or F to FAIL", COL1, PRESS_ESC_ROW},
+	{"Press ESC to exit, 1-8 or N (next ECUs) to change ECU display, or F to FAIL", COL1, PRESS_ESC_ROW},
 	{"", 0, PRESS_ESC_ROW+1}
 };
 
@@ -241,7 +242,7 @@ StaticTextElement  _string_elements11_INFB36[] =
 
 	// misc
 	{"Test Status:",              COL1, PRESS_ESC_ROW-1},
-	{"Press ESC to exit, a number to change ECU display, or F to FAIL", COL1, PRESS_ESC_ROW},
+	{"Press ESC to exit, 1-8 or N (next ECUs) to change ECU display, or F to FAIL", COL1, PRESS_ESC_ROW},
 	{"", 0, PRESS_ESC_ROW+1}
 };
 
@@ -552,6 +553,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	STATUS        ret_code;
 	BOOL          bRunTest11_2;
 	unsigned int  DoneFlags;        // Bit Map of Items Completed
+	unsigned long DirtyMask;        // Bit Map of IPT counters changed
 
 	SID_REQ       SidReq;
 	SID1        * pSid1;
@@ -561,7 +563,8 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	// initialize arrays
 	memset (BankSupport, FALSE, sizeof(BankSupport));
 	memset (Test11_Sid1Pid1, 0x00, sizeof(Test11_Sid1Pid1));
-	memset (PreviousSid1Pid1, 0x00, sizeof(PreviousSid1Pid1));
+	memset (Sid1Pid1Fingerprint, 0x00, sizeof(Sid1Pid1Fingerprint));
+	memset (Sid9IptFingerprint, 0x00, sizeof(Sid9IptFingerprint));
 
 	memset (Test11_5_Sid9Ipt, 0x00, sizeof(Test11_5_Sid9Ipt));
 	memset (Test11_11_Sid9Ipt, 0x00, sizeof(Test11_11_Sid9Ipt));
@@ -605,6 +608,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "Connect Protocol unsuccessful\n");
+			EndSubsectionStats ();
 			Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			return FAIL;
 		}
@@ -619,6 +623,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "SID 1 PID 1 request unsuccessful\n");
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return FAIL;
 	}
@@ -667,7 +672,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 			if ( GetSid9IptData ( EcuIndex, &Test11_5_Sid9Ipt[EcuIndex] ) == PASS )
 			{
 				// Initialize Test11CurrentDisplayData for first DisplayEcuData
-				SaveSid9IptData ( EcuIndex, &Test11_5_Sid9Ipt[EcuIndex] );
+				SaveSid9IptData ( EcuIndex, &Test11_5_Sid9Ipt[EcuIndex], &DirtyMask );
 
 				ret_code = EvaluateSid9Ipt ( EcuIndex, &DoneFlags, 1, FALSE );
 				// if conditions require running of test 11.2
@@ -692,6 +697,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( bSubTestFailed == TRUE || gOBDTestSubsectionFailed == TRUE )
 	{
+		EndSubsectionStats ();
 		if (
 		     (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT,
 		           "Errors detected that may cause the next test,\n"
@@ -704,6 +710,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -738,6 +745,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 		          "by re-starting the J1699 software and selecting 'Dynamic Tests'.)\n") != 'Y'
 		   )
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_INCOMPLETE_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			ABORT_RETURN;
 		}
@@ -745,7 +753,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 		// stop tester-present message
 		StopPeriodicMsg (TRUE);
-		Sleep (gOBDRequestDelay);
+		PacingWaitForRequest ();
 
 
 		ret_code = RunDynamicTest11 (*pbTestReEntered, ulEngineStartTime);
@@ -762,6 +770,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 		if ( (ret_code == FAIL) || (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 		{
+			EndSubsectionStats ();
 			if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 			{
 				return FAIL;
@@ -769,16 +778,19 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 		}
 		else if ( (ret_code == ABORT) || (gOBDTestSectionAborted == TRUE) )
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_INCOMPLETE_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			ABORT_RETURN;
 		}
 		else
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		}
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -801,6 +813,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	Log( PROMPT, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT,
 	     "Turn key on without cranking or starting engine.\n");
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 	/* Engine should now be not running */
@@ -825,6 +838,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -832,6 +846,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -856,6 +871,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -863,6 +879,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -886,6 +903,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -893,6 +911,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -933,6 +952,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	
 	if ( bSubTestFailed == TRUE || gOBDTestSubsectionFailed == TRUE )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -940,6 +960,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -964,6 +985,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -971,6 +993,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -994,6 +1017,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -1001,6 +1025,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -1024,6 +1049,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -1031,6 +1057,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -1054,6 +1081,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -1061,6 +1089,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -1101,6 +1130,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -1108,6 +1138,7 @@ STATUS TestToVerifyPerformanceCounters(BOOL *pbTestReEntered)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -2123,6 +2154,52 @@ STATUS EvaluateInf14 ( void )
 	return RetCode;
 }
 
+/*
+** The ECU ID and status fields show one page of OBD_ECUS_PER_PAGE ECUs,
+** the status text of every ECU is kept to redraw a page.
+*/
+static unsigned int EcuPage = 0;
+static const char  *EcuStatusText[OBD_MAX_ECUS];
+
+/*
+*******************************************************************************
+** SetEcuStatus
+*******************************************************************************
+*/
+static void SetEcuStatus (unsigned int EcuIndex, const char *szStatus)
+{
+	EcuStatusText[EcuIndex] = szStatus;
+	if (EcuIndex / OBD_ECUS_PER_PAGE == EcuPage)
+		SetFieldText (ECU_STATUS_INDEX + EcuIndex % OBD_ECUS_PER_PAGE, szStatus);
+}
+
+/*
+*******************************************************************************
+** DisplayEcuPage
+*******************************************************************************
+*/
+static void DisplayEcuPage (unsigned int Page)
+{
+	unsigned int Column, EcuIndex;
+
+	EcuPage = Page;
+	for (Column = 0; Column < OBD_ECUS_PER_PAGE; Column++)
+	{
+		EcuIndex = Page * OBD_ECUS_PER_PAGE + Column;
+		if (EcuIndex < gUserNumEcus)
+		{
+			SetFieldHex (ECU_ID_INDEX + Column, GetEcuId(EcuIndex));
+			SetFieldText (ECU_STATUS_INDEX + Column,
+			              (EcuStatusText[EcuIndex] != NULL) ? EcuStatusText[EcuIndex] : "");
+		}
+		else
+		{
+			SetFieldText (ECU_ID_INDEX + Column, "");
+			SetFieldText (ECU_STATUS_INDEX + Column, "");
+		}
+	}
+}
+
 /*
 *******************************************************************************
 ** SelectECU
@@ -2130,19 +2207,18 @@ STATUS EvaluateInf14 ( void )
 */
 void SelectECU (int new_index, int old_index)
 {
-	int index;
-
 	// un-highlite previous selection
 	setrgb (NORMAL_TEXT);
-	index = ECU_ID_INDEX + old_index;
-	if ((ECU_ID_INDEX <= index) && (index <= ECU_ID_INDEX+OBD_MAX_ECUS))
-		SetFieldHex (index, GetEcuId(old_index));
+	if ((old_index >= 0) && ((unsigned int)old_index / OBD_ECUS_PER_PAGE == EcuPage))
+		SetFieldHex (ECU_ID_INDEX + old_index % OBD_ECUS_PER_PAGE, GetEcuId(old_index));
+
+	// show the page of the new selection
+	if ((unsigned int)new_index / OBD_ECUS_PER_PAGE != EcuPage)
+		DisplayEcuPage (new_index / OBD_ECUS_PER_PAGE);
 
 	// highlite new selection
 	setrgb (HIGHLIGHTED_TEXT);
-	index = ECU_ID_INDEX + new_index;
-	if ((ECU_ID_INDEX <= index) && (index <= ECU_ID_INDEX+OBD_MAX_ECUS))
-		SetFieldHex (index, GetEcuId(new_index));
+	SetFieldHex (ECU_ID_INDEX + new_index % OBD_ECUS_PER_PAGE, GetEcuId(new_index));
 
 	// restore screen attributes
 	setrgb (NORMAL_TEXT);
@@ -2216,20 +2292,34 @@ void DisplayEcuData ( int EcuIndex, unsigned int DoneFlags )
 /*
 *******************************************************************************
 ** SaveSid9IptData
+**
+** pSid9Ipt must hold the IPT data just returned by GetSid9IptData.  Sets a
+** bit in *pDirtyMask for each counter that changed (bit n = IPT[n]).
 *******************************************************************************
 */
-BOOL SaveSid9IptData (unsigned int EcuIndex, SID9IPT * pSid9Ipt)
+BOOL SaveSid9IptData (unsigned int EcuIndex, SID9IPT * pSid9Ipt, unsigned long *pDirtyMask)
 {
 	int index;
+	ULONGLONG Fingerprint;
 	BOOL rc = FALSE;
 
 
+	*pDirtyMask = 0;
+
+	// nothing to do if the IPT data has not changed since it was last saved
+	Fingerprint = GetSid9IptFingerprint (EcuIndex);
+	if ( Fingerprint == Sid9IptFingerprint[EcuIndex] )
+	{
+		return FALSE;
+	}
+	Sid9IptFingerprint[EcuIndex] = Fingerprint;
+
 	// save Infotype and NODI
 	Test11CurrentDisplayData[EcuIndex].INF = pSid9Ipt->INF;
 	Test11CurrentDisplayData[EcuIndex].NODI = pSid9Ipt->NODI;
 
 	// copy current counter values for active ECUs
-	for ( index = 0; index < pSid9Ipt->NODI; index++ )
+	for ( index = 0; index < pSid9Ipt->NODI && index < INF_TYPE_IPT_NODI; index++ )
 	{
 		// note changes
 		if ( Test11CurrentDisplayData[EcuIndex].IPT[index] != pSid9Ipt->IPT[index] )
@@ -2237,6 +2327,7 @@ BOOL SaveSid9IptData (unsigned int EcuIndex, SID9IPT * pSid9Ipt)
 			// save current value of rate based counters
 			Test11CurrentDisplayData[EcuIndex].IPT[index] = pSid9Ipt->IPT[index];
 
+			*pDirtyMask |= 1UL << index;
 			rc = TRUE;
 		}
 	}
@@ -2248,28 +2339,40 @@ BOOL SaveSid9IptData (unsigned int EcuIndex, SID9IPT * pSid9Ipt)
 /*
 *******************************************************************************
 ** UpdateSid9IptDisplay
+**
+** Only redraws the counters with a bit set in DirtyMask (bit n = IPT[n]).
 *******************************************************************************
 */
-void UpdateSid9IptDisplay ( unsigned int EcuIndex, unsigned int DoneFlags, SID9IPT * pSid9Ipt )
+void UpdateSid9IptDisplay ( unsigned int EcuIndex, unsigned int DoneFlags, SID9IPT * pSid9Ipt,
+                            unsigned long DirtyMask )
 {
 	int index;
 
 	// update OBDCOND counter
-	if ( (DoneFlags & 0x01) == 0 )
-		setrgb (HIGHLIGHTED_TEXT);
-	SetFieldDec ( OBD_MONITOR_COND_INDEX, Test11CurrentDisplayData[EcuIndex].IPT[0] );
-	setrgb (NORMAL_TEXT);
+	if ( (DirtyMask & 0x01) != 0 )
+	{
+		if ( (DoneFlags & 0x01) == 0 )
+			setrgb (HIGHLIGHTED_TEXT);
+		SetFieldDec ( OBD_MONITOR_COND_INDEX, Test11CurrentDisplayData[EcuIndex].IPT[0] );
+		setrgb (NORMAL_TEXT);
+	}
 
 	// update IGN counter
-	if ( ((DoneFlags>>=1) & 0x01) == 0 )
-		setrgb (HIGHLIGHTED_TEXT);
-	SetFieldDec ( IGNITION_COUNTER_INDEX, Test11CurrentDisplayData[EcuIndex].IPT[1] );
-	setrgb (NORMAL_TEXT);
+	if ( ((DirtyMask >> 1) & 0x01) != 0 )
+	{
+		if ( ((DoneFlags >> 1) & 0x01) == 0 )
+			setrgb (HIGHLIGHTED_TEXT);
+		SetFieldDec ( IGNITION_COUNTER_INDEX, Test11CurrentDisplayData[EcuIndex].IPT[1] );
+		setrgb (NORMAL_TEXT);
+	}
 
 	// update rate based counter values
-	for ( index = 2; index < pSid9Ipt->NODI; index++ )
+	for ( index = 2; index < pSid9Ipt->NODI && index < INF_TYPE_IPT_NODI; index++ )
 	{
-		if ( ((DoneFlags>>=1) & 0x01) == 0 )
+		if ( ((DirtyMask >> index) & 0x01) == 0 )
+			continue;
+
+		if ( ((DoneFlags >> index) & 0x01) == 0 )
 			setrgb (HIGHLIGHTED_TEXT);
 		SetFieldDec ( (IPT_CUR_INDEX+(index-2)), pSid9Ipt->IPT[index] );
 		setrgb (NORMAL_TEXT);
@@ -2280,29 +2383,36 @@ void UpdateSid9IptDisplay ( unsigned int EcuIndex, unsigned int DoneFlags, SID9I
 /*
 *******************************************************************************
 ** SaveSid1Pid1Data
+**
+** Sets a bit in *pDirtyMask for each IM Readiness status that changed
+** (bit n = Test11IMStatus[EcuIndex][n]).
 *******************************************************************************
 */
-BOOL SaveSid1Pid1Data (unsigned int EcuIndex)
+BOOL SaveSid1Pid1Data (unsigned int EcuIndex, unsigned long *pDirtyMask)
 {
 	SID1 * pSid1;
+	ULONGLONG Fingerprint;
+	enum IM_Status PrevIMStatus[11];
+	int    index;
 	BOOL   rc = FALSE;
 
+	*pDirtyMask = 0;
+
 	pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
 
 	if (pSid1->PID == 1)
 	{
-		// note any differences
-		if ((PreviousSid1Pid1[EcuIndex].Data[0] != pSid1->Data[0]) ||
-		    (PreviousSid1Pid1[EcuIndex].Data[1] != pSid1->Data[1]) ||
-		    (PreviousSid1Pid1[EcuIndex].Data[2] != pSid1->Data[2]) ||
-		    (PreviousSid1Pid1[EcuIndex].Data[3] != pSid1->Data[3]) )
+		// nothing to do if the PID $01 data has not changed,
+		// the IM Status only depends on it and on PID $41 (read once)
+		Fingerprint = GetSid1Fingerprint (EcuIndex, 0x01);
+		if (Fingerprint == Sid1Pid1Fingerprint[EcuIndex])
 		{
-			PreviousSid1Pid1[EcuIndex].Data[0] = pSid1->Data[0];
-			PreviousSid1Pid1[EcuIndex].Data[1] = pSid1->Data[1];
-			PreviousSid1Pid1[EcuIndex].Data[2] = pSid1->Data[2];
-			PreviousSid1Pid1[EcuIndex].Data[3] = pSid1->Data[3];
-			rc = TRUE;
+			return FALSE;
 		}
+		Sid1Pid1Fingerprint[EcuIndex] = Fingerprint;
+		rc = TRUE;
+
+		memcpy (PrevIMStatus, Test11IMStatus[EcuIndex], sizeof(PrevIMStatus));
 
 		// if Oxygen Sensor (spark) or Exhaust Gas Sensor (compression) supported
 		if (pSid1->Data[2] & 1<<5)
@@ -2544,6 +2654,15 @@ BOOL SaveSid1Pid1Data (unsigned int EcuIndex)
 		{
 			Test11IMStatus[EcuIndex][10] = NotSupported;
 		}
+
+		// note the IM Status fields that changed
+		for (index = 0; index < 11; index++)
+		{
+			if (Test11IMStatus[EcuIndex][index] != PrevIMStatus[index])
+			{
+				*pDirtyMask |= 1UL << index;
+			}
+		}
 	}
 
 	return rc;
@@ -2612,14 +2731,21 @@ BOOL SaveSid1Pid41Data ( void )
 /*
 *******************************************************************************
 ** UpdateSid1Pid1Display
+**
+** Only redraws the IM Status fields with a bit set in DirtyMask.
 *******************************************************************************
 */
-void UpdateSid1Pid1Display (unsigned int EcuIndex)
+void UpdateSid1Pid1Display (unsigned int EcuIndex, unsigned long DirtyMask)
 {
 	int index;
 
 	for (index = 0; index < 11; index++)
 	{
+		if ( ((DirtyMask >> index) & 0x01) == 0 )
+		{
+			continue;
+		}
+
 		CurrentIMStatus[index] = Test11IMStatus[EcuIndex][index];
 		if ( Test11IMStatus[EcuIndex][index] == Incomplete )
 		{
@@ -2645,16 +2771,20 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 	unsigned long t1SecTimer, tDelayTimeStamp;
 	unsigned int  EcuIndex, EcuMask, CurrentEcuIndex;
 	unsigned int  DoneFlags;         // Bit Map of ITP items completed for current EcuIndex
+	unsigned int  DrawnDoneFlags;    // DoneFlags the current EcuIndex is displayed with
+	unsigned long DirtyMask;         // Bit Map of fields changed by the last response
+	unsigned long CurrentIptDirty;   // Bit Map of IPT items changed for current EcuIndex
 	unsigned int  IMReadyDoneFlags;  // Bit Map of ECUs that have completed IM Readiness
 	unsigned int  Sid9IptDoneFlags;  // Bit Map of ECUs that have completed IPT changes
 	unsigned int  EcuDone;           // Bit Map of ECUs that have completed IM Readiness & IPT changes
 	unsigned int  bSid9Ipt = 0;      // supported IPT data INF (8 or B), default 0 = no support
 	int iTimeToCheckDTCs = 0;        // # of seconds until DTCs are checked
 
-	const unsigned int EcuDoneMask = (1 << gUserNumEcus) - 1;
+	const unsigned long EcuDoneMask = (gUserNumEcus >= 32) ? 0xFFFFFFFFUL : (1UL << gUserNumEcus) - 1;
 
 	SID_REQ       SidReq;
 	SID1         *pSid1;
+	const DECODED_SAMPLE *pSample;
 
 	unsigned char fInf8Supported = FALSE;
 	unsigned char fInfBSupported = FALSE;
@@ -2805,10 +2935,11 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 	SaveSid1Pid41Data ( );
 
 
+	memset (EcuStatusText, 0, sizeof(EcuStatusText));
+	DisplayEcuPage (0);
+
 	for ( EcuIndex=0, EcuMask=1; EcuIndex < gUserNumEcus; EcuIndex++, EcuMask<<=1 )
 	{
-		SetFieldHex (ECU_ID_INDEX+EcuIndex, GetEcuId(EcuIndex));
-
 		if (IsSid1PidSupported (EcuIndex, 1) == FALSE)
 		{
 			IMReadyDoneFlags |= EcuMask;
@@ -2834,7 +2965,7 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 		if ( (IMReadyDoneFlags & Sid9IptDoneFlags & EcuMask) != 0)
 		{
 			EcuDone |= EcuMask;
-			SetFieldText (ECU_STATUS_INDEX+EcuIndex, "N/A");
+			SetEcuStatus (EcuIndex, "N/A");
 		}
 	}
 
@@ -2845,6 +2976,7 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 
 	SelectECU ( CurrentEcuIndex, -1 );
 	DisplayEcuData ( CurrentEcuIndex, DoneFlags );
+	DrawnDoneFlags = DoneFlags;
 
 	// flush the STDIN stream of any user input before loop
 	clear_keyboard_buffer ();
@@ -2889,7 +3021,7 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 				if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
 				{
 					if (
-					     (SaveSid1Pid1Data (EcuIndex) == TRUE) ||
+					     (SaveSid1Pid1Data (EcuIndex, &DirtyMask) == TRUE) ||
 					     (fLastTestStatus == SUB_TEST_INITIAL)
 					   )
 					{
@@ -2902,7 +3034,7 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 						}
 
 						if ( EcuIndex == CurrentEcuIndex )
-							UpdateSid1Pid1Display ( EcuIndex );
+							UpdateSid1Pid1Display ( EcuIndex, DirtyMask );
 					}
 				}
 			}
@@ -2941,17 +3073,23 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 					bLogMessage = TRUE;
 				}
 
+				CurrentIptDirty = 0;
 				for ( EcuIndex = 0, EcuMask=1; EcuIndex < gUserNumEcus; EcuIndex++, EcuMask<<=1 )
 				{
 					if ( GetSid9IptData ( EcuIndex, &Test11_5_Sid9Ipt[EcuIndex] ) == PASS )
 					{
 						if (
-						     (SaveSid9IptData ( EcuIndex, &Test11_5_Sid9Ipt[EcuIndex] ) == TRUE) ||
+						     (SaveSid9IptData ( EcuIndex, &Test11_5_Sid9Ipt[EcuIndex], &DirtyMask ) == TRUE) ||
 						     (fLastTestStatus == SUB_TEST_INITIAL)
 						   )
 						{
 							bLogMessage = TRUE;
 						}
+
+						if ( EcuIndex == CurrentEcuIndex )
+						{
+							CurrentIptDirty = DirtyMask;
+						}
 					}
 				}
 
@@ -2972,7 +3110,10 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 
 						if ( EcuIndex == CurrentEcuIndex )
 						{
-							UpdateSid9IptDisplay ( EcuIndex, DoneFlags, &Test11_5_Sid9Ipt[EcuIndex] );
+							// redraw the counters that changed or changed highlighting
+							UpdateSid9IptDisplay ( EcuIndex, DoneFlags, &Test11_5_Sid9Ipt[EcuIndex],
+							                       CurrentIptDirty | (DoneFlags ^ DrawnDoneFlags) );
+							DrawnDoneFlags = DoneFlags;
 						}
 					}
 
@@ -3015,19 +3156,11 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 
 					for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 					{
-						if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+						pSample = GetSid1Sample (EcuIndex, SAMPLE_RPM);
+						if (pSample->fValid == TRUE)
 						{
-							pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-
-							if (pSid1->PID == 0x0c)
-							{
-								RPM = pSid1->Data[0];
-								RPM = RPM << 8 | pSid1->Data[1];
-
-								// convert from 1 cnt = 1/4 RPM to 1 cnt = 1 RPM
-								RPM >>= 2;
-								break;
-							}
+							RPM = (unsigned short)pSample->lValue;
+							break;
 						}
 					}
 
@@ -3074,20 +3207,14 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+					pSample = GetSid1Sample (EcuIndex, SAMPLE_VSS);
+					if (pSample->fValid == TRUE)
 					{
-						pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-
-						if (pSid1->PID == 0x0d)
-						{
-							double dTemp = pSid1->Data[0];
-
-							SpeedKPH = pSid1->Data[0];
+						SpeedKPH = (unsigned short)pSample->lValue;
 
-							// convert from km/hr to mile/hr
-							SpeedMPH = (unsigned short)( ((dTemp * 6214) / 10000) + 0.5 );
-							break;
-						}
+						// convert from km/hr to mile/hr
+						SpeedMPH = (unsigned short)( (((double)pSample->lValue * 6214) / 10000) + 0.5 );
+						break;
 					}
 				}
 
@@ -3135,16 +3262,11 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 
 					for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 					{
-						if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+						pSample = GetSid1Sample (EcuIndex, SAMPLE_RUNTM);
+						if (pSample->fValid == TRUE)
 						{
-							pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-
-							if (pSid1->PID == 0x1f)
-							{
-								usRunTime = pSid1->Data[0];
-								usRunTime = usRunTime << 8 | pSid1->Data[1];    // 1 cnt = 1 sec
-								break;
-							}
+							usRunTime = (unsigned short)pSample->lValue;    // 1 cnt = 1 sec
+							break;
 						}
 					}
 
@@ -3410,7 +3532,7 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 				if ( (IMReadyDoneFlags & Sid9IptDoneFlags & EcuMask) != 0)
 				{
 					EcuDone |= EcuMask;
-					SetFieldText (ECU_STATUS_INDEX+EcuIndex, "Done");
+					SetEcuStatus (EcuIndex, "Done");
 				}
 			}
 		}
@@ -3454,9 +3576,22 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 					mReturn = FAIL;
 				}
 
-				if (('1' <= c) && (c <= '8'))   // new ECU index
+				if ((('1' <= c) && (c <= '8')) ||        // new ECU index on this page
+				    (c == 'N') || (c == 'n'))            // first ECU of the next page
 				{
-					EcuIndex = c - '1';         // zero-based index
+					if ((c == 'N') || (c == 'n'))
+					{
+						EcuIndex = (EcuPage + 1) * OBD_ECUS_PER_PAGE;
+						if (EcuIndex >= gUserNumEcus)
+						{
+							EcuIndex = 0;
+						}
+					}
+					else
+					{
+						EcuIndex = EcuPage * OBD_ECUS_PER_PAGE + (c - '1');   // zero-based index
+					}
+
 					if (EcuIndex < gUserNumEcus && EcuIndex != CurrentEcuIndex)
 					{
 						DoneFlags = 0xFFFFFFFF;   // by default all items completed
@@ -3464,6 +3599,7 @@ STATUS RunDynamicTest11 ( BOOL bDisplayCARBTimers, unsigned long ulEngineStartTi
 
 						SelectECU ( EcuIndex, CurrentEcuIndex );
 						DisplayEcuData ( EcuIndex, DoneFlags );
+						DrawnDoneFlags = DoneFlags;
 						CurrentEcuIndex = EcuIndex;
 					}
 				}
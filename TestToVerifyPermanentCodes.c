@@ -122,6 +122,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	/* Engine should now be not running */
 	gOBDEngineRunning = FALSE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -135,6 +136,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -143,6 +145,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	          (gOBDTestSubsectionFailed == TRUE)
 	        )
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -150,6 +153,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -176,6 +180,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -183,6 +188,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -206,6 +212,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -213,6 +220,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -234,6 +242,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	Log( PROMPT, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT,
 	     "Turn ignition on.  DO NOT crank engine.\n");
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -248,6 +257,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -264,6 +274,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -271,6 +282,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -294,6 +306,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -301,6 +314,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -324,6 +338,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -331,6 +346,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -370,6 +386,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	/* Engine should now be running */
 	gOBDEngineRunning = TRUE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -383,6 +400,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -391,6 +409,7 @@ STATUS TestToVerifyPermanentCodes(void)
 		(gOBDTestSubsectionFailed == TRUE)
 		)
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -398,6 +417,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -424,6 +444,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -431,6 +452,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -451,6 +473,7 @@ STATUS TestToVerifyPermanentCodes(void)
 		if ( Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT,
 	              "Unable to capture Initial OBDCOND and IGNCNT.\n") == 'N' )
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			return(FAIL);
 		}
@@ -461,7 +484,7 @@ STATUS TestToVerifyPermanentCodes(void)
 
 	// stop tester-present message
 	StopPeriodicMsg (TRUE);
-	Sleep (gOBDRequestDelay);
+	PacingWaitForRequest ();
 
 	gSuspendScreenOutput = TRUE;
 	ret_code = RunDynamicTest10 (tEngineStartTimeStamp);
@@ -480,6 +503,7 @@ STATUS TestToVerifyPermanentCodes(void)
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Errors detected during dynamic test.  View Logfile for more details.\n");
 
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return FAIL;
@@ -487,6 +511,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -511,6 +536,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	/* Engine should now be  running */
 	gOBDEngineRunning = TRUE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -527,6 +553,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -535,6 +562,7 @@ STATUS TestToVerifyPermanentCodes(void)
 		(gOBDTestSubsectionFailed == TRUE)
 		)
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -542,6 +570,7 @@ STATUS TestToVerifyPermanentCodes(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
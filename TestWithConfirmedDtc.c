@@ -75,6 +75,7 @@ STATUS TestWithConfirmedDtc(void)
 
 	gOBDEngineRunning = TRUE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -88,6 +89,7 @@ STATUS TestWithConfirmedDtc(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -96,6 +98,7 @@ STATUS TestWithConfirmedDtc(void)
 		(gOBDTestSubsectionFailed == TRUE)
 		)
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -103,6 +106,7 @@ STATUS TestWithConfirmedDtc(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -158,6 +162,7 @@ STATUS TestWithConfirmedDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -165,6 +170,7 @@ STATUS TestWithConfirmedDtc(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -205,6 +211,7 @@ STATUS TestWithConfirmedDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -212,6 +219,7 @@ STATUS TestWithConfirmedDtc(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -241,6 +249,7 @@ STATUS TestWithConfirmedDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -248,6 +257,7 @@ STATUS TestWithConfirmedDtc(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
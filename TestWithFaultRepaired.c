@@ -88,6 +88,7 @@ STATUS TestWithFaultRepaired(void)
 
 	gOBDEngineRunning = TRUE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -101,6 +102,7 @@ STATUS TestWithFaultRepaired(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -109,6 +111,7 @@ STATUS TestWithFaultRepaired(void)
 		(gOBDTestSubsectionFailed == TRUE)
 		)
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -116,6 +119,7 @@ STATUS TestWithFaultRepaired(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -171,6 +175,7 @@ STATUS TestWithFaultRepaired(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -178,6 +183,7 @@ STATUS TestWithFaultRepaired(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -194,6 +200,7 @@ STATUS TestWithFaultRepaired(void)
 		if ( Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT,
              "Verify DTC stored data unsuccessful.\n" ) == 'N' )
 		{
+    	    EndSubsectionStats ();
     	    Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			return(FAIL);
 		}
@@ -221,6 +228,7 @@ STATUS TestWithFaultRepaired(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -228,6 +236,7 @@ STATUS TestWithFaultRepaired(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -257,6 +266,7 @@ STATUS TestWithFaultRepaired(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+	    EndSubsectionStats ();
 	    if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -264,6 +274,7 @@ STATUS TestWithFaultRepaired(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -290,6 +301,7 @@ STATUS TestWithFaultRepaired(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -297,6 +309,7 @@ STATUS TestWithFaultRepaired(void)
 	}
 	else
 	{
+	    EndSubsectionStats ();
 	    Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
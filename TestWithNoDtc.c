@@ -67,6 +67,7 @@ STATUS TestWithNoDtc(void)
 	     "(MIL bulb check, Engine Off, No DTC set)");
 	if ( CheckMILLight() != PASS || gOBDTestSubsectionFailed == TRUE )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -74,6 +75,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -88,6 +90,7 @@ STATUS TestWithNoDtc(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -96,6 +99,7 @@ STATUS TestWithNoDtc(void)
 		(gOBDTestSubsectionFailed == TRUE)
 		)
 	{
+		EndSubsectionStats ();
 		if (
 		     (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N'
 		   )
@@ -105,6 +109,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -128,6 +133,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -135,6 +141,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -163,6 +170,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -170,6 +178,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -193,6 +202,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -200,6 +210,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -223,6 +234,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -230,6 +242,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -253,6 +266,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -260,6 +274,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -282,6 +297,7 @@ STATUS TestWithNoDtc(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -290,6 +306,7 @@ STATUS TestWithNoDtc(void)
 	          (gOBDTestSubsectionFailed == TRUE)
 	        )
 	{
+		EndSubsectionStats ();
 		if ( (Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "")) == 'N' )
 		{
 			return(FAIL);
@@ -297,6 +314,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -320,6 +338,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -327,6 +346,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -350,6 +370,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -357,6 +378,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -380,6 +402,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -387,6 +410,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -415,6 +439,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( gOBDTestSubsectionFailed == TRUE || bSubTestFailed == TRUE)
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -422,6 +447,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -445,6 +471,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -452,6 +479,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -475,6 +503,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -482,6 +511,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -505,6 +535,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -512,6 +543,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -535,6 +567,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -542,6 +575,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -565,6 +599,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -572,6 +607,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -595,6 +631,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -602,6 +639,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -630,6 +668,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	 {
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -637,6 +676,7 @@ STATUS TestWithNoDtc(void)
 	 }
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -660,6 +700,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -667,6 +708,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -690,6 +732,7 @@ STATUS TestWithNoDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -697,6 +740,7 @@ STATUS TestWithNoDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
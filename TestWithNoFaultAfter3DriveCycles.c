@@ -103,6 +103,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 	gOBDEngineRunning = TRUE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -122,6 +123,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -130,6 +132,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	          (gOBDTestSubsectionFailed == TRUE)
 	        )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -137,6 +140,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -160,6 +164,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -167,6 +172,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -196,6 +202,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -203,6 +210,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -232,6 +240,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -239,6 +248,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -262,6 +272,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -269,6 +280,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -292,6 +304,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 		          "Do you wish to run the CARB drive cycle portion for Permanent DTCs?") == 'Y'
 		   )
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 			/* Verify permanent codes */
@@ -318,6 +331,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 			if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 			{
+				EndSubsectionStats ();
 				if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 				{
 					return(FAIL);
@@ -325,6 +339,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 			}
 			else
 			{
+				EndSubsectionStats ();
 				Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 			}
 		}
@@ -335,6 +350,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 			     "Service $0A was supported but the operator chose not to run\n"
 			     "the Permanent Code Drive Cycle test.\n\n" );
 
+			EndSubsectionStats ();
 			Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		}
 	}
@@ -346,6 +362,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 		     "Service $0A was not supported by any ECU, therefore\n"
 		     "the Permanent Code Drive Cycle was not tested.\n\n" );
 
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 	/* IF not US, just note that SID $A not supported and Permanent Code Drive Cycle not tested */
@@ -355,6 +372,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 		     "Service $0A was not supported by any ECU, therefore\n"
 		     "the Permanent Code Drive Cycle was not tested.\n\n" );
 
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -392,6 +410,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "Protocol determination unsuccessful.\n" );
+				EndSubsectionStats ();
 				Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 				Log( PROMPT, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT,"Turn key OFF" );
 				return(FAIL);
@@ -418,6 +437,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 
 		if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 		{
+			EndSubsectionStats ();
 			if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 			{
 				Log( PROMPT, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT, "Turn key OFF" );
@@ -426,6 +446,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 		}
 		else
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		}
 	}
@@ -434,6 +455,7 @@ STATUS TestWithNoFaultsAfter3DriveCycles(void)
 		/* Don't clear Codes, EXIT Test 9 */
 		Log( PROMPT, SCREENOUTPUTON, LOGOUTPUTON, ENTER_PROMPT, "Turn key OFF" );
 
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
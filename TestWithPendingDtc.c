@@ -77,6 +77,7 @@ STATUS TestWithPendingDtc(void)
 
 	gOBDEngineRunning = TRUE;
 
+	EndSubsectionStats ();
 	Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 
 
@@ -90,6 +91,7 @@ STATUS TestWithPendingDtc(void)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "Protocol determination unsuccessful.\n" );
+		EndSubsectionStats ();
 		Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		return(FAIL);
 	}
@@ -98,6 +100,7 @@ STATUS TestWithPendingDtc(void)
 	          (gOBDTestSubsectionFailed == TRUE)
 	        )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -105,6 +108,7 @@ STATUS TestWithPendingDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -179,6 +183,7 @@ STATUS TestWithPendingDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -186,6 +191,7 @@ STATUS TestWithPendingDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -215,6 +221,7 @@ STATUS TestWithPendingDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -222,6 +229,7 @@ STATUS TestWithPendingDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -251,6 +259,7 @@ STATUS TestWithPendingDtc(void)
 
 	if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 	{
+		EndSubsectionStats ();
 		if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 		{
 			return(FAIL);
@@ -258,6 +267,7 @@ STATUS TestWithPendingDtc(void)
 	}
 	else
 	{
+		EndSubsectionStats ();
 		Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 	}
 
@@ -285,6 +295,7 @@ STATUS TestWithPendingDtc(void)
 
 		if ( (gOBDTestSubsectionFailed == TRUE) || (bSubTestFailed == TRUE) )
 		{
+			EndSubsectionStats ();
 			if ( Log( SUBSECTION_FAILED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT, "") == 'N' )
 			{
 				return(FAIL);
@@ -292,6 +303,7 @@ STATUS TestWithPendingDtc(void)
 		}
 		else
 		{
+			EndSubsectionStats ();
 			Log( SUBSECTION_PASSED_RESULT, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT, "");
 		}
 	}
@@ -319,11 +331,11 @@ void SaveDTCList (int nSID)
 
 	for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 	{
-		size = gDTCList[EcuIndex].Size = (nSID == 3) ? gOBDResponse[EcuIndex].Sid3Size
-		                                             : gOBDResponse[EcuIndex].Sid7Size;
+		size = gDTCList[EcuIndex].Size = (nSID == 3) ? gOBDResponse[EcuIndex].Sid3.Size
+		                                             : gOBDResponse[EcuIndex].Sid7.Size;
 		for (index = 0; index < size; index++)
-			gDTCList[EcuIndex].DTC[index] = (nSID == 3) ? gOBDResponse[EcuIndex].Sid3[index]
-			                                            : gOBDResponse[EcuIndex].Sid7[index];
+			gDTCList[EcuIndex].DTC[index] = (nSID == 3) ? SidDataByte (&gOBDResponse[EcuIndex].Sid3, index)
+			                                            : SidDataByte (&gOBDResponse[EcuIndex].Sid7, index);
 	}
 
 	/* If this is Test 7.4 and there is a pending DTC, append to DTC list */
@@ -334,11 +346,11 @@ void SaveDTCList (int nSID)
 		/* Get DTC list from SID $07 */
 		for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 		{
-			size = gOBDResponse[EcuIndex].Sid7Size;
+			size = gOBDResponse[EcuIndex].Sid7.Size;
 			DTCIndex = gDTCList[EcuIndex].Size;
-			gDTCList[EcuIndex].Size += gOBDResponse[EcuIndex].Sid7Size;
+			gDTCList[EcuIndex].Size += gOBDResponse[EcuIndex].Sid7.Size;
 			for ( index = 0; index < size; index++, DTCIndex++ )
-				gDTCList[EcuIndex].DTC[DTCIndex] = gOBDResponse[EcuIndex].Sid7[index];
+				gDTCList[EcuIndex].DTC[DTCIndex] = SidDataByte (&gOBDResponse[EcuIndex].Sid7, index);
 		}
 	}
 }
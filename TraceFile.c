@@ -0,0 +1,166 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** The .j1t trace file holds every network frame LogMsg logs, also during the
+** Manufacturer Specific Drive Cycle when the text log is suspended, as
+** compact binary records (see TRACE_FILE_HEADER in j1699.h).  j1tdump
+** renders it back to the log file text.
+*/
+
+#define TRACE_FILE_BUFFER_SIZE  65536   /* stdio buffer of the trace file */
+
+static FILE         *hTraceFile = NULL;
+static unsigned long TraceStartMsecs = 0;
+
+/*
+*******************************************************************************
+** TraceFileOpen - Function to create the trace file, named after the start
+**                 time (j1699_YYYYMMDD_HHMMSS.j1t)
+**
+** gTraceFileName is left set on failure for the caller's message.
+*******************************************************************************
+*/
+STATUS TraceFileOpen (void)
+{
+	TRACE_FILE_HEADER Header;
+	time_t CurrentTime;
+	struct tm *pCurrentTm;
+
+	time (&CurrentTime);
+	pCurrentTm = localtime (&CurrentTime);
+	sprintf (gTraceFileName, "j1699_%04d%02d%02d_%02d%02d%02d.j1t",
+	         pCurrentTm->tm_year + 1900, pCurrentTm->tm_mon + 1, pCurrentTm->tm_mday,
+	         pCurrentTm->tm_hour, pCurrentTm->tm_min, pCurrentTm->tm_sec);
+
+	hTraceFile = fopen (gTraceFileName, "wb");
+	if (hTraceFile == NULL)
+	{
+		return FAIL;
+	}
+	setvbuf (hTraceFile, NULL, _IOFBF, TRACE_FILE_BUFFER_SIZE);
+
+	memset (&Header, 0, sizeof(Header));
+	memcpy (Header.Magic, TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC));
+	Header.Version   = TRACE_FILE_VERSION;
+	Header.StartTime = (unsigned long)CurrentTime;
+	fwrite (&Header, sizeof(Header), 1, hTraceFile);
+
+	TraceStartMsecs = GetTickCount ();
+
+	return PASS;
+}
+
+/*
+*******************************************************************************
+** TraceFileClose - Function to close the trace file
+*******************************************************************************
+*/
+void TraceFileClose (void)
+{
+	if (hTraceFile != NULL)
+	{
+		fclose (hTraceFile);
+		hTraceFile = NULL;
+	}
+}
+
+/*
+*******************************************************************************
+** TraceFileWrite - Function to write a record to the trace file with one
+**                  fwrite, pData1 / pData2 are the record data
+*******************************************************************************
+*/
+static void TraceFileWrite (unsigned short Type,
+                            const void *pData1, unsigned long Size1,
+                            const void *pData2, unsigned long Size2)
+{
+	unsigned char Record[sizeof(TRACE_RECORD_HEADER) + sizeof(LOG_FRAME) + MAX_LOG_STRING_SIZE];
+	TRACE_RECORD_HEADER *pHeader;
+
+	if ( (sizeof(TRACE_RECORD_HEADER) + Size1 + Size2) > sizeof(Record) )
+	{
+		return;
+	}
+
+	pHeader = (TRACE_RECORD_HEADER *)Record;
+	pHeader->Length     = (unsigned short)(Size1 + Size2);
+	pHeader->Type       = Type;
+	pHeader->TraceMsecs = GetTickCount () - TraceStartMsecs;
+
+	memcpy (&Record[sizeof(TRACE_RECORD_HEADER)], pData1, Size1);
+	memcpy (&Record[sizeof(TRACE_RECORD_HEADER) + Size1], pData2, Size2);
+
+	fwrite (Record, sizeof(TRACE_RECORD_HEADER) + Size1 + Size2, 1, hTraceFile);
+}
+
+/*
+*******************************************************************************
+** TraceFileFrame - Function to write a LogMsg frame to the trace file
+*******************************************************************************
+*/
+void TraceFileFrame (const LOG_FRAME *pFrame, const unsigned char *pData)
+{
+	if (hTraceFile != NULL)
+	{
+		TraceFileWrite (TRACE_FRAME, pFrame, sizeof(*pFrame), pData, pFrame->NumBytes);
+	}
+}
+
+/*
+*******************************************************************************
+** TraceFileMarker - Function to write a test (sub)section marker to the
+**                   trace file, the trace is flushed at every marker
+*******************************************************************************
+*/
+void TraceFileMarker (const char *szText)
+{
+	unsigned char Section[2];
+
+	if (hTraceFile != NULL)
+	{
+		Section[0] = (unsigned char)TestPhase;
+		Section[1] = TestSubsection;
+		TraceFileWrite (TRACE_MARKER, Section, sizeof(Section), szText, strlen (szText));
+		fflush (hTraceFile);
+	}
+}
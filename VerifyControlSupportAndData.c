@@ -260,7 +260,7 @@ STATUS RequestSID8SupportData (void)
 			{
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid8TidSize != 0)
+					if (gOBDResponse[EcuIndex].Sid8Tid.Size != 0)
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  Unexpected response to unsupported SID $8 TID $%02X!\n",
@@ -341,10 +341,6 @@ STATUS VerifySid8PidSupportData (void)
 //*****************************************************************************
 unsigned int IsSid8TidSupported (unsigned int EcuIndex, unsigned int TidIndex)
 {
-	int index1;
-	int index2;
-	int mask;
-
 	if (TidIndex == 0)
 	{
 		if ((signed int)EcuIndex < 0)
@@ -360,27 +356,8 @@ unsigned int IsSid8TidSupported (unsigned int EcuIndex, unsigned int TidIndex)
 			if (gOBDResponse[EcuIndex].Sid8TidSupportSize > 0)
 				return TRUE;
 		}
+		return FALSE;
 	}
 
-	TidIndex--;
-
-	index1 =  TidIndex >> 5;
-	index2 = (TidIndex >> 3) & 0x03;
-	mask   = 0x80 >> (TidIndex & 0x07);
-
-	if ((signed int)EcuIndex < 0)
-	{
-		for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
-		{
-			if (gOBDResponse[EcuIndex].Sid8TidSupport[index1].IDBits[index2] & mask)
-				return TRUE;
-		}
-	}
-	else
-	{
-		if (gOBDResponse[EcuIndex].Sid8TidSupport[index1].IDBits[index2] & mask)
-			return TRUE;
-	}
-
-	return FALSE;
+	return SupportMapTest (0x08, EcuIndex, TidIndex);
 }
@@ -88,7 +88,7 @@ STATUS VerifyDTCPendingData(void)
 		for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 		{
 			/* warn for ECUs which don't respond */
-			if ( gOBDResponse[EcuIndex].Sid7Size == 0 )
+			if ( gOBDResponse[EcuIndex].Sid7.Size == 0 )
 			{
 				Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  No SID $7 response!\n", GetEcuId (EcuIndex) );
@@ -98,7 +98,7 @@ STATUS VerifyDTCPendingData(void)
 			/* If ISO15765 protocol, check that DTCs are $00 */
 			if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 			{
-				if ( (gOBDResponse[EcuIndex].Sid7[0] != 0x00) || (gOBDResponse[EcuIndex].Sid7[1] != 0x00) )
+				if ( (SidDataByte (&gOBDResponse[EcuIndex].Sid7, 0) != 0x00) || (SidDataByte (&gOBDResponse[EcuIndex].Sid7, 1) != 0x00) )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $7 indicates DTC pending\n", GetEcuId (EcuIndex) );
@@ -109,7 +109,7 @@ STATUS VerifyDTCPendingData(void)
 			else
 			{
 				/* response should contain multiple of 6 data bytes */
-				if (gOBDResponse[EcuIndex].Sid7Size % 6 != 0)
+				if (gOBDResponse[EcuIndex].Sid7.Size % 6 != 0)
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $7 response size error\n", GetEcuId (EcuIndex) );
@@ -117,10 +117,10 @@ STATUS VerifyDTCPendingData(void)
 				}
 
 				/* validation of all DTCs reported in response */
-				for ( DataOffset = 0; DataOffset < (unsigned long)(gOBDResponse[EcuIndex].Sid7Size / 2); DataOffset++ )
+				for ( DataOffset = 0; DataOffset < (unsigned long)(gOBDResponse[EcuIndex].Sid7.Size / 2); DataOffset++ )
 				{
-					if ( gOBDResponse[EcuIndex].Sid7[DataOffset*2] != 0x00 ||
-					     gOBDResponse[EcuIndex].Sid7[DataOffset*2+1] != 0x00 )
+					if ( SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset*2) != 0x00 ||
+					     SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset*2+1) != 0x00 )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  SID $7 indicates DTC pending\n", GetEcuId (EcuIndex) );
@@ -139,7 +139,7 @@ STATUS VerifyDTCPendingData(void)
 		for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 		{
 			/* warn for ECUs which don't respond */
-			if ( gOBDResponse[EcuIndex].Sid7Size == 0 )
+			if ( gOBDResponse[EcuIndex].Sid7.Size == 0 )
 			{
 				Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  No response to SID $7 request\n", GetEcuId (EcuIndex) );
@@ -147,21 +147,21 @@ STATUS VerifyDTCPendingData(void)
 			}
 
 			/* Print out all the DTCs */
-			for (DataOffset = 0; DataOffset < gOBDResponse[EcuIndex].Sid7Size; DataOffset += 2)
+			for (DataOffset = 0; DataOffset < gOBDResponse[EcuIndex].Sid7.Size; DataOffset += 2)
 			{
-				if ((gOBDResponse[EcuIndex].Sid7[DataOffset] != 0) ||
-				(gOBDResponse[EcuIndex].Sid7[DataOffset + 1] != 0))
+				if ((SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset) != 0) ||
+				(SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset + 1) != 0))
 				{
 					/* Process based on the type of DTC */
-					switch (gOBDResponse[EcuIndex].Sid7[DataOffset] & 0xC0)
+					switch (SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset) & 0xC0)
 					{
 						case 0x00:
 						{
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Pending DTC P%02X%02X detected\n",
 							     GetEcuId (EcuIndex),
-							     gOBDResponse[EcuIndex].Sid7[DataOffset] & 0x3F,
-							     gOBDResponse[EcuIndex].Sid7[DataOffset + 1]);
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset) & 0x3F,
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset + 1));
 						}
 						break;
 						case 0x40:
@@ -169,8 +169,8 @@ STATUS VerifyDTCPendingData(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Pending DTC C%02X%02X detected\n",
 							     GetEcuId (EcuIndex),
-							     gOBDResponse[EcuIndex].Sid7[DataOffset] & 0x3F,
-							     gOBDResponse[EcuIndex].Sid7[DataOffset + 1]);
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset) & 0x3F,
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset + 1));
 						}
 						break;
 						case 0x80:
@@ -178,8 +178,8 @@ STATUS VerifyDTCPendingData(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Pending DTC B%02X%02X detected\n",
 							      GetEcuId (EcuIndex),
-							      gOBDResponse[EcuIndex].Sid7[DataOffset] & 0x3F,
-							      gOBDResponse[EcuIndex].Sid7[DataOffset + 1]);
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset) & 0x3F,
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset + 1));
 						}
 						break;
 						case 0xC0:
@@ -187,8 +187,8 @@ STATUS VerifyDTCPendingData(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Pending DTC U%02X%02X detected\n",
 							      GetEcuId (EcuIndex),
-							      gOBDResponse[EcuIndex].Sid7[DataOffset] & 0x3F,
-							      gOBDResponse[EcuIndex].Sid7[DataOffset + 1]);
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset) & 0x3F,
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid7, DataOffset + 1));
 						}
 						break;
 					}
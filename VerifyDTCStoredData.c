@@ -94,7 +94,7 @@ STATUS VerifyDTCStoredData(void)
 		for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 		{
 			/* warn for ECUs which don't respond */
-			if ( gOBDResponse[EcuIndex].Sid3Size == 0 )
+			if ( gOBDResponse[EcuIndex].Sid3.Size == 0 )
 			{
 				Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  No response to SID $3 request\n", GetEcuId (EcuIndex) );
@@ -104,7 +104,7 @@ STATUS VerifyDTCStoredData(void)
 			/* If ISO15765 protocol, check that DTCs are $00 */
 			if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 			{
-				if ( (gOBDResponse[EcuIndex].Sid3[0] != 0x00) || ((gOBDResponse[EcuIndex].Sid3[1] != 0x00)) )
+				if ( (SidDataByte (&gOBDResponse[EcuIndex].Sid3, 0) != 0x00) || ((SidDataByte (&gOBDResponse[EcuIndex].Sid3, 1) != 0x00)) )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $3 indicates DTC stored\n", GetEcuId (EcuIndex) );
@@ -115,7 +115,7 @@ STATUS VerifyDTCStoredData(void)
 			else
 			{
 				/* response should contain multiple of 6 data bytes */
-				if (gOBDResponse[EcuIndex].Sid3Size % 6 != 0)
+				if (gOBDResponse[EcuIndex].Sid3.Size % 6 != 0)
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $3 response size error\n", GetEcuId (EcuIndex) );
@@ -123,10 +123,10 @@ STATUS VerifyDTCStoredData(void)
 				}
 
 				/* validation of all DTCs reported in response */
-				for ( DataOffset = 0; DataOffset < (unsigned long)(gOBDResponse[EcuIndex].Sid3Size / 2); DataOffset++ )
+				for ( DataOffset = 0; DataOffset < (unsigned long)(gOBDResponse[EcuIndex].Sid3.Size / 2); DataOffset++ )
 				{
-					if ( gOBDResponse[EcuIndex].Sid3[DataOffset*2] != 0x00 ||
-					     gOBDResponse[EcuIndex].Sid3[DataOffset*2+1] != 0x00 )
+					if ( SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset*2) != 0x00 ||
+					     SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset*2+1) != 0x00 )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  SID $3 indicates DTC stored\n", GetEcuId (EcuIndex) );
@@ -145,7 +145,7 @@ STATUS VerifyDTCStoredData(void)
 		for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 		{
 			/* warn for ECUs which don't respond */
-			if ( gOBDResponse[EcuIndex].Sid3Size == 0 )
+			if ( gOBDResponse[EcuIndex].Sid3.Size == 0 )
 			{
 				Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  No response to SID $3 request\n", GetEcuId (EcuIndex) );
@@ -153,21 +153,21 @@ STATUS VerifyDTCStoredData(void)
 			}
 
 			/* Print out all the DTCs */
-			for (DataOffset = 0; DataOffset < gOBDResponse[EcuIndex].Sid3Size; DataOffset += 2)
+			for (DataOffset = 0; DataOffset < gOBDResponse[EcuIndex].Sid3.Size; DataOffset += 2)
 			{
-				if ((gOBDResponse[EcuIndex].Sid3[DataOffset] != 0) ||
-				    (gOBDResponse[EcuIndex].Sid3[DataOffset + 1] != 0))
+				if ((SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset) != 0) ||
+				    (SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset + 1) != 0))
 				{
 					/* Process based on the type of DTC */
-					switch (gOBDResponse[EcuIndex].Sid3[DataOffset] & 0xC0)
+					switch (SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset) & 0xC0)
 					{
 						case 0x00:
 						{
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Stored DTC P%02X%02X detected\n",
 							      GetEcuId (EcuIndex),
-							      gOBDResponse[EcuIndex].Sid3[DataOffset] & 0x3F,
-							      gOBDResponse[EcuIndex].Sid3[DataOffset + 1]);
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset) & 0x3F,
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset + 1));
 						}
 						break;
 						case 0x40:
@@ -175,8 +175,8 @@ STATUS VerifyDTCStoredData(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Stored DTC C%02X%02X detected\n",
 							     GetEcuId (EcuIndex),
-							     gOBDResponse[EcuIndex].Sid3[DataOffset] & 0x3F,
-							     gOBDResponse[EcuIndex].Sid3[DataOffset + 1]);
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset) & 0x3F,
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset + 1));
 						}
 						break;
 						case 0x80:
@@ -184,8 +184,8 @@ STATUS VerifyDTCStoredData(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Stored DTC B%02X%02X detected\n",
 							      GetEcuId (EcuIndex),
-							      gOBDResponse[EcuIndex].Sid3[DataOffset] & 0x3F,
-							      gOBDResponse[EcuIndex].Sid3[DataOffset + 1]);
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset) & 0x3F,
+							      SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset + 1));
 						}
 						break;
 						case 0xC0:
@@ -193,8 +193,8 @@ STATUS VerifyDTCStoredData(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Stored DTC U%02X%02X detected\n",
 							     GetEcuId (EcuIndex),
-							     gOBDResponse[EcuIndex].Sid3[DataOffset] & 0x3F,
-							     gOBDResponse[EcuIndex].Sid3[DataOffset + 1]);
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset) & 0x3F,
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid3, DataOffset + 1));
 						}
 						break;
 					}
@@ -110,7 +110,7 @@ STATUS VerifyDiagnosticBurstSupport(void)
 	** Wait for possible race conditions.
 	** SidRequest will flush the queue.
 	*/
-	Sleep (gOBDRequestDelay);
+	PacingWaitForRequest ();
 
 	/* Request SID 1 PID 0x00 and PID 0x01 in alternating order for 5 seconds */
 	SidReq.Ids[0] = 1;
@@ -45,8 +45,6 @@
 #include "j2534.h"
 #include "j1699.h"
 
-#define MAX_PIDS 0x100
-
 /*
  * SID $01 PID $01 Bit defines - for tracking support when
  * 'at least one ECU' must have these bits set
@@ -70,6 +68,8 @@ STATUS GetPid50Array (void);
 
 void GetHoursMinsSecs( unsigned long time, unsigned long *hours, unsigned long *mins, unsigned long *secs);
 
+BOOL FindSid1PidData (unsigned long EcuIndex, unsigned long Pid, BOOL fPacked, unsigned long *pSidIndex);
+
 unsigned char Pid4F[OBD_MAX_ECUS][4];
 unsigned char Pid50[OBD_MAX_ECUS][4];
 
@@ -86,6 +86,10 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 {
 	unsigned long EcuIndex;
 	unsigned long IdIndex;
+	unsigned long PackedIndex;
+	unsigned long PackedLastPid = 0;            // last PID covered by the current SID $1 request
+	BOOL fPackedRequest = FALSE;                // set if the current SID $1 request has multiple PIDs
+	BOOL fRequestFailed = FALSE;                // set if the current SID $1 request failed
 	SID_REQ SidReq;
 	SID1 *pSid1;
 	unsigned long SidIndex;
@@ -166,12 +170,13 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 	}
 
 
-	/* For each PID */
-	for (IdIndex = 0x01; IdIndex < MAX_PIDS; IdIndex++)
-	{
-		/* clear PID supported indicator */
-		fPidSupported[IdIndex] = FALSE;
+	/* clear PID supported indicators */
+	memset (fPidSupported, 0, sizeof(fPidSupported));
 
+	/* For each supported PID */
+	for (IdIndex = SupportMapNext (0x01, -1, 0x00); IdIndex < MAX_PIDS;
+	     IdIndex = SupportMapNext (0x01, -1, IdIndex))
+	{
 		/* skip PID supported PIDs */
 		if (IdIndex == 0x20 || IdIndex == 0x40 || IdIndex == 0x60 || IdIndex == 0x80 ||
 		    IdIndex == 0xA0 || IdIndex == 0xC0 || IdIndex == 0xE0)
@@ -179,28 +184,62 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 			continue;
 		}
 
-		if (IsSid1PidSupported (-1, IdIndex) == FALSE)
+		/* Request this PID, packed with the next supported PIDs on ISO15765 */
+		if (IdIndex > PackedLastPid)
 		{
-			continue;
-		}
+			SidReq.SID = 1;
+			SidReq.NumIds = 1;
+			SidReq.Ids[0] = (unsigned char)IdIndex;
+			PackedLastPid = IdIndex;
 
-		SidReq.SID = 1;
-		SidReq.NumIds = 1;
-		SidReq.Ids[0] = (unsigned char)IdIndex;
-		if ( SidRequest(&SidReq, SID_REQ_NORMAL) == FAIL )
-		{
-			/* There must be a response for ISO15765 protocol */
-			if (gOBDList[gOBDListIndex].Protocol == ISO15765)
+			if ( gOBDList[gOBDListIndex].Protocol == ISO15765 &&
+			     GetSid1PidDataSize ((unsigned char)IdIndex) >= 0 )
 			{
-				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-				     "SID $1 PID $%02X request\n", IdIndex );
-				continue;
+				for ( PackedIndex = SupportMapNext (0x01, -1, IdIndex);
+				      PackedIndex < MAX_PIDS && SidReq.NumIds < MAX_SID1_PACKED_PIDS;
+				      PackedIndex = SupportMapNext (0x01, -1, PackedIndex) )
+				{
+					if ( (PackedIndex & 0x1F) == 0 )
+					{
+						continue;
+					}
+
+					/* PIDs of unknown size can't be split out of the response */
+					if ( GetSid1PidDataSize ((unsigned char)PackedIndex) < 0 )
+					{
+						break;
+					}
+
+					SidReq.Ids[SidReq.NumIds++] = (unsigned char)PackedIndex;
+					PackedLastPid = PackedIndex;
+				}
 			}
+
+			fPackedRequest = (SidReq.NumIds > 1) ? TRUE : FALSE;
+			fRequestFailed = FALSE;
+
+			gSid1PackedRequest = fPackedRequest;
+			if ( SidRequest(&SidReq, SID_REQ_NORMAL) == FAIL )
+			{
+				/* There must be a response for ISO15765 protocol */
+				if (gOBDList[gOBDListIndex].Protocol == ISO15765)
+				{
+					fRequestFailed = TRUE;
+				}
+			}
+			gSid1PackedRequest = FALSE;
+		}
+
+		if (fRequestFailed == TRUE)
+		{
+			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+			     "SID $1 PID $%02X request\n", IdIndex );
+			continue;
 		}
 
 		for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
 		{
-			if (gOBDResponse[EcuIndex].Sid1PidSize != 0)
+			if (FindSid1PidData (EcuIndex, IdIndex, fPackedRequest, &SidIndex) == TRUE)
 			{
 				break;
 			}
@@ -228,11 +267,9 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 			/* If PID is supported, check it */
 			if (IsSid1PidSupported (EcuIndex, IdIndex) == TRUE)
 			{
-				SidIndex = 0;
-
 				/* Check the data to see if it is valid */
 				pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
-				if ( gOBDResponse[EcuIndex].Sid1PidSize == 0 )
+				if ( FindSid1PidData (EcuIndex, IdIndex, fPackedRequest, &SidIndex) == FALSE )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  PID $%02X supported but no data\n",
@@ -307,7 +344,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 						break;
 						case 0x04:
 						{
-							temp_data_float = (float)pSid1[SidIndex].Data[0] * (float)(100.0 / 255.0);
+							temp_data_float = GetSid1Sample (EcuIndex, SAMPLE_LOAD_PCT)->fValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  LOAD_PCT = %.1f %%\n", GetEcuId(EcuIndex), temp_data_float);
 
@@ -340,7 +377,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 						break;
 						case 0x05:
 						{
-							temp_data_long = pSid1[SidIndex].Data[0] - 40;
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_ECT)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  ECT = %d C\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -519,7 +556,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 						break;
 						case 0x0C:
 						{
-							temp_data_long = (((pSid1[SidIndex].Data[0] * 256) + pSid1[SidIndex].Data[1]) / 4);
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_RPM)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  RPM = %d rpm\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -868,8 +905,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 
 						case 0x1F:
 						{
-							temp_data_long = ((pSid1[SidIndex].Data[0] * 256) +
-							                  pSid1[SidIndex].Data[1]);
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_RUNTM)->lValue;
 							GetHoursMinsSecs( temp_data_long, &hours, &mins, &secs);
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  RUNTM = %d sec (%d hrs, %d mins, %d secs)\n",
@@ -914,8 +950,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 						break;
 						case 0x21:
 						{
-							temp_data_long = ((pSid1[SidIndex].Data[0] * 256) +
-							                  pSid1[SidIndex].Data[1]);
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_MIL_DIST)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  MIL_DIST = %d km\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -1106,7 +1141,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 
 						case 0x30:
 						{
-							temp_data_long = pSid1[SidIndex].Data[0];
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_WARM_UPS)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  WARM_UPS = %d\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -1143,8 +1178,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 						break;
 						case 0x31:
 						{
-							temp_data_long = ((pSid1[SidIndex].Data[0] * 256) +
-							                  pSid1[SidIndex].Data[1]);
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_CLR_DIST)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  CLR_DIST = %d km\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -1760,8 +1794,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 
 						case 0x4D:
 						{
-							temp_data_long = ( pSid1[SidIndex].Data[0] * 256 ) +
-							                 pSid1[SidIndex].Data[1];
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_MIL_TIME)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  MIL_TIME = %d min\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -1774,8 +1807,7 @@ STATUS VerifyDiagnosticSupportAndData( unsigned char OBDEngineDontCare )
 						break;
 						case 0x4E:
 						{
-							temp_data_long = ( pSid1[SidIndex].Data[0] * 256 ) +
-							                 pSid1[SidIndex].Data[1];
+							temp_data_long = GetSid1Sample (EcuIndex, SAMPLE_CLR_TIME)->lValue;
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  CLR_TIME = %d min\n", GetEcuId(EcuIndex), temp_data_long);
 
@@ -8008,34 +8040,10 @@ STATUS RequestSID1SupportData (void)
 //*****************************************************************************
 unsigned int IsSid1PidSupported (unsigned int EcuIndex, unsigned int PidIndex)
 {
-	int index1;
-	int index2;
-	int mask;
-
 	if (PidIndex == 0)
 		return TRUE;            // all modules must support SID 01 PID 00
 
-	PidIndex--;
-
-	index1 =  PidIndex >> 5;
-	index2 = (PidIndex >> 3) & 0x03;
-	mask   = 0x80 >> (PidIndex & 0x07);
-
-	if ((signed int)EcuIndex < 0)
-	{
-		for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
-		{
-			if (gOBDResponse[EcuIndex].Sid1PidSupport[index1].IDBits[index2] & mask)
-				return TRUE;
-		}
-	}
-	else
-	{
-		if (gOBDResponse[EcuIndex].Sid1PidSupport[index1].IDBits[index2] & mask)
-			return TRUE;
-	}
-
-	return FALSE;
+	return SupportMapTest (0x01, EcuIndex, PidIndex);
 }
 
 //*****************************************************************************
@@ -8054,6 +8062,7 @@ STATUS DetermineVariablePidSize (void)
 	unsigned long EcuIdIndex[OBD_MAX_ECUS];
 
 	unsigned long EcuIndex, numResp;
+	unsigned int  Pid;
 
 	/* only need to check once */
 	if (gSid1VariablePidSize != 0)
@@ -8063,14 +8072,13 @@ STATUS DetermineVariablePidSize (void)
 	gSid1VariablePidSize = -1;
 
 	/* only check if needed */
-	if ((IsSid1PidSupported (-1, 0x06) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x07) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x08) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x09) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x55) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x56) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x57) == FALSE) &&
-	    (IsSid1PidSupported (-1, 0x58) == FALSE) )
+	for (Pid = 0; Pid < MAX_PIDS; Pid++)
+	{
+		if (GetSid1PidDesc ((unsigned char)Pid)->DataSize == SID1_PID_VARIABLE_SIZE &&
+		    IsSid1PidSupported (-1, Pid) == TRUE)
+			break;
+	}
+	if (Pid == MAX_PIDS)
 		return PASS;
 
 	/* cannot support both PID $13 and $1D */
@@ -8344,3 +8352,42 @@ void GetHoursMinsSecs( unsigned long time, unsigned long *hours, unsigned long *
 
 	*secs = time - (*hours * 3600) - (*mins * 60);
 }
+
+
+//*****************************************************************************
+//
+//	Function:   FindSid1PidData
+//
+//	Purpose:    Find the SID1 entry holding the data for a PID.
+//	            A single PID response is always entry 0, a packed
+//	            (multiple PID) response has one entry per PID.
+//
+//*****************************************************************************
+BOOL FindSid1PidData (unsigned long EcuIndex, unsigned long Pid, BOOL fPacked, unsigned long *pSidIndex)
+{
+	SID1 *pSid1;
+	unsigned long SidIndex;
+
+	if ( gOBDResponse[EcuIndex].Sid1PidSize == 0 )
+	{
+		return (FALSE);
+	}
+
+	if ( fPacked == FALSE )
+	{
+		*pSidIndex = 0;
+		return (TRUE);
+	}
+
+	pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
+	for ( SidIndex = 0; SidIndex < (gOBDResponse[EcuIndex].Sid1PidSize / sizeof(SID1)); SidIndex++ )
+	{
+		if ( pSid1[SidIndex].PID == Pid )
+		{
+			*pSidIndex = SidIndex;
+			return (TRUE);
+		}
+	}
+
+	return (FALSE);
+}
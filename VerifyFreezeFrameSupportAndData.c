@@ -259,7 +259,7 @@ STATUS RequestSID2SupportData( unsigned short *pFreezeFrameDTC, unsigned long FF
 			{
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid2PidSize != 0)
+					if (gOBDResponse[EcuIndex].Sid2Pid.Size != 0)
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  Unexpected response to unsupported SID $2 PID $%02X!\n",
@@ -325,21 +325,21 @@ STATUS RequestSID2Pid2Data( unsigned short *pFreezeFrameDTC, unsigned short *pFF
 		pFreezeFrameDTC[EcuIndex] = 0;
 
 		/* Skip if no response or no DTCs stored */
-		if ( gOBDResponse[EcuIndex].Sid2PidSize != 0 )
+		if ( gOBDResponse[EcuIndex].Sid2Pid.Size != 0 )
 		{
 			/* Increment the count of ECUs which support SID $02 PID $02 */
 			*pFFDTCSupportCount = *pFFDTCSupportCount + 1;
 
-			if ( gOBDResponse[EcuIndex].Sid2Pid[1] != 0 ||
-			     gOBDResponse[EcuIndex].Sid2Pid[2] != 0 ||
-			     gOBDResponse[EcuIndex].Sid2Pid[3] != 0 )
+			if ( SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 1) != 0 ||
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 2) != 0 ||
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 3) != 0 )
 			{
 				/* Increment the count of ECUs which report a Freeze Fram DTC */
 				*pFFDTCCount = *pFFDTCCount + 1;
 
 				/* Save the DTC */
-				pFreezeFrameDTC[EcuIndex] = ((gOBDResponse[EcuIndex].Sid2Pid[2] * 256) +
-				                              gOBDResponse[EcuIndex].Sid2Pid[3]);
+				pFreezeFrameDTC[EcuIndex] = ((SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 2) * 256) +
+				                              SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 3));
 
 				/* Check if a DTC is not supposed to be present */
 				if ( ( gOBDDTCStored     == FALSE ) &&
@@ -349,7 +349,7 @@ STATUS RequestSID2Pid2Data( unsigned short *pFreezeFrameDTC, unsigned short *pFF
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $2 PID $2 Frame %d DTC stored\n",
 					     GetEcuId(EcuIndex),
-					     gOBDResponse[EcuIndex].Sid2Pid[1]);
+					     SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 1));
 					bReturn = FAIL;
 				}
 
@@ -359,7 +359,7 @@ STATUS RequestSID2Pid2Data( unsigned short *pFreezeFrameDTC, unsigned short *pFF
 					Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $2 PID $2 Frame %d DTC stored on pending fault\n",
 					     GetEcuId(EcuIndex),
-					     gOBDResponse[EcuIndex].Sid2Pid[1]);
+					     SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 1));
 					*FFSupOnPendFault = TRUE;
 				}
 			}
@@ -594,8 +594,9 @@ STATUS VerifyAllSID2Data( unsigned short *pFreezeFrameDTC, unsigned short FFDTCS
 		}
 
 
-		/* For each PID group */
-		for (IdIndex = 0x01; IdIndex < 0x100; IdIndex++)
+		/* For each supported PID */
+		for (IdIndex = SupportMapNext (0x02, EcuIndex, 0x00); IdIndex < 0x100;
+		     IdIndex = SupportMapNext (0x02, EcuIndex, IdIndex))
 		{
 			/* skip PID Supported PIDs */
 			if (IdIndex == 0x00 || IdIndex == 0x20 || IdIndex == 0x40 || IdIndex == 0x60 ||
@@ -676,8 +677,8 @@ STATUS VerifyAllSID2Data( unsigned short *pFreezeFrameDTC, unsigned short FFDTCS
 					/*  If PID $02 is not = $0000, it is a Failure */
 					if ( TestPhase == eTestNoDTC && TestSubsection == 11 &&
 					     IdIndex == 0x02 &&
-					     ( gOBDResponse[EcuIndex].Sid2Pid[2] != 0x00 ||
-					       gOBDResponse[EcuIndex].Sid2Pid[3] != 0x00 ) )
+					     ( SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 2) != 0x00 ||
+					       SidDataByte (&gOBDResponse[EcuIndex].Sid2Pid, 3) != 0x00 ) )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  Response to SID $2 PID $02 request indicates DTC present\n",
@@ -688,7 +689,7 @@ STATUS VerifyAllSID2Data( unsigned short *pFreezeFrameDTC, unsigned short FFDTCS
 
 					/* If ISO15765 and PID $02 == 0, there should be no response to PID request*/
 					if ( gOBDList[gOBDListIndex].Protocol == ISO15765 &&
-					     gOBDResponse[EcuIndex].Sid2PidSize != 0 &&
+					     gOBDResponse[EcuIndex].Sid2Pid.Size != 0 &&
 					     pFreezeFrameDTC[EcuIndex] == 0x00 &&
 					     IdIndex != 0x02 )
 					{
@@ -700,7 +701,7 @@ STATUS VerifyAllSID2Data( unsigned short *pFreezeFrameDTC, unsigned short FFDTCS
 					}
 
 					/*  If PID is supported and there is a Freeze Frame DTC, there should be a response */
-					if ( ( gOBDResponse[EcuIndex].Sid2PidSize == 0) &&
+					if ( ( gOBDResponse[EcuIndex].Sid2Pid.Size == 0) &&
 					     ( pFreezeFrameDTC[EcuIndex] != 0x00 ) )
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -824,32 +825,8 @@ STATUS VerifyAllSID2Data( unsigned short *pFreezeFrameDTC, unsigned short FFDTCS
 //*****************************************************************************
 unsigned int IsSid2PidSupported (unsigned int EcuIndex, unsigned int PidIndex)
 {
-	int index1;
-	int index2;
-	int mask;
-
 	if (PidIndex == 0)
 		return TRUE;            // all modules must support SID 02 PID 00
 
-	PidIndex--;
-
-	index1 =  PidIndex >> 5;
-	index2 = (PidIndex >> 3) & 0x03;
-	mask   = 0x80 >> (PidIndex & 0x07);
-
-	if ((signed int)EcuIndex < 0)
-	{
-		for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
-		{
-			if (gOBDResponse[EcuIndex].Sid2PidSupport[index1].IDBits[index2] & mask)
-				return TRUE;
-		}
-	}
-	else
-	{
-		if (gOBDResponse[EcuIndex].Sid2PidSupport[index1].IDBits[index2] & mask)
-			return TRUE;
-	}
-
-	return FALSE;
+	return SupportMapTest (0x02, EcuIndex, PidIndex);
 }
@@ -64,7 +64,7 @@ STATUS VerifyGroupControlSupport(void)
 	int bReqNextGroup;      /* Binary logic for request for next group! */
 
 	/* Save the original response data for comparison */
-	memcpy(&gOBDCompareResponse[0], &gOBDResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDCompareResponse[0], &gOBDResponse[0]);
 
 	/* Request SID 8 support data as a group */
 	SidReq.SID = 8;
@@ -148,7 +148,7 @@ STATUS VerifyGroupControlSupport(void)
 	if ( bTestFailed == TRUE )
 	{
 		/* Something was wrong, restore the original response data */
-		memcpy(&gOBDResponse[0], &gOBDCompareResponse[0], sizeof(gOBDResponse));
+		CopyOBDResponse (&gOBDResponse[0], &gOBDCompareResponse[0]);
 		return(FAIL);
 	}
 
@@ -67,7 +67,7 @@ STATUS VerifyGroupDiagnosticSupport(void)
 	int bReqNextGroup;		/* Binary logic for request for next group! */
 
 	/* Save the original response data for comparison */
-	memcpy(&gOBDCompareResponse[0], &gOBDResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDCompareResponse[0], &gOBDResponse[0]);
 
 	/* Request SID 1 support data as a group */
 	SidReq.SID = 1;
@@ -152,7 +152,7 @@ STATUS VerifyGroupDiagnosticSupport(void)
 	if ( bTestFailed == TRUE )
 	{
 		/* Something was wrong, restore the original response data */
-		memcpy(&gOBDResponse[0], &gOBDCompareResponse[0], sizeof(gOBDResponse));
+		CopyOBDResponse (&gOBDResponse[0], &gOBDCompareResponse[0]);
 		return(FAIL);
 	}
 
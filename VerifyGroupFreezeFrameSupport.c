@@ -66,7 +66,7 @@ STATUS VerifyGroupFreezeFrameSupport(unsigned short *pFreezeFrameDTC)
 	int bReqNextGroup;		/* Binary logic for request for next group! */
 
 	/* Save the original response data for comparison */
-	memcpy(&gOBDCompareResponse[0], &gOBDResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDCompareResponse[0], &gOBDResponse[0]);
 
 	/* Request SID 2 support data as a group */
 	SidReq.SID = 2;
@@ -193,7 +193,7 @@ STATUS VerifyGroupFreezeFrameSupport(unsigned short *pFreezeFrameDTC)
 	if ( bTestFailed == TRUE )
 	{
 		/* Something was wrong, restore the original response data */
-		memcpy(&gOBDResponse[0], &gOBDCompareResponse[0], sizeof(gOBDResponse));
+		CopyOBDResponse (&gOBDResponse[0], &gOBDCompareResponse[0]);
 		return(FAIL);
 	}
 
@@ -262,8 +262,8 @@ STATUS VerifyGroupFreezeFrameResponse (unsigned short *pFreezeFrameDTC)
 			else
 			{
 				/* save the original group response data for comparison */
-				Sid2GroupSize = gOBDResponse[EcuIndex].Sid2PidSize;
-				memcpy (Sid2Group, gOBDResponse[EcuIndex].Sid2Pid, Sid2GroupSize);
+				Sid2GroupSize = gOBDResponse[EcuIndex].Sid2Pid.Size;
+				memcpy (Sid2Group, SidDataPtr (&gOBDResponse[EcuIndex].Sid2Pid), Sid2GroupSize);
 
 				/* request each PID seperately */
 				for (IdIndex = 0, ByteIndex = 0; IdIndex < NumGroupIds; IdIndex++)
@@ -281,8 +281,8 @@ STATUS VerifyGroupFreezeFrameResponse (unsigned short *pFreezeFrameDTC)
 					}
 
 					/* save single response data */
-					Sid2Size[IdIndex] = gOBDResponse[EcuIndex].Sid2PidSize;
-					memcpy (&Sid2Single[ByteIndex], gOBDResponse[EcuIndex].Sid2Pid, Sid2Size[IdIndex]);
+					Sid2Size[IdIndex] = gOBDResponse[EcuIndex].Sid2Pid.Size;
+					memcpy (&Sid2Single[ByteIndex], SidDataPtr (&gOBDResponse[EcuIndex].Sid2Pid), Sid2Size[IdIndex]);
 					ByteIndex += Sid2Size[IdIndex];
 				}
 
@@ -63,7 +63,7 @@ STATUS VerifyGroupMonitorTestSupport(void)
 	int bReqNextGroup;		/* Binary logic for request for next group! */
 
 	/* Save the original response data for comparison */
-	memcpy(&gOBDCompareResponse[0], &gOBDResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDCompareResponse[0], &gOBDResponse[0]);
 
 	/* Request SID 6 support data as a group */
 	SidReq.SID = 6;
@@ -147,7 +147,7 @@ STATUS VerifyGroupMonitorTestSupport(void)
 	if ( bTestFailed == TRUE )
 	{
 		/* Something was wrong, restore the original response data */
-		memcpy(&gOBDResponse[0], &gOBDCompareResponse[0], sizeof(gOBDResponse));
+		CopyOBDResponse (&gOBDResponse[0], &gOBDCompareResponse[0]);
 		return(FAIL);
 	}
 
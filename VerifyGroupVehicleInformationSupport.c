@@ -66,7 +66,7 @@ STATUS VerifyGroupVehicleInformationSupport(void)
 	int bReqNextGroup;		/* Binary logic for request for next group! */
 
 	/* Save the original response data for comparison */
-	memcpy(&gOBDCompareResponse[0], &gOBDResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDCompareResponse[0], &gOBDResponse[0]);
 
 	/* Request SID 9 support data as a group */
 	SidReq.SID = 9;
@@ -147,7 +147,7 @@ STATUS VerifyGroupVehicleInformationSupport(void)
 	if ( bTestFailed == TRUE )
 	{
 		/* Something was wrong, restore the original response data */
-		memcpy(&gOBDResponse[0], &gOBDCompareResponse[0], sizeof(gOBDResponse));
+		CopyOBDResponse (&gOBDResponse[0], &gOBDCompareResponse[0]);
 		return(FAIL);
 	}
 
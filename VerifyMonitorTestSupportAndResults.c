@@ -220,8 +220,9 @@ STATUS VerifyMonitorTestSupportAndResults(void)
 
 		} /* end Test5.14.3 */
 
-		/* For each MID group */
-		for (IdIndex = 0x01; IdIndex < 0x100; IdIndex++)
+		/* For each supported MID */
+		for (IdIndex = SupportMapNext (0x06, EcuIndex, 0x00); IdIndex < 0x100;
+		     IdIndex = SupportMapNext (0x06, EcuIndex, IdIndex))
 		{
 			/* skip PID supported PIDs */
 			if (IdIndex == 0x20 || IdIndex == 0x40 || IdIndex == 0x60 || IdIndex == 0x80 ||
@@ -242,7 +243,7 @@ STATUS VerifyMonitorTestSupportAndResults(void)
 					continue;
 				}
 
-				if (gOBDResponse[EcuIndex].Sid6MidSize == 0)
+				if (gOBDResponse[EcuIndex].Sid6Mid.Size == 0)
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  No SID $6 MID $%02X data\n", GetEcuId(EcuIndex) , IdIndex);
@@ -251,8 +252,8 @@ STATUS VerifyMonitorTestSupportAndResults(void)
 				}
 
 				/* Check the data that should be reset and / or within limits */
-				pSid6 = (SID6 *)&gOBDResponse[EcuIndex].Sid6Mid[0];
-				for (SidIndex = 0; SidIndex < (gOBDResponse[EcuIndex].Sid6MidSize / sizeof(SID6)); SidIndex++)
+				pSid6 = (SID6 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid6Mid);
+				for (SidIndex = 0; SidIndex < (gOBDResponse[EcuIndex].Sid6Mid.Size / sizeof(SID6)); SidIndex++)
 				{
 					/*
 					** If ISO15765 protocol...
@@ -738,7 +739,7 @@ STATUS RequestSID6SupportData (void)
 				{
 					for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 					{
-						if (gOBDResponse[EcuIndex].Sid6MidSize != 0)
+						if (gOBDResponse[EcuIndex].Sid6Mid.Size != 0)
 						{
 							if ( Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, YES_NO_ALL_PROMPT,
 							          "ECU %X  Unexpected response to unsupported SID $6 MID $%02X!\n",
@@ -777,33 +778,8 @@ STATUS RequestSID6SupportData (void)
 */
 unsigned int IsSid6MidSupported (unsigned int EcuIndex, unsigned int MidIndex)
 {
-	unsigned int index0;
-	unsigned int index1;
-	unsigned int index2;
-	unsigned int mask;
-
 	if (MidIndex == 0)
 		return TRUE;            // all modules must support SID 06 MID 00
 
-	MidIndex--;
-
-	index1 =  MidIndex >> 5;
-	index2 = (MidIndex >> 3) & 0x03;
-	mask   = 0x80 >> (MidIndex & 0x07);
-
-	if ((signed int)EcuIndex < 0)
-	{
-		for (index0 = 0; index0 < gUserNumEcus; index0++)
-		{
-			if (gOBDResponse[index0].Sid6MidSupport[index1].IDBits[index2] & mask)
-				return TRUE;
-		}
-	}
-	else
-	{
-		if (gOBDResponse[EcuIndex].Sid6MidSupport[index1].IDBits[index2] & mask)
-			return TRUE;
-	}
-
-	return FALSE;
+	return SupportMapTest (0x06, EcuIndex, MidIndex);
 }
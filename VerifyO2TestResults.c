@@ -75,7 +75,7 @@ STATUS VerifyO2TestResults(void)
 	{
 		for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 		{
-			if (gOBDResponse[EcuIndex].Sid5TidSize != 0)
+			if (gOBDResponse[EcuIndex].Sid5Tid.Size != 0)
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  Response received for SID $5 (Not allowed for ISO15765 protocol)!\n",
@@ -122,7 +122,7 @@ STATUS VerifyPermanentCodeSupport(void)
 		for ( EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++ )
 		{
 			/* check the Permanent DTCs count */
-			if ( (gOBDResponse[EcuIndex].SidA[0] != 0x00) || (gOBDResponse[EcuIndex].SidA[1] != 0x00) )
+			if ( (SidDataByte (&gOBDResponse[EcuIndex].SidA, 0) != 0x00) || (SidDataByte (&gOBDResponse[EcuIndex].SidA, 1) != 0x00) )
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  SID $0A reports Permanent DTC stored\n", GetEcuId(EcuIndex) );
@@ -139,21 +139,21 @@ STATUS VerifyPermanentCodeSupport(void)
 		for ( EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++ )
 		{
 			/* Print out all the DTCs */
-			for (DataOffset = 0; DataOffset < gOBDResponse[EcuIndex].SidASize; DataOffset += 2)
+			for (DataOffset = 0; DataOffset < gOBDResponse[EcuIndex].SidA.Size; DataOffset += 2)
 			{
-				if ((gOBDResponse[EcuIndex].SidA[DataOffset] != 0) ||
-				    (gOBDResponse[EcuIndex].SidA[DataOffset + 1] != 0))
+				if ((SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset) != 0) ||
+				    (SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset + 1) != 0))
 				{
 					/* Process based on the type of DTC */
-					switch (gOBDResponse[EcuIndex].SidA[DataOffset] & 0xC0)
+					switch (SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset) & 0xC0)
 					{
 						case 0x00:
 						{
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Permanent DTC P%02X%02X detected\n",
 							      GetEcuId (EcuIndex),
-							      gOBDResponse[EcuIndex].SidA[DataOffset] & 0x3F,
-							      gOBDResponse[EcuIndex].SidA[DataOffset + 1]);
+							      SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset) & 0x3F,
+							      SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset + 1));
 						}
 						break;
 						case 0x40:
@@ -161,8 +161,8 @@ STATUS VerifyPermanentCodeSupport(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Permanent DTC C%02X%02X detected\n",
 							     GetEcuId (EcuIndex),
-							     gOBDResponse[EcuIndex].SidA[DataOffset] & 0x3F,
-							     gOBDResponse[EcuIndex].SidA[DataOffset + 1]);
+							     SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset) & 0x3F,
+							     SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset + 1));
 						}
 						break;
 						case 0x80:
@@ -170,8 +170,8 @@ STATUS VerifyPermanentCodeSupport(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Permanent DTC B%02X%02X detected\n",
 							      GetEcuId (EcuIndex),
-							      gOBDResponse[EcuIndex].SidA[DataOffset] & 0x3F,
-							      gOBDResponse[EcuIndex].SidA[DataOffset + 1]);
+							      SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset) & 0x3F,
+							      SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset + 1));
 						}
 						break;
 						case 0xC0:
@@ -179,8 +179,8 @@ STATUS VerifyPermanentCodeSupport(void)
 							Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 								 "ECU %X  Permanent DTC U%02X%02X detected\n",
 							     GetEcuId (EcuIndex),
-							     gOBDResponse[EcuIndex].SidA[DataOffset] & 0x3F,
-							     gOBDResponse[EcuIndex].SidA[DataOffset + 1]);
+							     SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset) & 0x3F,
+							     SidDataByte (&gOBDResponse[EcuIndex].SidA, DataOffset + 1));
 						}
 						break;
 					}
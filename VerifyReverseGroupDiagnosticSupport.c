@@ -137,7 +137,7 @@ STATUS VerifyReverseGroupDiagnosticSupport(void)
 
 
 	/* Restore the original response data for comparison */
-	memcpy(&gOBDResponse[0], &gOBDCompareResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDResponse[0], &gOBDCompareResponse[0]);
 
 	/* find the list of the last six PIDs supported by each ECU */
 	for (EcuIndex = 0; EcuIndex < gOBDNumEcus; EcuIndex++)
@@ -64,7 +64,7 @@ STATUS VerifyReverseOrderSupport(void)
 	BOOL bTestFailed = FALSE;
 
 	/* Save the original response data for comparison */
-	memcpy(&gOBDCompareResponse[0], &gOBDResponse[0], sizeof(gOBDResponse));
+	CopyOBDResponse (&gOBDCompareResponse[0], &gOBDResponse[0]);
 
 	ulInit_FailureCount = GetFailureCount();
 
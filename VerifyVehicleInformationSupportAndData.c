@@ -481,9 +481,9 @@ STATUS VerifyVehicleInformationSupportAndData (void)
 
 
 				/* Check the data to see if it is valid */
-				pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+				pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
-				if ( gOBDResponse[EcuIndex].Sid9InfSize == 0 )
+				if ( gOBDResponse[EcuIndex].Sid9Inf.Size == 0 )
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					          "ECU %X  No SID $9 INF $%X data\n", GetEcuId(EcuIndex), IdIndex );
@@ -515,7 +515,7 @@ STATUS VerifyVehicleInformationSupportAndData (void)
 							memcpy (&gVIN[0], &pSid9[0].Data[0], 17);
 
 							/// Check that there are no pad bytes included in message
-							if (pSid9[0].Data[20] != 0x00)
+							if (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 22) != 0x00)
 							{
 								bTestFailed = TRUE;
 								Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -546,7 +546,7 @@ STATUS VerifyVehicleInformationSupportAndData (void)
 
 							for (
 							      SidIndex = 0;
-							      SidIndex < (gOBDResponse[EcuIndex].Sid9InfSize / sizeof (SID9));
+							      SidIndex < (gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof (SID9));
 							      SidIndex++
 							    )
 							{
@@ -652,17 +652,17 @@ STATUS VerifyVehicleInformationSupportAndData (void)
 							bTestFailed = TRUE;
 						}
 
-						IGNCNTR = (gOBDResponse[EcuIndex].Sid9Inf[IPT_IGNCNTR_INDEX] * 256) + gOBDResponse[EcuIndex].Sid9Inf[IPT_IGNCNTR_INDEX+1];
+						IGNCNTR = (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, IPT_IGNCNTR_INDEX) * 256) + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, IPT_IGNCNTR_INDEX+1);
 
 						/* Response should match INF7 if not ISO15765 */
 						if ((gOBDList[gOBDListIndex].Protocol != ISO15765) &&
-						    (gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != Inf7NumItems[EcuIndex]))
+						    (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != Inf7NumItems[EcuIndex]))
 						{
 							bTestFailed = TRUE;
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $9 INF $8 (IPT) Message Count = %d (should match INF7)\n",
 							     GetEcuId(EcuIndex),
-							     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 						}
 					}
 					break;
@@ -695,23 +695,23 @@ STATUS VerifyVehicleInformationSupportAndData (void)
 
 						/* Response should match INF9 if not ISO15765 */
 						if ((gOBDList[gOBDListIndex].Protocol != ISO15765) &&
-							(gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != Inf9NumItems[EcuIndex]))
+							(SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != Inf9NumItems[EcuIndex]))
 						{
 							bTestFailed = TRUE;
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $9 INF $A (ECU Name) Message Count = %d (should match INF9)\n",
 							     GetEcuId(EcuIndex),
-							     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 						}
 
 						// Check for duplicate ECU Names
 						for ( EcuLoopIndex = 0; EcuLoopIndex < EcuIndex; EcuLoopIndex++ )
 						{
-							if (gOBDResponse[EcuIndex].Sid9InfSize != 0 &&
-							    gOBDResponse[EcuLoopIndex].Sid9InfSize != 0 &&
-							    memicmp(&gOBDResponse[EcuIndex].Sid9Inf[0],
-							            &gOBDResponse[EcuLoopIndex].Sid9Inf[0],
-							            gOBDResponse[EcuLoopIndex].Sid9InfSize) == 0 )
+							if (gOBDResponse[EcuIndex].Sid9Inf.Size != 0 &&
+							    gOBDResponse[EcuLoopIndex].Sid9Inf.Size != 0 &&
+							    memicmp(SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf),
+							            SidDataPtr (&gOBDResponse[EcuLoopIndex].Sid9Inf),
+							            gOBDResponse[EcuLoopIndex].Sid9Inf.Size) == 0 )
 							{
 								bTestFailed = TRUE;
 								Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -732,17 +732,17 @@ STATUS VerifyVehicleInformationSupportAndData (void)
 							bTestFailed = TRUE;
 						}
 
-						IGNCNTR = (gOBDResponse[EcuIndex].Sid9Inf[IPT_IGNCNTR_INDEX] * 256) + gOBDResponse[EcuIndex].Sid9Inf[IPT_IGNCNTR_INDEX+1];
+						IGNCNTR = (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, IPT_IGNCNTR_INDEX) * 256) + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, IPT_IGNCNTR_INDEX+1);
 
 						/* Response should match INF7 if not ISO15765 */
 						if ((gOBDList[gOBDListIndex].Protocol != ISO15765) &&
-						    (gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != Inf7NumItems[EcuIndex]))
+						    (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != Inf7NumItems[EcuIndex]))
 						{
 							bTestFailed = TRUE;
 							Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 							     "ECU %X  SID $9 INF $B (IPT) Message Count = %d (should match INF7)\n",
 							     GetEcuId(EcuIndex),
-							     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+							     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 						}
 					}
 					break;
@@ -1064,7 +1064,7 @@ STATUS RequestSID9SupportData (void)
 			{
 				for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 				{
-					if (gOBDResponse[EcuIndex].Sid9InfSize != 0)
+					if (gOBDResponse[EcuIndex].Sid9Inf.Size != 0)
 					{
 						Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 						     "ECU %X  Unexpected response to unsupported SID $9 INF $%X!\n", GetEcuId(EcuIndex), IdIndex );
@@ -1220,21 +1220,21 @@ STATUS VerifyCALIDFormat ( unsigned long EcuIndex, unsigned long Inf3NumItems )
 	STATUS         RetCode = PASS;
 	BOOL bCalidEnd = FALSE;
 
-	if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+	if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $4 data\n", GetEcuId(EcuIndex) );
 		return FAIL;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		Inf4NumItems = pSid9->NumItems;
 
 		// SID9 INF4 NODI must equal number of CALIDs
-		if ( (pSid9->NumItems) * 16 != (gOBDResponse[EcuIndex].Sid9InfSize - 2) )
+		if ( (pSid9->NumItems) * 16 != (gOBDResponse[EcuIndex].Sid9Inf.Size - 2) )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $4 NODI = %d mis-matched with Data Size\n",
@@ -1307,7 +1307,7 @@ STATUS VerifyCALIDFormat ( unsigned long EcuIndex, unsigned long Inf3NumItems )
 	{
 		// size of each CALIDs messsage checked in SidSaveResponseData.c
 
-		Sid9Limit = gOBDResponse[EcuIndex].Sid9InfSize / sizeof (SID9);
+		Sid9Limit = gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof (SID9);
 
 		for (SidIndex = 0; SidIndex < Sid9Limit; SidIndex += 4)
 		{
@@ -1419,21 +1419,21 @@ STATUS VerifyCVNFormat ( unsigned long EcuIndex, unsigned long Inf5NumItems )
 	char           buffer[26];
 	SID9          *pSid9;
 
-	if ( gOBDResponse[EcuIndex].Sid9InfSize == 0 )
+	if ( gOBDResponse[EcuIndex].Sid9Inf.Size == 0 )
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $6 (CVN) data\n", GetEcuId(EcuIndex) );
 		return PASS;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	if ( gOBDList[gOBDListIndex].Protocol == ISO15765 )
 	{
 		Inf6NumItems = pSid9->NumItems;
 
 		// SID9 INF6 NODI must equal number of CVNs
-		if ( (pSid9->NumItems) * 4 != (gOBDResponse[EcuIndex].Sid9InfSize - 2) )
+		if ( (pSid9->NumItems) * 4 != (gOBDResponse[EcuIndex].Sid9Inf.Size - 2) )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $6 NODI = %d mis-matched with Data Size\n",
@@ -1469,7 +1469,7 @@ STATUS VerifyCVNFormat ( unsigned long EcuIndex, unsigned long Inf5NumItems )
 	{
 		// size of each CVN checked in SidSaveResponseData.c
 
-		Sid9Limit = gOBDResponse[EcuIndex].Sid9InfSize / sizeof (SID9);
+		Sid9Limit = gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof (SID9);
 
 		for ( SidIndex = 0; SidIndex < Sid9Limit; SidIndex += 2 )
 		{
@@ -1624,25 +1624,25 @@ STATUS VerifyECUNameFormat ( unsigned long  EcuIndex )
 	unsigned char   bTestFailed = FALSE;
 	unsigned char   bMatchFound = FALSE;
 
-	if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+	if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $A data\n", GetEcuId(EcuIndex) );
 		return FAIL;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	// copy to a protocol independent buffer
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		// ECU Name Data must contain 20 bytes of data
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 20 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 20 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $A (ECU NAME) Data Size Error = %d (Must be 20 bytes!)\n",
 			     GetEcuId(EcuIndex),
-			     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+			     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 			return FAIL;
 		}
 
@@ -1664,7 +1664,7 @@ STATUS VerifyECUNameFormat ( unsigned long  EcuIndex )
 		** 5 (20 bytes) records.  Each response from controller held in
 		** data structure SID9.
 		*/
-		if ( gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9) != 0x05 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9) != 0x05 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $A (ECU Name) Data Size Error (Must be 20 bytes!)\n",
@@ -1673,17 +1673,17 @@ STATUS VerifyECUNameFormat ( unsigned long  EcuIndex )
 		}
 
 		// SID9 INF8 message count must equal $05
-		if ( gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != 0x05 ) // check to message number byte
+		if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != 0x05 ) // check to message number byte
 		{
 			bTestFailed = TRUE;
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $A Message Count = %d (Must be 5 ($05))\n",
 			     GetEcuId(EcuIndex),
-			     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 		}
 
 		// save ECU Name data to buffer
-		for ( MsgIndex = 0; MsgIndex < (gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9)); MsgIndex++ )
+		for ( MsgIndex = 0; MsgIndex < (gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9)); MsgIndex++ )
 		{
 			memcpy (&(buffer[MsgIndex * 4]), &(pSid9[MsgIndex].Data[0]), 4);
 		}
@@ -1984,41 +1984,41 @@ STATUS VerifyINF8Data ( unsigned long  EcuIndex )
 		     (gUserInput.eComplianceType == US_OBDII || gUserInput.eComplianceType == HD_OBD) )
 		{
 			// In-Use Performance Data must contain 56 bytes of data
-			if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 56 )
+			if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 56 )
 			{
 				if ( gModelYear >= 2019 &&	gModelYear <= 2020 )
 				{
 					Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $9 INF $8 (IPT) Data Size = %d (Must be 56 bytes!)\n",
 					     GetEcuId(EcuIndex),
-					     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+					     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 				}
 				else
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $9 INF $8 (IPT) Data Size = %d (Must be 56 bytes!)\n",
 					     GetEcuId(EcuIndex),
-					     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+					     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 					eResult = ERRORS;
 				}
 			}
 
 			// SID9 INF8 NODI must equal 28 ($1C)
-			if ( gOBDResponse[EcuIndex].Sid9Inf[1] != 0x1C )
+			if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x1C )
 			{
 				if ( gModelYear >= 2019 &&	gModelYear <= 2020 )
 				{
 					Log( WARNING, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $9 INF $8 NODI = %d (Must be 28 ($14))\n",
 					     GetEcuId(EcuIndex),
-					     gOBDResponse[EcuIndex].Sid9Inf[1] );
+					     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) );
 				}
 				else
 				{
 					Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 					     "ECU %X  SID $9 INF $8 NODI = %d (Must be 28 ($14))\n",
 					     GetEcuId(EcuIndex),
-					     gOBDResponse[EcuIndex].Sid9Inf[1] );
+					     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) );
 					eResult = ERRORS;
 				}
 			}
@@ -2029,48 +2029,48 @@ STATUS VerifyINF8Data ( unsigned long  EcuIndex )
 		     (gUserInput.eComplianceType == US_OBDII || gUserInput.eComplianceType == HD_OBD) )
 		{
 			// In-Use Performance Data must contain 40 bytes of data
-			if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 40 &&
-			     gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 56 )
+			if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 40 &&
+			     gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 56 )
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  SID $9 INF $8 (IPT) Data Size = %d (Must be 40 or 56 bytes!)\n",
 				     GetEcuId(EcuIndex),
-				     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+				     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 				eResult = ERRORS;
 			}
 
 			// SID9 INF8 NODI must equal $14
-			if ( gOBDResponse[EcuIndex].Sid9Inf[1] != 0x14 &&
-			     gOBDResponse[EcuIndex].Sid9Inf[1] != 0x1C )
+			if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x14 &&
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x1C )
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  SID $9 INF $8 NODI = %d (Must be 20 ($14) or 28 ($1C))\n",
 				     GetEcuId(EcuIndex),
-				     gOBDResponse[EcuIndex].Sid9Inf[1] );
+				     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) );
 				eResult = ERRORS;
 			}
 		}
 		else
 		{
 			// In-Use Performance Data must contain 32 or 40 bytes of data
-			if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 32 &&
-			     gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 40 )
+			if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 32 &&
+			     gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 40 )
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  SID $9 INF $8 (IPT) Data Size = %d (Must be 32 or 40 bytes!)\n",
 				     GetEcuId(EcuIndex),
-				     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+				     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 				return (FAIL);
 			}
 
 			// SID9 INF8 NODI must equal $10 or $14
-			if ( gOBDResponse[EcuIndex].Sid9Inf[1] != 0x10 &&
-			     gOBDResponse[EcuIndex].Sid9Inf[1] != 0x14 )
+			if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x10 &&
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x14 )
 			{
 				Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 				     "ECU %X  SID $9 INF $8 NODI = %d (Must be 16 ($10) or 20 ($14))\n",
 				     GetEcuId(EcuIndex),
-				     gOBDResponse[EcuIndex].Sid9Inf[1] );
+				     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) );
 				return (FAIL);
 			}
 		}
@@ -2081,8 +2081,8 @@ STATUS VerifyINF8Data ( unsigned long  EcuIndex )
 		** 8 (32 bytes) or 10 (40 bytes) records.  Each response from controller held in
 		** data structure SID9.
 		*/
-		if ( gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9) != 0x08 &&
-		     gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9) != 0x0A )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9) != 0x08 &&
+		     gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9) != 0x0A )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $8 (IPT) Data Size Error (Must be 32 or 40 bytes!)\n",
@@ -2091,13 +2091,13 @@ STATUS VerifyINF8Data ( unsigned long  EcuIndex )
 		}
 
 		// SID9 INF8 message count must equal $08 or $10
-		if ( gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != 0x08 && // check to message number byte
-			 gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != 0x0A )  // check to message number byte
+		if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != 0x08 && // check to message number byte
+			 SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != 0x0A )  // check to message number byte
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $8 Message Count = %d (Must be 8 ($08) or 10 ($0A))\n",
 			     GetEcuId(EcuIndex),
-			     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 			return (FAIL);
 		}
 	}
@@ -2147,35 +2147,35 @@ STATUS VerifyINFBData ( unsigned long  EcuIndex )
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		// In-Use Performance Data must contain 32 or 36 bytes of data
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 32 &&
-		     gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 36 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 32 &&
+		     gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 36 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $B (IPT) Data Size Error = %d (Must be 32 or 36 bytes!)\n",
 			     GetEcuId(EcuIndex),
-			     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+			     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 			return (FAIL);
 		}
 
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 == 32 &&
-		     gOBDResponse[EcuIndex].Sid9Inf[1] != 0x10 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 == 32 &&
+		     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x10 )
 		{
 			// SID9 INFB NODI must equal 16 if the data size is 32
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $B NODI = %d (Must be 16)\n",
 			     GetEcuId(EcuIndex),
-			     gOBDResponse[EcuIndex].Sid9Inf[1] );
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) );
 			return (FAIL);
 		}
 
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 == 36 &&
-		     gOBDResponse[EcuIndex].Sid9Inf[1] != 0x12 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 == 36 &&
+		     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) != 0x12 )
 		{
 			// SID9 INFB NODI must equal 18 if the data size is 36
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $B NODI = %d (Must be 18)\n",
 			     GetEcuId(EcuIndex),
-			     gOBDResponse[EcuIndex].Sid9Inf[1] );
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 1) );
 			return (FAIL);
 		}
 	}
@@ -2185,8 +2185,8 @@ STATUS VerifyINFBData ( unsigned long  EcuIndex )
 		** 8 (32 bytes) or 9 (36 bytes) records.  Each response from controller held in
 		** data structure SID9.
 		*/
-		if ( gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9) != 0x08 &&
-		     gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9) != 0x09 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9) != 0x08 &&
+		     gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9) != 0x09 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $B (IPT) Data Size Error (Must be 32 or 36 bytes!)\n",
@@ -2194,13 +2194,13 @@ STATUS VerifyINFBData ( unsigned long  EcuIndex )
 			return (FAIL);
 		}
 		// SID9 INFB message count must equal $08 or $09
-		if ( gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != 0x08 && // check to message number byte
-		     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != 0x09 )  // check to message number byte
+		if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != 0x08 && // check to message number byte
+		     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != 0x09 )  // check to message number byte
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $B Message Count = %d (Must be 8 ($08) or 9 ($09))\n",
 			     GetEcuId(EcuIndex),
-			     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 			return (FAIL);
 		}
 	}
@@ -2227,26 +2227,26 @@ STATUS VerifyInfDAndFFormat (unsigned long EcuIndex)
 	STATUS RetCode = PASS;
 	SID9 *pSid9;
 
-	if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+	if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $D data\n", GetEcuId(EcuIndex) );
 		return FAIL;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	// copy to a protocol independent buffer
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		// ESN Data must contain 17 bytes of data
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 17 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 17 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $%X Data Size Error = %d (Must be 17 bytes!)\n",
 			     GetEcuId(EcuIndex),
 			     pSid9->INF,
-			     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+			     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 			return FAIL;
 		}
 
@@ -2269,7 +2269,7 @@ STATUS VerifyInfDAndFFormat (unsigned long EcuIndex)
 		** 5 (20 bytes) records.  Each response from controller held in
 		** data structure SID9.
 		*/
-		if ( gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9) != 0x05 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9) != 0x05 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $%X Data Size Error (Must be 20 bytes!)\n",
@@ -2279,18 +2279,18 @@ STATUS VerifyInfDAndFFormat (unsigned long EcuIndex)
 		}
 
 		// SID9 INFC message count must equal $05
-		if ( gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] != 0x05 ) // check to message number byte
+		if ( SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) != 0x05 ) // check to message number byte
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $%X Message Count = %d (Must be 5)\n",
 			     GetEcuId(EcuIndex),
 			     pSid9->INF,
-			     gOBDResponse[EcuIndex].Sid9Inf[gOBDResponse[EcuIndex].Sid9InfSize - 5] );
+			     SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, gOBDResponse[EcuIndex].Sid9Inf.Size - 5) );
 			RetCode = FAIL;
 		}
 
 		// save ESN data to buffer
-		for ( MsgIndex = 0; MsgIndex < (gOBDResponse[EcuIndex].Sid9InfSize / sizeof(SID9)); MsgIndex++ )
+		for ( MsgIndex = 0; MsgIndex < (gOBDResponse[EcuIndex].Sid9Inf.Size / sizeof(SID9)); MsgIndex++ )
 		{
 			if (MsgIndex == 0)
 			{
@@ -2380,26 +2380,26 @@ STATUS VerifyInf12Format (unsigned long EcuIndex)
 	STATUS RetCode = PASS;
 	SID9 *pSid9;
 
-	if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+	if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $12 data\n", GetEcuId(EcuIndex) );
 		return FAIL;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	// copy to a protocol independent buffer
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		// FEOCNTR Data must contain 5 bytes of data
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 2 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 2 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $%X Data Size Error = %d (Must be 2 bytes!)\n",
 			     GetEcuId(EcuIndex),
 			     pSid9->INF,
-			     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+			     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 			return FAIL;
 		}
 
@@ -2436,26 +2436,26 @@ STATUS VerifyInf12Data (unsigned long EcuIndex, unsigned long IGNCNTR)
 	SID9 *pSid9;
 	unsigned long FEOCNTR;
 
-	if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+	if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $12 data\n", GetEcuId(EcuIndex) );
 		return FAIL;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	// copy to a protocol independent buffer
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		// FEOCNTR Data must contain 2 bytes of data
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 2 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 2 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $%X Data Size Error = %d (Must be 2 bytes!)\n",
 			     GetEcuId(EcuIndex),
 			     pSid9->INF,
-			     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+			     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 			return FAIL;
 		}
 
@@ -2470,7 +2470,7 @@ STATUS VerifyInf12Data (unsigned long EcuIndex, unsigned long IGNCNTR)
 			RetCode = FAIL;
 		}
 
-		FEOCNTR = (gOBDResponse[EcuIndex].Sid9Inf[2] * 256) + gOBDResponse[EcuIndex].Sid9Inf[3];
+		FEOCNTR = (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 2) * 256) + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 3);
 
 		// log FEOCNTR
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -2507,26 +2507,26 @@ STATUS VerifyInf14Data (unsigned long EcuIndex)
 	SID9 *pSid9;
 	unsigned long EVAP_DIST;
 
-	if (gOBDResponse[EcuIndex].Sid9InfSize == 0)
+	if (gOBDResponse[EcuIndex].Sid9Inf.Size == 0)
 	{
 		Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 		     "ECU %X  No SID $9 INF $14 data\n", GetEcuId(EcuIndex) );
 		return FAIL;
 	}
 
-	pSid9 = (SID9 *)&gOBDResponse[EcuIndex].Sid9Inf[0];
+	pSid9 = (SID9 *)SidDataPtr (&gOBDResponse[EcuIndex].Sid9Inf);
 
 	// copy to a protocol independent buffer
 	if (gOBDList[gOBDListIndex].Protocol == ISO15765)
 	{
 		// EVAP_DIST Data must contain 2 bytes of data
-		if ( gOBDResponse[EcuIndex].Sid9InfSize - 0x02 != 2 )
+		if ( gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02 != 2 )
 		{
 			Log( FAILURE, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
 			     "ECU %X  SID $9 INF $%X Data Size Error = %d (Must be 2 bytes!)\n",
 			     GetEcuId(EcuIndex),
 			     pSid9->INF,
-			     (gOBDResponse[EcuIndex].Sid9InfSize - 0x02) );
+			     (gOBDResponse[EcuIndex].Sid9Inf.Size - 0x02) );
 			return FAIL;
 		}
 
@@ -2541,7 +2541,7 @@ STATUS VerifyInf14Data (unsigned long EcuIndex)
 			RetCode = FAIL;
 		}
 
-		EVAP_DIST = (gOBDResponse[EcuIndex].Sid9Inf[2] * 256) + gOBDResponse[EcuIndex].Sid9Inf[3];
+		EVAP_DIST = (SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 2) * 256) + SidDataByte (&gOBDResponse[EcuIndex].Sid9Inf, 3);
 
 		// log FEOCNTR
 		Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
@@ -2632,33 +2632,8 @@ int VerifySid9PidSupportData (void)
 //*****************************************************************************
 unsigned int IsSid9InfSupported (unsigned int EcuIndex, unsigned int InfIndex)
 {
-	unsigned int index0;
-	unsigned int index1;
-	unsigned int index2;
-	unsigned int mask;
-
 	if (InfIndex == 0)
 		return TRUE;            // all modules must support SID 09 INF 00
 
-	InfIndex--;
-
-	index1 =  InfIndex >> 5;
-	index2 = (InfIndex >> 3) & 0x03;
-	mask   = 0x80 >> (InfIndex & 0x07);
-
-	if ((signed int)EcuIndex < 0)
-	{
-		for (index0 = 0; index0 < gUserNumEcus; index0++)
-		{
-			if (gOBDResponse[index0].Sid9InfSupport[index1].IDBits[index2] & mask)
-				return TRUE;
-		}
-	}
-	else
-	{
-		if (gOBDResponse[EcuIndex].Sid9InfSupport[index1].IDBits[index2] & mask)
-			return TRUE;
-	}
-
-	return FALSE;
+	return SupportMapTest (0x09, EcuIndex, InfIndex);
 }
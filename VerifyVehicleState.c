@@ -134,7 +134,7 @@ STATUS VerifyVehicleState (unsigned char ucEngineRunning, unsigned char ucHybrid
 STATUS LogRPM (unsigned short *pusRPM)
 {
 	SID_REQ         SidReq;
-	SID1            *pSid1;
+	const DECODED_SAMPLE *pSample;
 	unsigned short  RPM = 0;
 	unsigned long   EcuIndex;
 	STATUS          eRetCode = FAIL;
@@ -155,22 +155,14 @@ STATUS LogRPM (unsigned short *pusRPM)
 	{
 		for (EcuIndex = 0; EcuIndex < gUserNumEcus; EcuIndex++)
 		{
-			if (gOBDResponse[EcuIndex].Sid1PidSize > 0)
+			pSample = GetSid1Sample (EcuIndex, SAMPLE_RPM);
+			if (pSample->fValid == TRUE)
 			{
-				pSid1 = (SID1 *)&gOBDResponse[EcuIndex].Sid1Pid[0];
+				RPM = (unsigned short)pSample->lValue;
 
-				if (pSid1->PID == 0x0c)
-				{
-					RPM = pSid1->Data[0];
-					RPM = RPM << 8 | pSid1->Data[1];
-
-					// convert from 1 cnt = 1/4 RPM to 1 cnt = 1 RPM
-					RPM >>= 2;
-
-					Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
-						 "ECU %X  RPM = %d\n", GetEcuId(EcuIndex), RPM );
-					eRetCode = PASS;
-				}
+				Log( INFORMATION, SCREENOUTPUTON, LOGOUTPUTON, NO_PROMPT,
+				     "ECU %X  RPM = %d\n", GetEcuId(EcuIndex), RPM );
+				eRetCode = PASS;
 			}
 		}
 	}
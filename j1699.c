@@ -87,7 +87,7 @@
 */
 const char szJ1699_VER[] = "J1699-3";
 
-const char gszAPP_REVISION[] = "16.00.01";
+const char gszAPP_REVISION[] = "16.01.00";
 
 const char szBUILD_DATE[] = __DATE__;
 
@@ -273,8 +273,8 @@ char *gVehicleTypeStrings[] =            // strings that represent the user sele
 char *g_rgpcDisplayStrings[] =  // strings used for display/logging, kept here to insure consistent text
 {
 	"Model Year of this vehicle? " ,                                       // DSPSTR_PRMPT_MODEL_YEAR
-	"How many OBD-II ECUs are on this vehicle (1 to 8)?  ",                // DSPSTR_PRMPT_OBD_ECU
-	"How many reprogrammable OBD-II ECUs are on this vehicle (1 to 8)?  ", // DSPSTR_PRMPT_RPGM_ECU
+	"How many OBD-II ECUs are on this vehicle (1 to 32)?  ",               // DSPSTR_PRMPT_OBD_ECU
+	"How many reprogrammable OBD-II ECUs are on this vehicle (1 to 32)?  ",// DSPSTR_PRMPT_RPGM_ECU
 	"What type of engine is in this vehicle?  ",                           // DSPSTR_PRMPT_ENG_TYPE
 	"What type of powertrain is in this vehicle?  ",                       // DSPSTR_PRMPT_PWRTRN_TYPE
 	"What type of compliance test is to be performed?  ",                  // DSPSTR_STMT_COMPLIANCE_TYPE
@@ -329,13 +329,16 @@ unsigned char gOBDDynoCertFlag = FALSE;         // set by the user if this is a
 
 unsigned long gOBDProtocolOrder = 0;
 unsigned long gOBDMonitorCount = 0;
-ECU_TIMING_DATA gEcuTimingData[OBD_MAX_ECUS];
+ECU_TIMING_DATA *gEcuTimingData = NULL;
+unsigned long gSidReadCalls = 0;                // number of PassThruReadMsgs calls made by SidRequest
+unsigned long gSidReadMsgs = 0;                 // number of messages returned by those calls
 unsigned long gLastLogTime = 0;
 unsigned char gIgnoreUnsupported = FALSE;
 unsigned char gSuspendScreenOutput = FALSE;
 unsigned char gSuspendLogOutput = FALSE;
-OBD_DATA gOBDResponse[OBD_MAX_ECUS];
-OBD_DATA gOBDCompareResponse[OBD_MAX_ECUS];
+OBD_DATA *gOBDResponse = NULL;
+OBD_DATA *gOBDCompareResponse = NULL;
+unsigned long gOBDEcuCapacity = 0;
 char gVIN[18] = {0};
 FILE *ghLogFile = NULL;
 FILE *ghTempLogFile = NULL;
@@ -346,12 +349,62 @@ PASSTHRU_MSG gTesterPresentMsg = {0};
 BOOL gPeriodicMsgEnabled = TRUE;
 /*********************************************/
 
+/*********************************************/
+/* Option to use the receive thread          */
+BOOL gRxThreadEnabled = FALSE;
+/*********************************************/
+
+/*********************************************/
+/* Option to write the log file from a       */
+/* writer thread                             */
+BOOL gLogWriterEnabled = TRUE;
+/*********************************************/
+
+/*********************************************/
+/* Option to also write the network frames   */
+/* to a binary .j1t trace file (see j1tdump) */
+BOOL gTraceFileEnabled = FALSE;
+char gTraceFileName[MAX_PATH] = {0};
+/*********************************************/
+
+/*********************************************/
+/* Option to probe the CAN protocols first   */
+BOOL gFastCanDetectEnabled = TRUE;
+/*********************************************/
+
+/*********************************************/
+/* Option to use the connect info cache      */
+/* (development runs only)                   */
+BOOL gConnectCacheEnabled = FALSE;
+/*********************************************/
+
+/*********************************************/
+/* ISO15765 flow control profile             */
+unsigned long gISO15765FlowProfile = ISO15765_FC_MAX_THROUGHPUT;
+unsigned long gISO15765BlockSize   = 0;    /* ISO15765_FC_CUSTOM only */
+unsigned long gISO15765STmin       = 0;    /* ISO15765_FC_CUSTOM only */
+/*********************************************/
+
+/*********************************************/
+/* Transaction ring buffer size in MBytes    */
+/* (0 = MAX_RING_BUFFER_SIZE bytes), and     */
+/* what a failure in the Manufacturer        */
+/* Specific Drive Cycle dumps from it: the   */
+/* last gTransactionDumpCount transactions,  */
+/* or if gTransactionDumpSecs is not 0, the  */
+/* transactions of that many last seconds    */
+unsigned long gTransactionBufferMB  = 4;
+unsigned long gTransactionDumpCount = DESIRED_DUMP_SIZE;
+unsigned long gTransactionDumpSecs  = 0;
+/*********************************************/
+
 unsigned long gOBDNumEcusCan = 0  ;               /* by Honda */
 unsigned char gOBDResponseTA[OBD_MAX_ECUS] = {0}; /* by Honda */
 
 long gSid1VariablePidSize = 0;
+BOOL gSid1PackedRequest = FALSE;                // TRUE while a packed (multiple PID) SID $1 request is outstanding
 
-DTC_LIST gDTCList[OBD_MAX_ECUS];
+DTC_LIST *gDTCList = NULL;
 
 unsigned long gulDeviceID = 0;      // global storage for J2534-1 Device ID
 
@@ -422,14 +475,37 @@ int main(int argc, char **argv)
 	setbuf(stdout, NULL);
 
 	/* initialize required variables */
-	memset(&gDTCList[0], 0x00, (sizeof(DTC_LIST)) * OBD_MAX_ECUS);
-	memset(&gOBDResponse[0], 0x00, (sizeof(OBD_DATA)) * OBD_MAX_ECUS);
-	memset(&gOBDCompareResponse[0], 0x00, (sizeof(OBD_DATA)) * OBD_MAX_ECUS);
 	memset(&gOBDList[0], 0x00, (sizeof(PROTOCOL_LIST)) * OBD_MAX_PROTOCOLS);
-	memset(&gEcuTimingData[0], 0x00, (sizeof(ECU_TIMING_DATA)) * OBD_MAX_ECUS);
+	if (EcuTableReserve(OBD_INITIAL_ECUS) != PASS)
+	{
+		printf ("Cannot allocate the ECU tables\n");
+		return FAIL;
+	}
+	EcuRegistryReset();
 
+	if (TransactionBufferReserve() != PASS)
+	{
+		printf ("Cannot allocate the transaction ring buffer\n");
+		return FAIL;
+	}
 	ClearTransactionBuffer();	/* initialize log file ring buffer for Mfg. Spec. Drive Cycle */
 
+	/* write the log file from a writer thread (written directly if it cannot start) */
+	if (gLogWriterEnabled == TRUE)
+	{
+		LogWriterStart();
+	}
+
+	/* trace the network frames to a .j1t file (the test runs without it if it cannot be created) */
+	if (gTraceFileEnabled == TRUE)
+	{
+		if (TraceFileOpen() != PASS)
+		{
+			printf ("Cannot create trace file %s\n", gTraceFileName);
+			gTraceFileName[0] = 0;
+		}
+	}
+
 	gLastLogTime = GetTickCount();	/* Get the start time for the log file */
 
 	/* Send out the banner */
@@ -609,6 +685,9 @@ STATUS AppendLogFile (void)
 {
 	char buf[1024];
 
+	/* write out anything queued for the log file */
+	LogWriterFlush ();
+
 	/* move to beginning of temp log file */
 	fflush (ghTempLogFile);
 	fseek (ghTempLogFile, 0, SEEK_SET);
@@ -663,6 +742,20 @@ void AbortTest (void)
 	exit (ABORT);
 }
 
+/*
+********************************************************************************
+** EndSubsectionStats - Log the request statistics of the finished test
+**                      subsection, called just before its result is logged
+********************************************************************************
+*/
+void EndSubsectionStats (void)
+{
+	LogPeriodicMsgStats ();
+	LogPacingStats ();
+	LogTimingStats ();
+	LogMultiFrameStats ();
+}
+
 
 
 /*
@@ -712,6 +805,11 @@ void LogVersionInformation
 	/* Let the user know what version is being run and the log file name */
 	Log( INFORMATION, bDisplay, bLog, NO_PROMPT,
 	     "**** LOG FILENAME %s ****\n", gLogFileName);
+	if (gTraceFileName[0] != 0)
+	{
+		Log( INFORMATION, bDisplay, bLog, NO_PROMPT,
+		     "**** TRACE FILENAME %s ****\n", gTraceFileName);
+	}
 
 	LogSoftwareVersion( bDisplay, bLog );
 
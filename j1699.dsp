@@ -94,6 +94,10 @@ SOURCE=.\ClearCodes.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\ConnectCache.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\ConnectProtocol.c
 # End Source File
 # Begin Source File
@@ -106,6 +110,10 @@ SOURCE=.\DisconnectProtocol.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\EcuRegistry.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\FindJ2534Interface.c
 # End Source File
 # Begin Source File
@@ -126,6 +134,10 @@ SOURCE=.\j1699.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\LogFormat.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\LogMsg.c
 # End Source File
 # Begin Source File
@@ -134,6 +146,30 @@ SOURCE=.\LogPrint.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\LogWriter.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\ReceiveThread.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\RequestPacing.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\ResponseStore.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\ResponseTiming.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\SampleCache.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\ScreenOutput.c
 # End Source File
 # Begin Source File
@@ -154,6 +190,10 @@ SOURCE=.\StopTest.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\SupportMap.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\TestToVerifyInUseCounters.c
 # End Source File
 # Begin Source File
@@ -186,6 +226,10 @@ SOURCE=.\TestWithPendingDtc.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\TraceFile.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\VerifyControlSupportAndData.c
 # End Source File
 # Begin Source File
@@ -90,22 +90,47 @@ extern PTCLOSE PassThruClose;
 /* 4.9 seconds between tester present messages */
 #define OBD_TESTER_PRESENT_RATE  2000
 
+/* Maximum number of messages retrieved by one PassThruReadMsgs call */
+#define OBD_MAX_READ_MSGS        16
+
+/* Number of PID/MID/TID/INF values (IDs $00-$FF) */
+#define MAX_PIDS                 0x100
+
+/* Maximum number of PIDs in one packed SID $1 request (ISO15765) */
+#define MAX_SID1_PACKED_PIDS     6
+
+/* SID $1 PID descriptor data sizes that are not a byte count */
+#define SID1_PID_UNKNOWN_SIZE    (-1)   /* PID not defined by J1979 */
+#define SID1_PID_VARIABLE_SIZE   (-2)   /* PIDs $06-$09, $55-$58, see gSid1VariablePidSize */
+
 /* Time delay to allow for code clearing */
 #define CLEAR_CODES_DELAY_MSEC   2000
 
 /* Maximum number of OBD ECUs and protocols */
-#define OBD_MAX_ECUS             8
+#define OBD_MAX_ECUS             32    /* the ECU tables grow up to this many ECUs */
+#define OBD_INITIAL_ECUS         8     /* ECU table size before any ECU responds */
+#define OBD_ECUS_PER_PAGE        8     /* ECUs shown at once by the drive cycle displays */
 #define OBD_MAX_US_PROTOCOLS     7
 #define OBD_MAX_EU250K_PROTOCOLS 7
 #define OBD_MAX_EU_PROTOCOLS     9
 #define OBD_MAX_PROTOCOLS        OBD_MAX_EU_PROTOCOLS  /* the largest number of protocols possible */
 
+/* Maximum number of ECU headers in the ECU registry (responders, not just OBD ECUs) */
+#define ECU_REGISTRY_MAX_ENTRIES 64
+#if ECU_REGISTRY_MAX_ENTRIES < OBD_MAX_ECUS
+#error ECU_REGISTRY_MAX_ENTRIES must be at least OBD_MAX_ECUS
+#endif
+#define ECU_REGISTRY_NONE        0xFFFFFFFF   /* registry entry has no slot */
+
 /* OBD response indicator bit */
 #define OBD_RESPONSE_BIT         0x40
 
 /* Maximum number of bytes in ISO15765 frame */
 #define ISO15765_MAX_BYTES_PER_FRAME 7
 
+/* Worst case time from FirstFrame indication to the complete ISO15765 message */
+#define ISO15765_TRANSFER_TIMEOUT_MSECS 30000
+
 /* earliest allowable model year */
 #define MIN_MODEL_YEAR           1981
 
@@ -123,8 +148,9 @@ extern PTCLOSE PassThruClose;
 #define MAX_LOG_STRING_SIZE      2048   /* max. size of a single log entry */
 #define MAX_MESSAGE_LOG_SIZE     640    /* max. number of message bytes in a single log entry */
 #define DESIRED_DUMP_SIZE        8      /* desired number of transactions to be dumped from ring buffer */
-#define MAX_TRANSACTION_COUNT    (DESIRED_DUMP_SIZE + 1)  /* max. number of transactions in ring buffer */
-#define MAX_RING_BUFFER_SIZE     16384  /* max size of transaction ring buffer */
+#define MAX_TRANSACTION_COUNT    (DESIRED_DUMP_SIZE + 1)  /* min. number of transactions in ring buffer */
+#define MAX_RING_BUFFER_SIZE     16384  /* size of transaction ring buffer if gTransactionBufferMB is 0 */
+#define TRANSACTION_LIST_BYTES   64     /* transaction ring buffer bytes per transaction list entry */
 
 
 /* Function return value definitions (sometimes treated as bit map, DO NOT CHANGE VALUES!) */
@@ -287,6 +313,49 @@ typedef enum {eTestNone=0, eTestNoDTC=5, eTestPendingDTC, eTestConfirmedDTC, eTe
 #define LOG_NORMAL_MSG          0
 #define LOG_REQ_MSG             1
 
+/*
+** A network frame as LogMsg logs it.  While log output is suspended the
+** frame is kept in this form in the transaction ring buffer (followed by
+** its NumBytes data bytes) and only formatted if the transaction is logged.
+*/
+typedef struct
+{
+	unsigned long  ElapsedMsecs;   /* msecs since the previous log entry */
+	unsigned long  ProtocolID;
+	unsigned long  RxStatus;
+	unsigned long  Timestamp;
+	unsigned short Flags;          /* LogMsg Flags */
+	unsigned short NumBytes;       /* number of data bytes logged */
+	unsigned char  fChecksum;      /* TRUE if the ISO9141/ISO14230 Checksum is logged */
+	unsigned char  Checksum;
+} LOG_FRAME;
+
+/*
+** .j1t trace file (gTraceFileEnabled): a TRACE_FILE_HEADER followed by
+** records, each a TRACE_RECORD_HEADER and Length bytes of record data.
+** TRACE_FRAME data is a LOG_FRAME and its NumBytes data bytes.  TRACE_MARKER
+** data is the TestPhase and TestSubsection bytes and the text of the
+** TEST: / RESULTS: log entry that starts or ends a test (sub)section.
+*/
+#define TRACE_FILE_MAGIC        "J1T"
+#define TRACE_FILE_VERSION      1
+#define TRACE_FRAME             1
+#define TRACE_MARKER            2
+
+typedef struct
+{
+	char           Magic[4];      /* TRACE_FILE_MAGIC */
+	unsigned long  Version;       /* TRACE_FILE_VERSION */
+	unsigned long  StartTime;     /* time() at the start of the trace */
+} TRACE_FILE_HEADER;
+
+typedef struct
+{
+	unsigned short Length;        /* number of record data bytes following this header */
+	unsigned short Type;          /* TRACE_FRAME / TRACE_MARKER */
+	unsigned long  TraceMsecs;    /* msecs since the start of the trace */
+} TRACE_RECORD_HEADER;
+
 /* Macros */
 #define ABORT_RETURN   {gOBDTestAborted = TRUE;gOBDTestSectionAborted = TRUE;return(ABORT);}
 
@@ -327,6 +396,13 @@ typedef struct
 	unsigned char Data[41];
 } SID1;
 
+/* SID $1 PID descriptor, one entry per PID byte */
+typedef struct
+{
+	signed char   DataSize;     // data bytes (not including the PID byte) or SID1_PID_xxx_SIZE
+	const char   *szName;       // J1979 PID description, NULL if unknown
+} SID1_PID_DESC;
+
 typedef struct
 {
 	unsigned char PID;
@@ -363,6 +439,31 @@ typedef struct
 	unsigned short Flags;       // application flags. set 1 when valid
 } SID9IPT;
 
+/* SID $1 values decoded once per response by the sample cache (SampleCache.c) */
+typedef enum
+{
+	SAMPLE_LOAD_PCT = 0,        // PID $04, % (fValue)
+	SAMPLE_ECT,                 // PID $05, C
+	SAMPLE_RPM,                 // PID $0C, rpm
+	SAMPLE_VSS,                 // PID $0D, km/h
+	SAMPLE_OBDSUP,              // PID $1C, OBD requirements code
+	SAMPLE_RUNTM,               // PID $1F, sec
+	SAMPLE_MIL_DIST,            // PID $21, km
+	SAMPLE_WARM_UPS,            // PID $30
+	SAMPLE_CLR_DIST,            // PID $31, km
+	SAMPLE_MIL_TIME,            // PID $4D, min
+	SAMPLE_CLR_TIME,            // PID $4E, min
+	SAMPLE_NUM_VALUES
+} SAMPLE_ID;
+
+typedef struct
+{
+	BOOL           fValid;      // set when the PID is saved, cleared when it is requested again
+	unsigned long  TimeMsecs;   // GetTickCount when the response was saved
+	long           lValue;      // value in engineering units (truncated)
+	float          fValue;      // value in engineering units
+} DECODED_SAMPLE;
+
 typedef struct
 {
 	unsigned char FirstID;
@@ -376,6 +477,17 @@ typedef struct
 	unsigned char IDBits[4];
 } FF_SUPPORT;
 
+/* Maximum number of bytes of SID response data saved for one ECU and SID */
+#define OBD_MAX_SID_DATA_SIZE    2048
+
+/* SID response data, sized on demand from the response store (ResponseStore.c) */
+typedef struct
+{
+	unsigned short  Size;               // number of bytes of response data
+	unsigned short  Capacity;           // number of bytes available at pData
+	unsigned char  *pData;              // NULL until response data is saved
+} SID_DATA;
+
 typedef struct
 {
 	unsigned char   Header[4];
@@ -387,49 +499,66 @@ typedef struct
 	unsigned char   Sid1PidSupportSize;
 	ID_SUPPORT      Sid1PidSupport[8];
 	unsigned short  Sid1PidSize;
-	unsigned char   Sid1Pid[246];       // 6 * largest PID (81 - 41 bytes)
+	unsigned char   Sid1Pid[MAX_SID1_PACKED_PIDS * sizeof(SID1)];   // 6 * largest PID (41 bytes + PID)
 
 	unsigned char   Sid2PidSupportSize;
 	FF_SUPPORT      Sid2PidSupport[8];
-	unsigned short  Sid2PidSize;
-	unsigned char   Sid2Pid[2048];
+	SID_DATA        Sid2Pid;
 
 	BOOL            Sid3Supported;
-	unsigned short  Sid3Size;           // number of bytes in array Sid3
-	unsigned char   Sid3[2048];
+	SID_DATA        Sid3;
 
 	unsigned short  Sid4Size;
 	unsigned char   Sid4[8];
 
 	unsigned char   Sid5TidSupportSize;
 	ID_SUPPORT      Sid5TidSupport[8];
-	unsigned short  Sid5TidSize;
-	unsigned char   Sid5Tid[2048];
+	SID_DATA        Sid5Tid;
 
 	unsigned char   Sid6MidSupportSize;
 	ID_SUPPORT      Sid6MidSupport[8];
-	unsigned short  Sid6MidSize;
-	unsigned char   Sid6Mid[2048];
+	SID_DATA        Sid6Mid;
 
 	BOOL            Sid7Supported;
-	unsigned short  Sid7Size;           // number of bytes in array Sid7
-	unsigned char   Sid7[2048];
+	SID_DATA        Sid7;
 
 	unsigned char   Sid8TidSupportSize;
 	ID_SUPPORT      Sid8TidSupport[8];
-	unsigned short  Sid8TidSize;
-	unsigned char   Sid8Tid[2048];
+	SID_DATA        Sid8Tid;
 
 	unsigned char   Sid9InfSupportSize;
 	ID_SUPPORT      Sid9InfSupport[8];
-	unsigned short  Sid9InfSize;
-	unsigned char   Sid9Inf[2048];
+	SID_DATA        Sid9Inf;
 
 	BOOL            SidASupported;
-	unsigned short  SidASize;           // number of bytes in array SidA
-	unsigned char   SidA[2048];
+	SID_DATA        SidA;
 } OBD_DATA;
 
+/* Response time histogram, log-linear buckets of microseconds */
+#define RESP_HIST_LINEAR        16      /* 0-15 usec, one bucket per usec */
+#define RESP_HIST_SUB_BUCKETS   8       /* buckets per power of 2 above that */
+#define RESP_HIST_POWERS        22      /* 16 usec to 67 sec, later goes in the last bucket */
+#define RESP_HIST_BUCKETS       (RESP_HIST_LINEAR + (RESP_HIST_POWERS * RESP_HIST_SUB_BUCKETS))
+#define RESP_HIST_NUM_SIDS      11      /* SID $01-$0A, index 0 for any other SID */
+
+typedef struct
+{
+	unsigned long   Count;
+	unsigned long   Bucket[RESP_HIST_BUCKETS];
+} RESP_TIME_HIST;
+
+/* ISO15765 segmented response in progress from one ECU */
+typedef struct
+{
+	BOOL            Active;                      // FirstFrame seen, message not yet complete
+	unsigned long   FirstFrameTimestamp;         // interface time of the FirstFrame indication
+	unsigned long   FirstFrameHostUsecs;         // host time the FirstFrame indication was read
+	BOOL            FirstFrameHostValid;         // FirstFrameHostUsecs is known
+	unsigned long   DeadlineMsecs;               // GetTickCount time the message is due by
+	unsigned long   NumBytes;                    // bytes in the completed message
+	unsigned long   TransferUsecs;               // FirstFrame indication to complete message
+} ISO15765_TRANSFER;
+
 typedef struct
 {
 	unsigned long   EcuId;                       //	ID of the ECU 
@@ -442,8 +571,18 @@ typedef struct
 	unsigned long   RespTimeOutofRange;          // Count of response times out of range
 	unsigned long   RespTimeTooLate;             // Count of response times too long
 	unsigned long   RespTimeTooSoon;             // Count of response times too short
+	RESP_TIME_HIST  RespTimeHist[RESP_HIST_NUM_SIDS];  // Response time distribution per SID
+	ISO15765_TRANSFER Transfer;                  // segmented response from this ECU
 } ECU_TIMING_DATA;
 
+/* ECU registry entry, one per response header */
+typedef struct
+{
+	unsigned long   Key;                         // packed header, ISO14230 length bits masked
+	unsigned long   EcuIndex;                    // gOBDResponse index or ECU_REGISTRY_NONE
+	unsigned long   EcuTimingIndex;              // gEcuTimingData index or ECU_REGISTRY_NONE
+} ECU_REGISTRY_ENTRY;
+
 /* Service ID (Mode) request structure */
 typedef struct
 {
@@ -458,6 +597,29 @@ typedef struct
 	unsigned char  DTC[2048];
 } DTC_LIST;
 
+/* ISO15765 flow control profiles (gISO15765FlowProfile) */
+#define ISO15765_FC_INTERFACE_DEFAULT  0   /* leave ISO15765_BS / ISO15765_STMIN at the DLL defaults */
+#define ISO15765_FC_MAX_THROUGHPUT     1   /* BS = 0, STmin = 0 (ISO 15765-4 tester values) */
+#define ISO15765_FC_CUSTOM             2   /* gISO15765BlockSize / gISO15765STmin */
+
+/* Connect information cache entry (development runs) */
+typedef struct
+{
+	unsigned long  ProtocolTag;
+	unsigned long  HeaderSize;
+	unsigned long  NumEcus;
+	unsigned char  Header[OBD_MAX_ECUS][4];         /* ECU headers, also the flow control IDs on CAN */
+	unsigned char  Pid00Support[OBD_MAX_ECUS][4];   /* SID $1 PID $0 support bits */
+} CONNECT_CACHE_ENTRY;
+
+/* Receive thread ring slot */
+typedef struct
+{
+	PASSTHRU_MSG   Msg;
+	LARGE_INTEGER  HostTime;            /* QueryPerformanceCounter when the message was read */
+	unsigned long  ReadTimeMsecs;       /* GetTickCount when the message was read */
+} RX_RING_SLOT;
+
 
 typedef struct
 {
@@ -490,19 +652,28 @@ STATUS CheckMILLight(void);
 STATUS SidRequest(SID_REQ *, unsigned long);
 STATUS SidResetResponseData(PASSTHRU_MSG *);
 STATUS SidSaveResponseData(PASSTHRU_MSG *, SID_REQ *, unsigned long *);
+void   DupSetReset (unsigned long EcuIndex);
 STATUS ConnectProtocol(void);
 STATUS DisconnectProtocol(void);
 void   StopTest(STATUS ExitCode, TEST_PHASE eTestPhase);
 void   AbortTest (void);
+void   EndSubsectionStats (void);
 void   InitProtocolList(void);
 STATUS IsDTCPending(unsigned long Flags);
 STATUS IsDTCStored(unsigned long Flags);
 
 void   LogMsg(PASSTHRU_MSG *, unsigned long);
+unsigned long LogFormatFrame (char *pBuffer, const LOG_FRAME *pFrame, const unsigned char *pData);  /* formats a LogMsg log entry */
 
 char   Log( LOGTYPE LogType, SCREENOUTPUT ScreenOutput, LOGOUTPUT LogOutput, PROMPTTYPE PromptType, const char *LogString, ... );
+STATUS TransactionBufferReserve(void);   /* allocates the transaction ring buffer */
 void   SaveTransactionStart(void);        /* marks the start of a new transaction in the ring buffer */
 void   AddToTransactionBuffer (char *pszStringToAdd);  /* adds a string to the transaction ring buffer */
+void   AddFrameToTransactionBuffer (const LOG_FRAME *pFrame, const unsigned char *pData);  /* adds a LogMsg frame to the transaction ring buffer */
+unsigned long LogElapsedMsecs (void);                          /* msecs since the previous log entry */
+unsigned long LogRecordPrefix (char *pBuffer, unsigned long ElapsedMsecs);  /* writes the timestamp of a log entry */
+void   LogRecordWrite (char *pRecord, unsigned long Length);   /* writes a complete log entry */
+unsigned long LogFormatDec (char *pBuffer, unsigned long Value, unsigned long Width, char Pad);  /* writes a padded decimal number */
 void   LogLastTransaction(void);          /* copies last transaction from ring buffer to log file */
 void   DumpTransactionBuffer(void);       /* copies transaction ring buffer to log file */
 void   ClearTransactionBuffer(void);      /* clears transaction ring buffer */
@@ -546,6 +717,8 @@ STATUS VerifyVINFormat (unsigned long EcuIndex);
 
 STATUS RequestSID1SupportData (void);
 unsigned int IsSid1PidSupported (unsigned int EcuIndex, unsigned int PidIndex);
+const SID1_PID_DESC *GetSid1PidDesc (unsigned char Pid);
+int    GetSid1PidDataSize (unsigned char Pid);
 int    VerifySid1PidSupportData(void);
 
 STATUS RequestSID9SupportData (void);
@@ -556,6 +729,73 @@ unsigned int GetEcuId (unsigned int EcuIndex);
 
 STATUS StartPeriodicMsg (void);
 STATUS StopPeriodicMsg (BOOL bLogError);
+STATUS PeriodicMsgBeginRequest (void);
+STATUS PeriodicMsgCheckWindow (unsigned long WindowEndMsecs);
+void   LogPeriodicMsgStats (void);
+
+void   PacingStartRequest (void);
+void   PacingNoteBusActivity (unsigned long HostMsecs);
+void   PacingNoteRxMsg (PASSTHRU_MSG *pMsg, unsigned long ReadTimeMsecs);
+void   PacingWaitForRequest (void);
+void   PacingReset (void);
+void   LogPacingStats (void);
+
+unsigned long GetHostUsecs (void);
+BOOL   HostTimeToUsecs (LARGE_INTEGER *pHostTime, unsigned long *pHostUsecs);
+void   TimingStartRequest (void);
+void   TimingSetReference (void);
+void   TimingNoteRxHostUsecs (unsigned long HostUsecs);
+void   TimingNoteRxHostUnknown (void);
+unsigned long TimingResponseUsecs (unsigned long RxTimestamp, unsigned long TxTimestamp);
+void   LogTimingStats (void);
+BOOL   TimingRxHostUsecs (unsigned long *pHostUsecs);
+void   MultiFrameRecord (unsigned long EcuId, unsigned long NumBytes, unsigned long TransferUsecs);
+void   LogMultiFrameStats (void);
+void   RespTimeHistRecord (unsigned long EcuTimingIndex, unsigned char Sid, unsigned long ResponseUsecs);
+void   LogRespTimeHist (unsigned long EcuTimingIndex);
+void   SidDataReset (SID_DATA *pSidData);
+STATUS SidDataSet (SID_DATA *pSidData, const unsigned char *pSrc, unsigned long NumBytes);
+STATUS SidDataAppend (SID_DATA *pSidData, const unsigned char *pSrc, unsigned long NumBytes);
+unsigned char *SidDataPtr (SID_DATA *pSidData);
+unsigned char  SidDataByte (SID_DATA *pSidData, unsigned long Index);
+void   CopyOBDResponse (OBD_DATA *pDest, OBD_DATA *pSrc);
+void   SupportMapInvalidate (unsigned char Sid, unsigned long EcuIndex);
+void   SupportMapInvalidateAll (void);
+unsigned int SupportMapTest (unsigned char Sid, unsigned long EcuIndex, unsigned int Id);
+unsigned int SupportMapNext (unsigned char Sid, unsigned long EcuIndex, unsigned int Id);
+void   SampleCacheSaveSid1 (unsigned long EcuIndex, const SID1 *pSid1);
+void   SampleCacheSaveSid9Ipt (unsigned long EcuIndex);
+void   SampleCacheInvalidate (unsigned char Sid, unsigned char Id, unsigned long EcuIndex);
+void   SampleCacheRebuild (void);
+const DECODED_SAMPLE *GetSid1Sample (unsigned long EcuIndex, SAMPLE_ID SampleId);
+const SID9IPT        *GetSid9IptSample (unsigned long EcuIndex, unsigned long *pTimeMsecs);
+ULONGLONG GetSid1Fingerprint (unsigned long EcuIndex, unsigned char Pid);
+ULONGLONG GetSid9IptFingerprint (unsigned long EcuIndex);
+
+STATUS RxThreadStart (void);
+void   RxThreadStop (void);
+BOOL   RxThreadIsRunning (void);
+void   RxThreadPause (void);
+void   RxThreadRequestPause (void);
+void   RxThreadResume (void);
+long   RxThreadRead (RX_RING_SLOT *pSlotList[], unsigned long *pNumMsgs, unsigned long TimeoutMsecs);
+void   RxThreadRelease (void);
+
+STATUS LogWriterStart (void);
+void   LogWriterStop (void);
+void   LogWriterWrite (const char *pData, unsigned long Size);
+void   LogWriterFlush (void);
+
+STATUS TraceFileOpen (void);
+void   TraceFileClose (void);
+void   TraceFileFrame (const LOG_FRAME *pFrame, const unsigned char *pData);
+void   TraceFileMarker (const char *szText);
+
+void   ConnectCacheSetInterface (const char *szFirmwareVersion, const char *szDllVersion);
+STATUS ConnectCacheLoad (CONNECT_CACHE_ENTRY *pEntry);
+STATUS ConnectCacheSave (CONNECT_CACHE_ENTRY *pEntry);
+void   ConnectCacheBuildEntry (CONNECT_CACHE_ENTRY *pEntry);
+STATUS ConnectCacheMatch (CONNECT_CACHE_ENTRY *pEntry);
 
 STATUS DetermineVariablePidSize (void);
 void   SaveDTCList (int nSID);
@@ -569,6 +809,11 @@ unsigned int IsSid6MidSupported (unsigned int EcuIndex, unsigned int MidIndex);
 unsigned int IsSid8TidSupported (unsigned int EcuIndex, unsigned int TidIndex);
 
 STATUS LookupEcuIndex (PASSTHRU_MSG *RxMsg, unsigned long *pulEcuIndex);
+void   EcuRegistryReset (void);
+ECU_REGISTRY_ENTRY *EcuRegistryLookup (const unsigned char *pHeader, unsigned long HeaderSize);
+unsigned long EcuRegistryTimingIndex (const unsigned char *pHeader, unsigned long HeaderSize, unsigned long EcuId);
+STATUS EcuTableReserve (unsigned long NumEcus);
+STATUS EcuTableReserveEcu (const unsigned char *pHeader, unsigned long NumEcus);
 
 void   LogVersionInformation (SCREENOUTPUT bDisplay, LOGOUTPUT bLog);
 void   LogSoftwareVersion (SCREENOUTPUT bDisplay, LOGOUTPUT bLog);
@@ -641,8 +886,9 @@ extern unsigned long gLastLogTime;
 extern unsigned char gIgnoreUnsupported;
 extern unsigned char gSuspendScreenOutput;
 extern unsigned char gSuspendLogOutput;
-extern OBD_DATA gOBDResponse[OBD_MAX_ECUS];
-extern OBD_DATA gOBDCompareResponse[OBD_MAX_ECUS];
+extern OBD_DATA *gOBDResponse;                      // gOBDEcuCapacity entries
+extern OBD_DATA *gOBDCompareResponse;               // gOBDEcuCapacity entries
+extern unsigned long gOBDEcuCapacity;               // number of entries in the ECU tables
 extern char gVIN[18];
 extern FILE *ghLogFile;
 extern PASSTHRU_MSG  gTesterPresentMsg;
@@ -659,6 +905,7 @@ extern HINSTANCE hDLL;
 
 
 extern long gSid1VariablePidSize;
+extern BOOL gSid1PackedRequest;         // TRUE while a packed (multiple PID) SID $1 request is outstanding
 
 char *gBanner;
 extern const char gszAPP_REVISION[];
@@ -669,7 +916,7 @@ extern unsigned char gOBDResponseTA[OBD_MAX_ECUS]; /* by Honda */
 extern FILE *ghTempLogFile;
 extern char gszTempLogFilename[MAX_PATH];
 
-extern DTC_LIST gDTCList[OBD_MAX_ECUS];
+extern DTC_LIST *gDTCList;              // gOBDEcuCapacity entries
 
 extern unsigned long gulDeviceID;       // global storage for J2534-1 Device ID
 
@@ -678,9 +925,57 @@ extern SID1 Sid1Pid1[OBD_MAX_ECUS];     // capture the response from SID01 PID01
 extern TEST_PHASE  TestPhase;
 extern unsigned char TestSubsection;    // test subsection to be used in conjunction with TestPhase
 
-extern ECU_TIMING_DATA gEcuTimingData[OBD_MAX_ECUS];
+extern ECU_TIMING_DATA *gEcuTimingData;  // gOBDEcuCapacity entries
+
+extern unsigned long gSidReadCalls;     // number of PassThruReadMsgs calls made by SidRequest
+extern unsigned long gSidReadMsgs;      // number of messages returned by those calls
 
 /*********************************************/
 /* Option to turn off Tester Present Message */
 extern BOOL gPeriodicMsgEnabled;
 /*********************************************/
+
+/*********************************************/
+/* Option to use the receive thread          */
+extern BOOL gRxThreadEnabled;
+/*********************************************/
+
+/*********************************************/
+/* Option to write the log file from a       */
+/* writer thread                             */
+extern BOOL gLogWriterEnabled;
+/*********************************************/
+
+/*********************************************/
+/* Option to also write the network frames   */
+/* to a binary .j1t trace file               */
+extern BOOL gTraceFileEnabled;
+extern char gTraceFileName[MAX_PATH];
+/*********************************************/
+
+/*********************************************/
+/* Option to probe the CAN protocols first   */
+extern BOOL gFastCanDetectEnabled;
+/*********************************************/
+
+/*********************************************/
+/* Option to use the connect info cache      */
+/* (development runs only)                   */
+extern BOOL gConnectCacheEnabled;
+/*********************************************/
+
+/*********************************************/
+/* ISO15765 flow control profile             */
+extern unsigned long gISO15765FlowProfile;
+extern unsigned long gISO15765BlockSize;
+extern unsigned long gISO15765STmin;
+/*********************************************/
+
+/*********************************************/
+/* Transaction ring buffer size and what a   */
+/* failure in the Manufacturer Specific      */
+/* Drive Cycle dumps from it                 */
+extern unsigned long gTransactionBufferMB;
+extern unsigned long gTransactionDumpCount;
+extern unsigned long gTransactionDumpSecs;
+/*********************************************/
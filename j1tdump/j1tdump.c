@@ -0,0 +1,291 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** j1tdump - renders a .j1t trace file (see gTraceFileEnabled) as the text
+** j1699 writes to the log file, one record at a time.
+**
+**   j1tdump [-ecu <hex>] [-sid <hex>] [-from <secs>] [-to <secs>] <file.j1t>
+**
+**   -ecu    only the frames of this ECU (CAN ID, or the source address of a
+**           J1850 / ISO9141 / ISO14230 header), and the requests to all ECUs
+**   -sid    only the requests, responses and negative responses of this SID
+**   -from   only the records from this many seconds after the trace start
+**   -to     only the records up to this many seconds after the trace start
+**
+** The test section markers in the trace are rendered if they are in the
+** -from / -to range.
+*/
+
+typedef struct
+{
+	BOOL          bEcu;
+	unsigned long Ecu;
+	BOOL          bSid;
+	unsigned long Sid;
+	unsigned long FromMsecs;
+	unsigned long ToMsecs;
+} TRACE_FILTER;
+
+static unsigned char RecordData[65536];   /* the data of one trace record */
+
+/*
+*******************************************************************************
+** FrameMatchesFilter - Function to check a trace frame against the ECU and
+**                      SID filters
+*******************************************************************************
+*/
+static BOOL FrameMatchesFilter (const TRACE_FILTER *pFilter, const LOG_FRAME *pFrame, const unsigned char *pData)
+{
+	unsigned long HeaderSize;
+	unsigned long Ecu;
+	unsigned char Sid;
+
+	/* ISO15765 / CAN frames start with the 4 byte CAN ID, the others with a 3 byte header */
+	if (pFrame->ProtocolID == ISO15765 || pFrame->ProtocolID == CAN)
+	{
+		HeaderSize = 4;
+	}
+	else
+	{
+		HeaderSize = 3;
+	}
+
+	if (pFilter->bEcu == TRUE &&
+	    (pFrame->Flags & LOG_REQ_MSG) == 0 && (pFrame->RxStatus & TX_MSG_TYPE) == 0)
+	{
+		if (pFrame->NumBytes < HeaderSize)
+		{
+			return FALSE;
+		}
+
+		if (HeaderSize == 4)
+		{
+			Ecu = ((unsigned long)pData[0] << 24) | ((unsigned long)pData[1] << 16) |
+			      ((unsigned long)pData[2] << 8) | pData[3];
+		}
+		else
+		{
+			Ecu = pData[2];
+		}
+
+		if (Ecu != pFilter->Ecu)
+		{
+			return FALSE;
+		}
+	}
+
+	if (pFilter->bSid == TRUE)
+	{
+		if (pFrame->NumBytes <= HeaderSize)
+		{
+			return FALSE;
+		}
+
+		Sid = pData[HeaderSize];
+		if (Sid == 0x7F && pFrame->NumBytes > HeaderSize + 1)
+		{
+			/* negative response */
+			Sid = pData[HeaderSize + 1];
+		}
+		else if (Sid >= 0x40)
+		{
+			Sid -= 0x40;
+		}
+
+		if (Sid != pFilter->Sid)
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+** Usage - Function to show the command line
+*******************************************************************************
+*/
+static int Usage (void)
+{
+	fprintf (stderr, "usage: j1tdump [-ecu <hex>] [-sid <hex>] [-from <secs>] [-to <secs>] <file.j1t>\n");
+	return 2;
+}
+
+/*
+*******************************************************************************
+** main - j1tdump
+*******************************************************************************
+*/
+int main (int argc, char **argv)
+{
+	TRACE_FILTER Filter;
+	TRACE_FILE_HEADER FileHeader;
+	TRACE_RECORD_HEADER Header;
+	LOG_FRAME Frame;
+	char LogBuffer[MAX_LOG_STRING_SIZE];
+	char *szFilename = NULL;
+	FILE *hTraceFile;
+	time_t StartTime;
+	int ArgIndex;
+
+	memset (&Filter, 0, sizeof(Filter));
+	Filter.ToMsecs = 0xFFFFFFFF;
+
+	for (ArgIndex = 1; ArgIndex < argc; ArgIndex++)
+	{
+		if (strcmp (argv[ArgIndex], "-ecu") == 0 && ArgIndex + 1 < argc)
+		{
+			Filter.bEcu = TRUE;
+			Filter.Ecu  = strtoul (argv[++ArgIndex], NULL, 16);
+		}
+		else if (strcmp (argv[ArgIndex], "-sid") == 0 && ArgIndex + 1 < argc)
+		{
+			Filter.bSid = TRUE;
+			Filter.Sid  = strtoul (argv[++ArgIndex], NULL, 16);
+		}
+		else if (strcmp (argv[ArgIndex], "-from") == 0 && ArgIndex + 1 < argc)
+		{
+			Filter.FromMsecs = (unsigned long)(atof (argv[++ArgIndex]) * 1000);
+		}
+		else if (strcmp (argv[ArgIndex], "-to") == 0 && ArgIndex + 1 < argc)
+		{
+			Filter.ToMsecs = (unsigned long)(atof (argv[++ArgIndex]) * 1000);
+		}
+		else if (argv[ArgIndex][0] != '-' && szFilename == NULL)
+		{
+			szFilename = argv[ArgIndex];
+		}
+		else
+		{
+			return Usage ();
+		}
+	}
+
+	if (szFilename == NULL)
+	{
+		return Usage ();
+	}
+
+	hTraceFile = fopen (szFilename, "rb");
+	if (hTraceFile == NULL)
+	{
+		fprintf (stderr, "Cannot open %s\n", szFilename);
+		return 1;
+	}
+	setvbuf (hTraceFile, NULL, _IOFBF, 65536);
+
+	if (fread (&FileHeader, sizeof(FileHeader), 1, hTraceFile) != 1 ||
+	    memcmp (FileHeader.Magic, TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC)) != 0 ||
+	    FileHeader.Version != TRACE_FILE_VERSION)
+	{
+		fprintf (stderr, "%s is not a version %d .j1t trace file\n", szFilename, TRACE_FILE_VERSION);
+		fclose (hTraceFile);
+		return 1;
+	}
+
+	StartTime = (time_t)FileHeader.StartTime;
+	fprintf (stderr, "%s: trace started %s", szFilename, ctime (&StartTime));
+
+	while (fread (&Header, sizeof(Header), 1, hTraceFile) == 1)
+	{
+		if (Header.Length > 0 &&
+		    fread (RecordData, Header.Length, 1, hTraceFile) != 1)
+		{
+			fprintf (stderr, "%s: last record is incomplete\n", szFilename);
+			break;
+		}
+
+		/* records are in time order */
+		if (Header.TraceMsecs < Filter.FromMsecs)
+		{
+			continue;
+		}
+		if (Header.TraceMsecs > Filter.ToMsecs)
+		{
+			break;
+		}
+
+		switch (Header.Type)
+		{
+			case TRACE_FRAME:
+			{
+				if (Header.Length < sizeof(Frame))
+				{
+					break;
+				}
+				memcpy (&Frame, RecordData, sizeof(Frame));
+				if (Header.Length - sizeof(Frame) < Frame.NumBytes ||
+				    Frame.NumBytes > MAX_MESSAGE_LOG_SIZE)
+				{
+					break;
+				}
+
+				if (FrameMatchesFilter (&Filter, &Frame, &RecordData[sizeof(Frame)]) == TRUE)
+				{
+					fwrite (LogBuffer, LogFormatFrame (LogBuffer, &Frame, &RecordData[sizeof(Frame)]), 1, stdout);
+				}
+			}
+			break;
+
+			case TRACE_MARKER:
+			{
+				if (Header.Length > 2)
+				{
+					fwrite (&RecordData[2], Header.Length - 2, 1, stdout);
+				}
+			}
+			break;
+
+			default:
+			{
+				/* record type of a later version, skip it */
+			}
+			break;
+		}
+	}
+
+	fclose (hTraceFile);
+	return 0;
+}
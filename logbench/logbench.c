@@ -0,0 +1,397 @@
+/*
+********************************************************************************
+** SAE J1699-3 Test Source Code
+**
+**  Copyright (C) 2002 Drew Technologies. http://j1699-3.sourceforge.net/
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+**  This program is free software; you can redistribute it and/or modify
+**  it under the terms of the GNU General Public License as published by
+**  the Free Software Foundation; either version 2 of the License, or
+**  (at your option) any later version.
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU General Public License for more details.
+**
+**  You should have received a copy of the GNU General Public License
+**  along with this program; if not, write to the Free Software
+**  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+**
+** ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**
+** This source code, when compiled and used with an SAE J2534-compatible pass
+** thru device, is intended to run the tests described in the SAE J1699-3
+** document in an automated manner.
+**
+** This computer program is based upon SAE Technical Report J1699,
+** which is provided "AS IS"
+**
+** See j1699.c for details of how to build and run this test.
+**
+********************************************************************************
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "j2534.h"
+#include "j1699.h"
+
+/*
+** logbench - replays synthetic network frames through LogMsg and reports
+** how many frames per second it formats.
+**
+**   logbench [<frames>] [<passes>]
+**
+** A pool of BENCH_POOL_FRAMES frames mixes every protocol, the TX / RX / REQ
+** forms, the ISO15765 indications and the ISO9141 / ISO14230 checksums.
+** Each pool frame is first checked against a reference formatter that
+** builds the entry with sprintf the way LogMsg and Log() used to, so a
+** formatting change shows up as a mismatch before any time is reported.
+** Then <frames> frames, cycling through the pool, are timed <passes> times
+** through LogMsg and through the reference formatter.
+**
+** LogMsg is linked with the functions below instead of LogPrint.c,
+** LogWriter.c and TraceFile.c, so only the formatting is measured.
+*/
+#define BENCH_DEFAULT_FRAMES  200000
+#define BENCH_DEFAULT_PASSES  10
+#define BENCH_POOL_FRAMES     1024
+#define BENCH_MAX_FRAME_SIZE  64
+
+typedef struct
+{
+	PASSTHRU_MSG  Msg;
+	unsigned long Flags;
+	unsigned long ElapsedMsecs;
+} BENCH_FRAME;
+
+unsigned char gSuspendLogOutput = FALSE;
+
+static unsigned long ulBenchElapsedMsecs;   /* LogElapsedMsecs of the frame being logged */
+static char          *pBenchExpected;       /* entry LogWriterWrite must get, NULL when timing */
+static unsigned long ulBenchMismatches;
+static unsigned long ulBenchBytes;          /* bytes LogWriterWrite got */
+
+static unsigned long ulRandom = 1;
+
+/*
+*******************************************************************************
+** Random - Function to get the next number of a fixed pseudo random series
+*******************************************************************************
+*/
+static unsigned long Random (void)
+{
+	ulRandom = ulRandom * 1103515245UL + 12345UL;
+	return (ulRandom >> 16) & 0x7FFF;
+}
+
+/*
+*******************************************************************************
+** LogElapsedMsecs, TraceFileFrame, AddFrameToTransactionBuffer and
+** LogWriterWrite - what LogMsg calls outside LogFormat.c
+*******************************************************************************
+*/
+unsigned long LogElapsedMsecs (void)
+{
+	return ulBenchElapsedMsecs;
+}
+
+void TraceFileFrame (const LOG_FRAME *pFrame, const unsigned char *pData)
+{
+}
+
+void AddFrameToTransactionBuffer (const LOG_FRAME *pFrame, const unsigned char *pData)
+{
+}
+
+void LogWriterWrite (const char *pData, unsigned long Size)
+{
+	ulBenchBytes += Size;
+
+	if (pBenchExpected != NULL &&
+	    (strlen (pBenchExpected) != Size || memcmp (pBenchExpected, pData, Size) != 0))
+	{
+		if (ulBenchMismatches++ == 0)
+		{
+			printf ("LogMsg:    %.*s", (int)Size, pData);
+			printf ("reference: %s", pBenchExpected);
+		}
+	}
+}
+
+/*
+*******************************************************************************
+** ReferenceFormat - Function to format a frame with sprintf, as LogMsg did
+**                   before LogFormatFrame, and with the "+NNNNNNms NETWORK: "
+**                   prefix Log() added.  Returns the length of the entry.
+*******************************************************************************
+*/
+static unsigned long ReferenceFormat (char *LogBuffer, PASSTHRU_MSG *Msg, unsigned long Flags, unsigned long ElapsedMsecs)
+{
+	unsigned long ByteIndex;
+	unsigned long BufferIndex;
+
+	BufferIndex = sprintf (LogBuffer, "+%06lums NETWORK: ", ElapsedMsecs);
+
+	if (Flags & LOG_REQ_MSG)
+	{
+		Msg->ExtraDataIndex = Msg->DataSize;
+		BufferIndex += sprintf(&LogBuffer[BufferIndex], "REQ MSG:  ");
+	}
+	else if (Msg->RxStatus & TX_MSG_TYPE)
+	{
+		BufferIndex += sprintf(&LogBuffer[BufferIndex], "TX MSG: %10luusec ", Msg->Timestamp);
+	}
+	else
+	{
+		BufferIndex += sprintf(&LogBuffer[BufferIndex], "RX MSG: %10luusec ", Msg->Timestamp);
+	}
+
+	switch (Msg->ProtocolID)
+	{
+		case J1850VPW:
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "J1850VPW ");
+			break;
+		case J1850PWM:
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "J1850PWM ");
+			break;
+		case ISO9141:
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "ISO9141 ");
+			break;
+		case ISO14230:
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "ISO14230 ");
+			break;
+		case ISO15765:
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "ISO15765 ");
+			break;
+		case CAN:
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "CAN ");
+			break;
+	}
+
+	if (Msg->ProtocolID == ISO15765)
+	{
+		if (Msg->RxStatus & ISO15765_FIRST_FRAME)
+		{
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "FirstFrame Indication ");
+		}
+		else if (Msg->RxStatus & TX_DONE)
+		{
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "Tx Done Indication ");
+		}
+	}
+	if ((Msg->ProtocolID == ISO9141 || Msg->ProtocolID == ISO14230) && (Msg->RxStatus & START_OF_MESSAGE))
+	{
+		BufferIndex += sprintf(&LogBuffer[BufferIndex], "Start of Message ");
+	}
+
+	if (Msg->RxStatus & RX_BREAK)
+	{
+		BufferIndex += sprintf(&LogBuffer[BufferIndex], "BREAK Indication ");
+	}
+	for (ByteIndex = 0; (ByteIndex < Msg->ExtraDataIndex) && (ByteIndex < Msg->DataSize) && (ByteIndex < MAX_MESSAGE_LOG_SIZE); ByteIndex++)
+	{
+		BufferIndex += sprintf(&LogBuffer[BufferIndex], "%02X ", Msg->Data[ByteIndex]);
+	}
+
+	if ((Msg->ProtocolID == ISO9141) || (Msg->ProtocolID == ISO14230))
+	{
+		if (Msg->ExtraDataIndex < Msg->DataSize)
+		{
+			BufferIndex += sprintf(&LogBuffer[BufferIndex], "(%02X) ", Msg->Data[Msg->ExtraDataIndex]);
+		}
+	}
+
+	BufferIndex += sprintf(&LogBuffer[BufferIndex], "\n");
+
+	return BufferIndex;
+}
+
+/*
+*******************************************************************************
+** BuildFrame - Function to make up the next synthetic frame
+*******************************************************************************
+*/
+static void BuildFrame (BENCH_FRAME *pFrame)
+{
+	static const unsigned long ProtocolList[] = { J1850VPW, J1850PWM, ISO9141, ISO14230, ISO15765, CAN };
+	unsigned long ByteIndex;
+	unsigned long Kind;
+
+	memset (&pFrame->Msg, 0, sizeof(pFrame->Msg) - sizeof(pFrame->Msg.Data));
+
+	pFrame->Msg.ProtocolID = ProtocolList[Random () % 6];
+	pFrame->Msg.Timestamp  = (Random () << 15) | Random ();
+	pFrame->ElapsedMsecs   = Random () % 2000;
+	pFrame->Flags          = 0;
+
+	Kind = Random () % 8;
+	if (Kind == 0)
+	{
+		pFrame->Flags = LOG_REQ_MSG;
+	}
+	else if (Kind == 1)
+	{
+		pFrame->Msg.RxStatus = TX_MSG_TYPE;
+	}
+
+	if (pFrame->Msg.ProtocolID == ISO15765)
+	{
+		Kind = Random () % 4;
+		if (Kind == 0)
+		{
+			pFrame->Msg.RxStatus |= ISO15765_FIRST_FRAME;
+		}
+		else if (Kind == 1)
+		{
+			pFrame->Msg.RxStatus |= TX_DONE;
+		}
+	}
+	else if ((pFrame->Msg.ProtocolID == ISO9141 || pFrame->Msg.ProtocolID == ISO14230) &&
+	         Random () % 4 == 0)
+	{
+		pFrame->Msg.RxStatus |= START_OF_MESSAGE;
+	}
+
+	pFrame->Msg.DataSize = 4 + Random () % (BENCH_MAX_FRAME_SIZE - 4);
+	for (ByteIndex = 0; ByteIndex < pFrame->Msg.DataSize; ByteIndex++)
+	{
+		pFrame->Msg.Data[ByteIndex] = (unsigned char)Random ();
+	}
+
+	/* the serial protocols end with a checksum byte */
+	pFrame->Msg.ExtraDataIndex = pFrame->Msg.DataSize;
+	if ((pFrame->Msg.ProtocolID == ISO9141 || pFrame->Msg.ProtocolID == ISO14230) &&
+	    Random () % 2 == 0)
+	{
+		pFrame->Msg.ExtraDataIndex--;
+	}
+}
+
+/*
+*******************************************************************************
+** BenchSecs - Function to get a performance counter time in seconds
+*******************************************************************************
+*/
+static double BenchSecs (void)
+{
+	LARGE_INTEGER Counter;
+	LARGE_INTEGER Frequency;
+
+	QueryPerformanceCounter (&Counter);
+	QueryPerformanceFrequency (&Frequency);
+
+	return (double)Counter.QuadPart / (double)Frequency.QuadPart;
+}
+
+/*
+*******************************************************************************
+** main - logbench
+*******************************************************************************
+*/
+int main (int argc, char **argv)
+{
+	BENCH_FRAME *pFrameList;
+	BENCH_FRAME *pFrame;
+	char LogBuffer[MAX_LOG_STRING_SIZE];
+	unsigned long NumFrames = BENCH_DEFAULT_FRAMES;
+	unsigned long NumPasses = BENCH_DEFAULT_PASSES;
+	unsigned long FrameIndex;
+	unsigned long PassIndex;
+	unsigned long RefBytes;
+	double StartSecs;
+	double LogMsgSecs;
+	double RefSecs;
+
+	if (argc > 1)
+	{
+		NumFrames = strtoul (argv[1], NULL, 10);
+	}
+	if (argc > 2)
+	{
+		NumPasses = strtoul (argv[2], NULL, 10);
+	}
+	if (NumFrames == 0 || NumPasses == 0 || argc > 3)
+	{
+		fprintf (stderr, "usage: logbench [<frames>] [<passes>]\n");
+		return 2;
+	}
+
+	pFrameList = (BENCH_FRAME *)malloc (BENCH_POOL_FRAMES * sizeof(BENCH_FRAME));
+	if (pFrameList == NULL)
+	{
+		fprintf (stderr, "Cannot allocate %u frames\n", BENCH_POOL_FRAMES);
+		return 2;
+	}
+	for (FrameIndex = 0; FrameIndex < BENCH_POOL_FRAMES; FrameIndex++)
+	{
+		BuildFrame (&pFrameList[FrameIndex]);
+	}
+
+	/* Check LogMsg against the reference formatter */
+	for (FrameIndex = 0; FrameIndex < BENCH_POOL_FRAMES; FrameIndex++)
+	{
+		pFrame = &pFrameList[FrameIndex];
+		ReferenceFormat (LogBuffer, &pFrame->Msg, pFrame->Flags, pFrame->ElapsedMsecs);
+		pBenchExpected      = LogBuffer;
+		ulBenchElapsedMsecs = pFrame->ElapsedMsecs;
+		LogMsg (&pFrame->Msg, pFrame->Flags);
+	}
+	pBenchExpected = NULL;
+
+	if (ulBenchMismatches != 0)
+	{
+		printf ("%lu of %u frames differ from the reference formatter\n",
+		        ulBenchMismatches, BENCH_POOL_FRAMES);
+		free (pFrameList);
+		return 1;
+	}
+
+	/* Time LogMsg */
+	ulBenchBytes = 0;
+	StartSecs = BenchSecs ();
+	for (PassIndex = 0; PassIndex < NumPasses; PassIndex++)
+	{
+		for (FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		{
+			pFrame = &pFrameList[FrameIndex % BENCH_POOL_FRAMES];
+			ulBenchElapsedMsecs = pFrame->ElapsedMsecs;
+			LogMsg (&pFrame->Msg, pFrame->Flags);
+		}
+	}
+	LogMsgSecs = BenchSecs () - StartSecs;
+
+	/* Time the reference formatter */
+	RefBytes = 0;
+	StartSecs = BenchSecs ();
+	for (PassIndex = 0; PassIndex < NumPasses; PassIndex++)
+	{
+		for (FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		{
+			pFrame = &pFrameList[FrameIndex % BENCH_POOL_FRAMES];
+			RefBytes += ReferenceFormat (LogBuffer, &pFrame->Msg, pFrame->Flags, pFrame->ElapsedMsecs);
+		}
+	}
+	RefSecs = BenchSecs () - StartSecs;
+
+	printf ("%lu frames x %lu passes, %lu bytes of log text per pass\n",
+	        NumFrames, NumPasses, ulBenchBytes / NumPasses);
+	printf ("LogMsg     %10.0f frames/s\n", (double)NumFrames * NumPasses / LogMsgSecs);
+	printf ("reference  %10.0f frames/s\n", (double)NumFrames * NumPasses / RefSecs);
+	printf ("speedup    %10.1fx\n", RefSecs / LogMsgSecs);
+
+	if (RefBytes != ulBenchBytes)
+	{
+		printf ("LogMsg wrote %lu bytes, the reference formatter %lu\n", ulBenchBytes, RefBytes);
+		free (pFrameList);
+		return 1;
+	}
+
+	free (pFrameList);
+	return 0;
+}